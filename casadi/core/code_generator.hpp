@@ -640,6 +640,8 @@ namespace casadi {
       AUX_QR,
       AUX_QP,
       AUX_QRQP,
+      AUX_IPQP,
+      AUX_RICCATI,
       AUX_NLP,
       AUX_SQPMETHOD,
       AUX_FEASIBLESQPMETHOD,
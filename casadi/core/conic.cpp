@@ -786,6 +786,90 @@ namespace casadi {
     casadi_qp_setup(&p_qp_);
   }
 
+  void Conic::detect_ocp_structure(casadi_int& N, std::vector<casadi_int>& nx,
+      std::vector<casadi_int>& nu, std::vector<casadi_int>& ng) const {
+    nx.clear();
+    nu.clear();
+    ng.clear();
+    // Find the right-most, second-to-right-most and left-most column of each row
+    Sparsity AT = A_.T();
+    const casadi_int *at_colind = AT.colind(), *at_row = AT.row();
+    std::vector<casadi_int> A_skyline, A_skyline2, A_bottomline;
+    for (casadi_int i=0; i<na_; ++i) {
+      casadi_int pivot = at_colind[i+1];
+      if (pivot>at_colind[i]) {
+        A_bottomline.push_back(at_row[at_colind[i]]);
+        A_skyline.push_back(at_row[pivot-1]);
+        A_skyline2.push_back(pivot>at_colind[i]+1 ? at_row[pivot-2] : -1);
+      } else {
+        A_bottomline.push_back(-1);
+        A_skyline.push_back(-1);
+        A_skyline2.push_back(-1);
+      }
+    }
+    // The right-most entries of the dynamics rows form the x[k+1] diagonals,
+    // a new stage starts whenever the diagonal pattern is broken
+    casadi_int pivot = 0, start_pivot = 0, cg = 0;
+    for (casadi_int i=0; i<na_; ++i) {
+      bool commit = false;
+      if (A_skyline[i]>pivot+1) {
+        // Jump to a diagonal in the future
+        nu.push_back(A_skyline[i]-pivot-1);
+        commit = true;
+      } else if (A_skyline[i]==pivot+1) {
+        // Walking the diagonal
+        if (A_skyline2[i]<start_pivot) {
+          pivot++;
+        } else {
+          nu.push_back(0);
+          commit = true;
+        }
+      } else {
+        // Constraint not closing a gap
+        cg++;
+      }
+      if (commit) {
+        nx.push_back(pivot-start_pivot+1);
+        ng.push_back(cg);
+        cg = 0;
+        start_pivot = A_skyline[i];
+        pivot = A_skyline[i];
+      }
+    }
+    if (nu.empty()) {
+      // No dynamics: a single stage
+      N = 0;
+      nx = {nx_};
+      nu = {0};
+      ng = {na_};
+      return;
+    }
+    nx.push_back(pivot-start_pivot+1);
+    // Correction for k==0
+    nx[0] = A_skyline[0];
+    nu[0] = 0;
+    ng.erase(ng.begin());
+    casadi_int cN = 0;
+    for (casadi_int i=na_-1; i>=0; --i) {
+      if (A_bottomline[i]<start_pivot) break;
+      cN++;
+    }
+    ng.push_back(cg-cN);
+    ng.push_back(cN);
+    N = nu.size();
+    nu.push_back(0);
+    // Any trailing variables belong to the last stage
+    casadi_int nz_detected = 0;
+    for (casadi_int k=0; k<=N; ++k) nz_detected += nx[k] + nu[k];
+    if (nz_detected<nx_) nu[N] += nx_ - nz_detected;
+    if (N>1) {
+      if (nu[0]==0 && nx[1]+nu[1]==nx[0]) {
+        nx[0] = nx[1];
+        nu[0] = nu[1];
+      }
+    }
+  }
+
   void Conic::qp_codegen_body(CodeGenerator& g) const {
     g.add_auxiliary(CodeGenerator::AUX_QP);
     g.local("d_qp", "struct casadi_qp_data");
@@ -196,6 +196,16 @@ namespace casadi {
     /// SDP to SOCP conversion initialization
     void sdp_to_socp_init(SDPToSOCPMem& mem) const;
 
+    /** \brief Detect the stage structure of an optimal control problem
+
+        The constraint Jacobian is expected to have, for each stage k < N, nx[k+1]
+        dynamics rows coupling stage k to x[k+1] through a diagonal, followed by
+        ng[k] path constraints, and ng[N] terminal constraints.
+
+        \identifier{2fb} */
+    void detect_ocp_structure(casadi_int& N, std::vector<casadi_int>& nx,
+      std::vector<casadi_int>& nu, std::vector<casadi_int>& ng) const;
+
     void serialize(SerializingStream &s, const SDPToSOCPMem& m) const;
     void deserialize(DeserializingStream &s, SDPToSOCPMem& m);
 
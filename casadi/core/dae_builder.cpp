@@ -339,6 +339,22 @@ void DaeBuilder::tear() {
   }
 }
 
+void DaeBuilder::causalize(const Dict& opts) {
+  try {
+    (*this)->causalize(opts);
+  } catch (std::exception& e) {
+    THROW_ERROR("causalize", e.what());
+  }
+}
+
+void DaeBuilder::reduce_index(const Dict& opts) {
+  try {
+    (*this)->reduce_index(opts);
+  } catch (std::exception& e) {
+    THROW_ERROR("reduce_index", e.what());
+  }
+}
+
 bool DaeBuilder::has(const std::string& name) const {
   try {
     return (*this)->has(name);
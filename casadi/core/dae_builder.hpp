@@ -463,6 +463,39 @@ class CASADI_EXPORT DaeBuilder
 
   /// Identify iteration variables and residual equations using naming convention
   void tear();
+
+  /** \brief Causalize the algebraic equations
+
+      The algebraic equations are brought to block lower triangular (BLT) form.
+      Variables that appear linearly in an equation are solved for explicitly,
+      larger blocks are reduced by tearing. Each remaining block is solved by
+      a separate rootfinder, embedded in the definition of its tearing variables.
+      Solved algebraic variables become dependent variables.
+
+      Options:
+        rootfinder           Rootfinder plugin for torn blocks [newton], an empty
+                             string keeps the tearing variables as algebraic variables
+        rootfinder_options   Options passed to the rootfinders
+
+      \identifier{2f6} */
+  void causalize(const Dict& opts=Dict());
+
+  /** \brief Reduce the index of the DAE to one, using the dummy derivative method
+
+      The algebraic equations that need to be differentiated are found by the Pantelides
+      algorithm. All differentiated equations are kept, instead of stabilizing the
+      reduced system, and an equal number of derivatives are turned into algebraic
+      variables ("dummy derivatives"). The dummy derivatives are chosen by pivoting on
+      the Jacobian of the equations, evaluated at the start values. The selection is
+      static, i.e. only valid while the selected Jacobian blocks remain nonsingular.
+      Inputs are assumed to be piecewise constant.
+
+      Options:
+        algorithm   Structural analysis [pantelides]
+        max_iter    Maximum number of iterations of the structural analysis [500]
+
+      \identifier{2f8} */
+  void reduce_index(const Dict& opts=Dict());
   ///@}
 
   /** @name Functions
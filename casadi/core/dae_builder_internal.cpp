@@ -40,7 +40,10 @@
 #include "external.hpp"
 #include "fmu_function.hpp"
 #include "integrator.hpp"
+#include "integration_tools.hpp"
+#include "rootfinder.hpp"
 #include "filesystem_impl.hpp"
+#include "serializing_stream.hpp"
 
 // Throw informative error message
 #define THROW_ERROR_NODE(FNAME, NODE, WHAT) \
@@ -590,6 +593,8 @@ DaeBuilderInternal::DaeBuilderInternal(const std::string& name, const std::strin
       ignore_time_ = op.second;
     } else if (op.first=="detect_quad") {
       detect_quad_ = op.second;
+    } else if (op.first=="cache_dir") {
+      cache_dir_ = op.second.to_string();
     } else if (op.first=="resource_serialize_mode") {
       resource_.change_option("serialize_mode", op.second);
     } else {
@@ -597,6 +602,7 @@ DaeBuilderInternal::DaeBuilderInternal(const std::string& name, const std::strin
     }
   }
   indices_.resize(enum_traits<Category>::n_enum);
+  unsorted_.resize(enum_traits<Category>::n_enum, false);
 }
 
 void DaeBuilderInternal::load_fmi_description(const std::string& filename) {
@@ -618,8 +624,8 @@ void DaeBuilderInternal::load_fmi_description(const std::string& filename) {
   casadi_assert(n_variables() == 0, "Instance already has variables");
 
   // Parse XML file
-  XmlFile xml_file("tinyxml");
-  XmlNode fmi_desc = xml_file.parse(filename)[0];  // One child; fmiModelDescription
+  XmlNode xml = read_xml(filename);
+  const XmlNode& fmi_desc = xml[0];  // One child; fmiModelDescription
 
   // Read FMU version
   fmi_version_ = fmi_desc.attribute<std::string>("fmiVersion", "");
@@ -700,6 +706,57 @@ void DaeBuilderInternal::load_fmi_description(const std::string& filename) {
     "FMU must be of ModelExchange type or be symbolic (FMUX)");
 }
 
+XmlNode DaeBuilderInternal::read_xml(const std::string& filename) const {
+  // Cache file name, keyed on the GUID (FMI 2) or instantiation token (FMI 3)
+  std::string cache_file;
+  if (!cache_dir_.empty()) {
+    // The token is an attribute of the root element, parsed without the rest of the file
+    XmlFile xml_file("tinyxml");
+    XmlNode root = xml_file.parse_root(filename);
+    if (root.size() == 1) {
+      const XmlNode& fmi_desc = root[0];
+      std::string key = fmi_desc.has_attribute("instantiationToken") ?
+        "instantiationToken" : "guid";
+      std::string token;
+      if (fmi_desc.has_attribute(key)) {
+        // Keep alphanumeric characters only
+        for (char c : fmi_desc.attribute<std::string>(key)) {
+          if (std::isalnum(static_cast<unsigned char>(c))) token.push_back(c);
+        }
+      }
+      if (!token.empty()) cache_file = cache_dir_ + "/casadi_fmu_" + token + ".xmlbin";
+    }
+  }
+  // Load from cache, if available
+  if (!cache_file.empty()) {
+    std::ifstream in(cache_file, std::ios::binary);
+    if (in.good()) {
+      try {
+        DeserializingStream s(in);
+        XmlNode ret = XmlNode::deserialize(s);
+        if (debug_) uout() << "Loaded " << filename << " from " << cache_file << std::endl;
+        return ret;
+      } catch (std::exception& e) {
+        casadi_warning("Ignoring cache file " + cache_file + ": " + std::string(e.what()));
+      }
+    }
+  }
+  // Parse XML file
+  XmlFile xml_file("tinyxml");
+  XmlNode ret = xml_file.parse(filename);
+  // Write to cache
+  if (!cache_file.empty()) {
+    std::ofstream out(cache_file, std::ios::binary);
+    if (out.good()) {
+      SerializingStream s(out, Dict{{"bulk", true}});
+      ret.serialize(s);
+    } else {
+      casadi_warning("Could not write cache file " + cache_file);
+    }
+  }
+  return ret;
+}
+
 std::string DaeBuilderInternal::generate_build_description(
     const std::vector<std::string>& cfiles) const {
   // Default arguments
@@ -767,6 +824,10 @@ std::string DaeBuilderInternal::generate_model_description(const std::string& gu
   XmlNode me;
   me.name = "ModelExchange";
   me.set_attribute("modelIdentifier", model_name);  // sanitize name?
+  // Generated forward and adjoint derivatives, sparsity given by the dependencies
+  me.set_attribute(fmi_major >= 3 ? "providesDirectionalDerivatives"
+    : "providesDirectionalDerivative", "true");
+  if (fmi_major >= 3) me.set_attribute("providesAdjointDerivatives", "true");
   r.children.push_back(me);
   // Model variables
   r.children.push_back(generate_model_variables());
@@ -793,6 +854,19 @@ XmlNode DaeBuilderInternal::generate_model_variables() const {
   return r;
 }
 
+// Set dependencies and dependenciesKind attributes of a ModelStructure element
+static void set_dependencies(XmlNode& c, const Variable& v) {
+  c.set_attribute("dependencies", v.dependencies);
+  if (!v.dependenciesKind.empty()) {
+    std::stringstream ss;
+    for (size_t k = 0; k < v.dependenciesKind.size(); ++k) {
+      if (k > 0) ss << " ";
+      ss << to_string(v.dependenciesKind[k]);
+    }
+    c.set_attribute("dependenciesKind", ss.str());
+  }
+}
+
 XmlNode DaeBuilderInternal::generate_model_structure() const {
   XmlNode r;
   r.name = "ModelStructure";
@@ -802,7 +876,7 @@ XmlNode DaeBuilderInternal::generate_model_structure() const {
     XmlNode c;
     c.name = "Output";
     c.set_attribute("valueReference", static_cast<casadi_int>(y.value_reference));
-    c.set_attribute("dependencies", y.dependencies);
+    set_dependencies(c, y);
     r.children.push_back(c);
   }
   // Add state derivatives
@@ -811,7 +885,7 @@ XmlNode DaeBuilderInternal::generate_model_structure() const {
     XmlNode c;
     c.name = "ContinuousStateDerivative";
     c.set_attribute("valueReference", static_cast<casadi_int>(xdot.value_reference));
-    c.set_attribute("dependencies", xdot.dependencies);
+    set_dependencies(c, xdot);
     r.children.push_back(c);
   }
   // Add initial unknowns: Outputs
@@ -820,7 +894,7 @@ XmlNode DaeBuilderInternal::generate_model_structure() const {
     XmlNode c;
     c.name = "InitialUnknown";
     c.set_attribute("valueReference", static_cast<casadi_int>(y.value_reference));
-    c.set_attribute("dependencies", y.dependencies);
+    set_dependencies(c, y);
     r.children.push_back(c);
   }
   // Add initial unknowns: State derivative
@@ -829,7 +903,7 @@ XmlNode DaeBuilderInternal::generate_model_structure() const {
     XmlNode c;
     c.name = "InitialUnknown";
     c.set_attribute("valueReference", static_cast<casadi_int>(xdot.value_reference));
-    c.set_attribute("dependencies", xdot.dependencies);
+    set_dependencies(c, xdot);
     r.children.push_back(c);
   }
   // Add event indicators
@@ -838,7 +912,7 @@ XmlNode DaeBuilderInternal::generate_model_structure() const {
     XmlNode c;
     c.name = "EventIndicator";
     c.set_attribute("valueReference", static_cast<casadi_int>(zero.value_reference));
-    c.set_attribute("dependencies", zero.dependencies);
+    set_dependencies(c, zero);
     r.children.push_back(c);
   }
   return r;
@@ -847,45 +921,58 @@ XmlNode DaeBuilderInternal::generate_model_structure() const {
 void DaeBuilderInternal::update_dependencies() const {
   // Get oracle function
   const Function& oracle = this->oracle();
-  // Dependendencies of the ODE right-hand-side
-  Sparsity dode_dxT = oracle.jac_sparsity(oracle.index_out("ode"), oracle.index_in("x")).T();
-  Sparsity dode_duT = oracle.jac_sparsity(oracle.index_out("ode"), oracle.index_in("u")).T();
-  for (casadi_int i = 0; i < size(Category::X); ++i) {
-    // Get output variable
-    const Variable& xdot = variable(variable(Category::X, i).der);
-    // Clear dependencies
-    xdot.dependencies.clear();
-    // Dependencies on states
-    for (casadi_int k = dode_dxT.colind(i); k < dode_dxT.colind(i + 1); ++k) {
-      casadi_int j = dode_dxT.row(k);
-      xdot.dependencies.push_back(variable(Category::X, j).value_reference);
+  // Oracle inputs, stacked into a single vector
+  std::vector<casadi_int> offset = {0};
+  for (casadi_int i = 0; i < oracle.n_in(); ++i) offset.push_back(offset.back() + oracle.nnz_in(i));
+  MX v = MX::sym("v", offset.back());
+  std::vector<MX> res = oracle(vertsplit(v, offset));
+  // Unknowns: state derivatives, outputs and event indicators
+  std::vector<size_t> oind;
+  std::vector<MX> f;
+  for (std::string catname : {"ode", "y", "zero"}) {
+    std::vector<size_t> o;
+    if (catname == "ode") {
+      for (size_t i : indices(Category::X)) o.push_back(variable(i).der);
+    } else {
+      o = catname == "y" ? outputs_ : event_indicators_;
     }
-    // Dependencies on controls
-    for (casadi_int k = dode_duT.colind(i); k < dode_duT.colind(i + 1); ++k) {
-      casadi_int j = dode_duT.row(k);
-      xdot.dependencies.push_back(variable(Category::U, j).value_reference);
-    }
-  }
-  // Dependendencies of the outputs and event indicators
-  for (std::string catname : {"y", "zero"}) {
-    const std::vector<size_t>& oind = catname == "y" ? outputs_ : event_indicators_;
-    Sparsity dy_dxT = oracle.jac_sparsity(oracle.index_out(catname), oracle.index_in("x")).T();
-    Sparsity dy_duT = oracle.jac_sparsity(oracle.index_out(catname), oracle.index_in("u")).T();
-    for (casadi_int i = 0; i < oind.size(); ++i) {
-      // Get output variable
-      const Variable& y = variable(oind.at(i));
-      // Clear dependencies
-      y.dependencies.clear();
-      // Dependencies on states
-      for (casadi_int k = dy_dxT.colind(i); k < dy_dxT.colind(i + 1); ++k) {
-        casadi_int j = dy_dxT.row(k);
-        y.dependencies.push_back(variable(Category::X, j).value_reference);
-      }
-      // Dependencies on controls
-      for (casadi_int k = dy_duT.colind(i); k < dy_duT.colind(i + 1); ++k) {
-        casadi_int j = dy_duT.row(k);
-        y.dependencies.push_back(variable(Category::U, j).value_reference);
-      }
+    if (o.empty()) continue;
+    oind.insert(oind.end(), o.begin(), o.end());
+    f.push_back(res.at(oracle.index_out(catname)));
+  }
+  // Clear dependencies
+  for (size_t i : oind) {
+    variable(i).dependencies.clear();
+    variable(i).dependenciesKind.clear();
+  }
+  if (oind.empty()) return;
+  // Knowns: states, controls and parameters
+  std::vector<size_t> iind;
+  std::vector<casadi_int> col;
+  for (Category cat : {Category::X, Category::U, Category::P}) {
+    casadi_int i = oracle.index_in(to_string(cat));
+    for (casadi_int k = offset[i]; k < offset[i + 1]; ++k) col.push_back(k);
+    for (size_t k : indices(cat)) iind.push_back(k);
+  }
+  if (iind.empty()) return;
+  // Jacobian of all unknowns with respect to all knowns
+  MX jac = jacobian(vertcat(f), v)(Slice(), col);
+  Function J("jac_dependencies", {v}, {jac});
+  const Sparsity& sp = J.sparsity_out(0);
+  // Jacobian nonzeros that are not constant, i.e. the dependency is nonlinear
+  std::vector<bool> nonconst(sp.nnz(), false);
+  Sparsity dJ = J.jac_sparsity(0, 0, true);
+  const casadi_int* dJ_row = dJ.row();
+  for (casadi_int k = 0; k < dJ.nnz(); ++k) nonconst.at(dJ_row[k]) = true;
+  // Loop over rows of the Jacobian
+  std::vector<casadi_int> mapping;
+  Sparsity spT = sp.transpose(mapping);
+  for (casadi_int i = 0; i < oind.size(); ++i) {
+    const Variable& var = variable(oind[i]);
+    for (casadi_int k = spT.colind(i); k < spT.colind(i + 1); ++k) {
+      var.dependencies.push_back(variable(iind.at(spT.row(k))).value_reference);
+      var.dependenciesKind.push_back(nonconst[mapping[k]]
+        ? DependenciesKind::DEPENDENT : DependenciesKind::CONSTANT);
     }
   }
 }
@@ -1361,6 +1448,7 @@ const std::vector<size_t>& DaeBuilderInternal::indices(Category cat) const {
 }
 
 void DaeBuilderInternal::reorder(Category cat, const std::vector<size_t>& v) {
+  unsorted_.at(static_cast<size_t>(cat)) = true;
   return reorder(to_string(cat), indices(cat), v);
 }
 
@@ -1464,6 +1552,455 @@ void DaeBuilderInternal::tear() {
   for (auto& e : iv) indices(Category::Z).push_back(find(e));
   // Add output variables
   for (auto& e : iv_on_hold) indices(Category::U).push_back(find(e));
+  unsorted_.at(static_cast<size_t>(Category::Z)) = true;
+  unsorted_.at(static_cast<size_t>(Category::U)) = true;
+}
+
+void DaeBuilderInternal::causalize(const Dict& opts) {
+  // Default options
+  std::string solver = "newton";
+  Dict solver_options;
+  // Read options
+  for (auto&& op : opts) {
+    if (op.first == "rootfinder") {
+      solver = op.second.to_string();
+    } else if (op.first == "rootfinder_options") {
+      solver_options = op.second;
+    } else {
+      casadi_error("No such option: " + op.first);
+    }
+  }
+  // Quick return if no algebraic equations
+  if (size(Category::Z) == 0 && residuals_.empty()) return;
+  // Only scalar algebraic variables and residuals for now
+  for (size_t i : indices(Category::Z)) {
+    const Variable& v = variable(i);
+    casadi_assert(v.numel == 1, "Causalization requires scalar algebraic variables, "
+      "but " + v.name + " has dimension " + str(v.dimension));
+    casadi_assert(v.parent < 0, "Causalization of implicit differential equations "
+      "not supported: " + v.name);
+  }
+  for (size_t i : residuals_) {
+    casadi_assert(variable(i).numel == 1, "Causalization requires scalar residuals");
+  }
+  casadi_assert(size(Category::Z) == residuals_.size(), "Cannot causalize: "
+    + str(residuals_.size()) + " algebraic equations for "
+    + str(size(Category::Z)) + " algebraic variables");
+  // Clear cache after this
+  clear_cache_ = true;
+  // Residuals, with any dependent variables substituted
+  std::vector<MX> res = var(residuals_);
+  if (size(Category::W) > 0) {
+    sort(Category::W);
+    std::vector<MX> w = var(indices(Category::W));
+    std::vector<MX> wdef = output(OutputCategory::WDEF);
+    substitute_inplace(w, wdef, res);
+  }
+  // Algebraic variables
+  const std::vector<size_t> z_ind = indices(Category::Z);
+  const std::vector<size_t> res_ind = residuals_;
+  std::vector<MX> z = var(z_ind);
+  casadi_int n = z.size();
+  // Incidence matrix and its block triangular form
+  Sparsity J = MX::jacobian_sparsity(vertcat(res), vertcat(z));
+  std::vector<casadi_int> rowperm, colperm, rowblock, colblock, coarse_rowblock, coarse_colblock;
+  casadi_int nb = J.btf(rowperm, colperm, rowblock, colblock, coarse_rowblock, coarse_colblock);
+  for (casadi_int b = 0; b < nb; ++b) {
+    casadi_assert(rowblock[b + 1] - rowblock[b] == colblock[b + 1] - colblock[b],
+      "Cannot causalize: Algebraic equations are structurally singular");
+  }
+  // Variables of each equation
+  Sparsity Jt = J.T();
+  const casadi_int *Jt_colind = Jt.colind(), *Jt_row = Jt.row();
+  // Block of each variable
+  std::vector<casadi_int> var_block(n);
+  for (casadi_int b = 0; b < nb; ++b) {
+    for (casadi_int k = colblock[b]; k < colblock[b + 1]; ++k) var_block[colperm[k]] = b;
+  }
+  // Residuals that remain algebraic equations, variables that remain algebraic
+  std::vector<bool> keep_res(n, false), keep_z(n, false);
+  // Work vectors, only the entries of the current block are used
+  std::vector<bool> known(n, false), assigned(n, false);
+  std::vector<casadi_int> n_unknown(n, 0), count(n, 0);
+  // Dependent variables and their definitions, in order of evaluation
+  std::vector<size_t> new_w;
+  std::vector<MX> new_wdef;
+  // Number of torn blocks
+  casadi_int n_torn = 0, n_explicit = 0;
+  // Loop over blocks in order of evaluation
+  for (casadi_int b = 0; b < nb; ++b) {
+    // Equations and variables of the block
+    std::vector<casadi_int> beq(rowperm.begin() + rowblock[b], rowperm.begin() + rowblock[b + 1]);
+    for (casadi_int k = colblock[b]; k < colblock[b + 1]; ++k) known[colperm[k]] = false;
+    // Number of unknown variables in each equation
+    for (casadi_int e : beq) {
+      assigned[e] = false;
+      n_unknown[e] = 0;
+      for (casadi_int k = Jt_colind[e]; k < Jt_colind[e + 1]; ++k) {
+        if (var_block[Jt_row[k]] == b) n_unknown[e]++;
+      }
+    }
+    // Explicitly solved variables, definitions
+    std::vector<casadi_int> solved;
+    std::vector<MX> solved_sym, solved_def;
+    // Tearing variables
+    std::vector<casadi_int> torn;
+    // Greedy tearing: solve for variables that appear alone and linearly in an equation,
+    // otherwise tear the variable that appears in the most remaining equations
+    casadi_int n_remaining = beq.size();
+    while (n_remaining > 0) {
+      casadi_int sel = -1;
+      for (casadi_int e : beq) {
+        if (assigned[e] || n_unknown[e] != 1) continue;
+        // Find the unknown variable
+        casadi_int v = -1;
+        for (casadi_int k = Jt_colind[e]; k < Jt_colind[e + 1]; ++k) {
+          if (var_block[Jt_row[k]] == b && !known[Jt_row[k]]) v = Jt_row[k];
+        }
+        // Solve explicitly if the equation is linear in the variable with a nonzero
+        // constant coefficient, otherwise the variable is torn
+        MX a = jacobian(res[e], z[v]);
+        if (!symvar(a).empty()) continue;
+        double a_val = static_cast<double>(evalf(a));
+        if (a_val == 0 || std::isnan(a_val)) continue;
+        solved.push_back(v);
+        solved_sym.push_back(z[v]);
+        solved_def.push_back(-substitute(res[e], z[v], MX(0)) / a_val);
+        assigned[e] = true;
+        sel = v;
+        break;
+      }
+      if (sel < 0) {
+        // Tear the unknown variable with the most occurrences in unassigned equations
+        for (casadi_int k = colblock[b]; k < colblock[b + 1]; ++k) count[colperm[k]] = 0;
+        for (casadi_int e : beq) {
+          if (assigned[e]) continue;
+          for (casadi_int k = Jt_colind[e]; k < Jt_colind[e + 1]; ++k) {
+            casadi_int v = Jt_row[k];
+            if (var_block[v] == b && !known[v]) count[v]++;
+          }
+        }
+        for (casadi_int k = colblock[b]; k < colblock[b + 1]; ++k) {
+          casadi_int v = colperm[k];
+          if (!known[v] && (sel < 0 || count[v] > count[sel])) sel = v;
+        }
+        torn.push_back(sel);
+      }
+      // Mark as known
+      known[sel] = true;
+      n_remaining--;
+      for (casadi_int e : beq) {
+        for (casadi_int k = Jt_colind[e]; k < Jt_colind[e + 1]; ++k) {
+          if (Jt_row[k] == sel) n_unknown[e]--;
+        }
+      }
+    }
+    n_explicit += solved.size();
+    // Residual equations of the block
+    std::vector<casadi_int> beq_res;
+    for (casadi_int e : beq) {
+      if (!assigned[e]) beq_res.push_back(e);
+    }
+    casadi_assert_dev(beq_res.size() == torn.size());
+    if (!torn.empty()) {
+      n_torn++;
+      if (solver.empty()) {
+        // Keep the tearing variables and residuals as algebraic equations
+        for (casadi_int v : torn) keep_z[v] = true;
+        for (casadi_int e : beq_res) keep_res[e] = true;
+      } else {
+        // Residual as a function of the tearing variables
+        std::vector<MX> r, zt;
+        for (casadi_int e : beq_res) r.push_back(res[e]);
+        for (casadi_int v : torn) zt.push_back(z[v]);
+        substitute_inplace(solved_sym, solved_def, r);
+        // Everything else is a parameter
+        std::vector<MX> g_in = {vertcat(zt)};
+        for (const MX& e : symvar(vertcat(r))) {
+          if (!depends_on(vertcat(zt), e)) g_in.push_back(e);
+        }
+        Function g(name_ + "_blk" + str(n_torn) + "_res", g_in, {vertcat(r)});
+        Function rf = rootfinder(name_ + "_blk" + str(n_torn), solver, g, solver_options);
+        // Start values as initial guess
+        std::vector<double> zt0;
+        for (casadi_int v : torn) zt0.push_back(variable(z_ind[v]).start.at(0));
+        g_in.at(0) = DM(zt0);
+        std::vector<MX> zt_sol = vertsplit(rf(g_in).at(0));
+        for (size_t i = 0; i < torn.size(); ++i) {
+          new_w.push_back(z_ind[torn[i]]);
+          new_wdef.push_back(zt_sol[i]);
+        }
+      }
+    }
+    // Explicitly solved variables become dependent variables
+    for (size_t i = 0; i < solved.size(); ++i) {
+      new_w.push_back(z_ind[solved[i]]);
+      new_wdef.push_back(solved_def[i]);
+    }
+  }
+  // Remove the solved equations
+  residuals_.clear();
+  for (casadi_int e = 0; e < n; ++e) {
+    if (keep_res[e]) residuals_.push_back(res_ind[e]);
+  }
+  // Reclassify the solved variables as dependent variables
+  for (size_t i = 0; i < new_w.size(); ++i) {
+    Variable& v = variable(new_w[i]);
+    v.bind = assign(v.name, new_wdef[i]).index;
+  }
+  categorize(new_w, std::vector<Category>(new_w.size(), Category::W));
+  // Existing dependent variables may depend on the solved variables
+  sort(Category::W);
+  if (debug_) {
+    uout() << "Causalized " << n << " algebraic equations: " << nb << " blocks, "
+      << n_explicit << " variables solved explicitly, " << n_torn << " torn blocks" << std::endl;
+  }
+}
+
+void DaeBuilderInternal::reduce_index(const Dict& opts) {
+  // Default options
+  std::string algorithm = "pantelides";
+  casadi_int max_iter = 500;
+  // Read options
+  for (auto&& op : opts) {
+    if (op.first == "algorithm") {
+      algorithm = op.second.to_string();
+    } else if (op.first == "max_iter") {
+      max_iter = op.second;
+    } else {
+      casadi_error("No such option: " + op.first);
+    }
+  }
+  // Quick return if no algebraic equations
+  if (residuals_.empty()) return;
+  // Only scalar variables and equations for now
+  const std::vector<size_t> x_ind = indices(Category::X), z_ind = indices(Category::Z);
+  for (size_t i : x_ind) {
+    const Variable& v = variable(i);
+    casadi_assert(v.numel == 1, "Index reduction requires scalar states, "
+      "but " + v.name + " has dimension " + str(v.dimension));
+    casadi_assert(v.der >= 0 && variable(v.der).has_beq(),
+      "Index reduction requires a time derivative for " + v.name);
+  }
+  for (size_t i : z_ind) {
+    const Variable& v = variable(i);
+    casadi_assert(v.numel == 1, "Index reduction requires scalar algebraic variables, "
+      "but " + v.name + " has dimension " + str(v.dimension));
+    casadi_assert(v.parent < 0, "Index reduction of implicit differential equations "
+      "not supported: " + v.name);
+  }
+  for (size_t i : residuals_) {
+    casadi_assert(variable(i).numel == 1, "Index reduction requires scalar residuals");
+  }
+  casadi_assert(z_ind.size() == residuals_.size(), "Cannot reduce index: "
+    + str(residuals_.size()) + " algebraic equations for "
+    + str(z_ind.size()) + " algebraic variables");
+  casadi_int nx = x_ind.size(), nz = z_ind.size();
+  // Right-hand-sides and residuals, with any dependent variables substituted
+  std::vector<MX> ex = output(OutputCategory::ODE), alg = output(OutputCategory::ALG);
+  ex.insert(ex.end(), alg.begin(), alg.end());
+  if (size(Category::W) > 0) {
+    sort(Category::W);
+    std::vector<MX> w = var(indices(Category::W));
+    std::vector<MX> wdef = output(OutputCategory::WDEF);
+    substitute_inplace(w, wdef, ex);
+  }
+  // Implicit form: 0 = der_x - ode, 0 = alg
+  std::vector<MX> var_ext = var(x_ind), eq_ext;
+  for (casadi_int i = 0; i < nx; ++i) {
+    var_ext.push_back(MX::sym("der_" + variable(x_ind[i]).name));
+    eq_ext.push_back(var_ext.back() - ex[i]);
+  }
+  for (size_t i : z_ind) var_ext.push_back(variable(i).v);
+  eq_ext.insert(eq_ext.end(), ex.begin() + nx, ex.end());
+  casadi_int nv0 = var_ext.size();
+  // Structural analysis, var_map and eq_map point to the derivatives
+  Sparsity G = MX::jacobian_sparsity(vertcat(eq_ext), vertcat(var_ext));
+  std::vector<casadi_int> var_map(nv0, -1), eq_map;
+  for (casadi_int i = 0; i < nx; ++i) var_map[i] = nx + i;
+  IndexReduction::dae_struct_detect(algorithm, G, var_map, eq_map, max_iter);
+  // Quick return if no equation needs to be differentiated, i.e. index 1
+  if (std::all_of(eq_map.begin(), eq_map.end(), [](casadi_int e) { return e < 0;})) return;
+  // Clear cache after this
+  clear_cache_ = true;
+  // Derivatives introduced by the structural analysis
+  var_ext.resize(var_map.size());
+  for (casadi_int i = 0; i < var_map.size(); ++i) {
+    if (var_map[i] >= nv0) var_ext[var_map[i]] = MX::sym("der_" + var_ext[i].name());
+  }
+  // Inverse maps
+  std::vector<casadi_int> var_inv(var_map.size(), -1), eq_inv(eq_map.size(), -1);
+  for (casadi_int i = 0; i < var_map.size(); ++i) if (var_map[i] >= 0) var_inv[var_map[i]] = i;
+  for (casadi_int i = 0; i < eq_map.size(); ++i) if (eq_map[i] >= 0) eq_inv[eq_map[i]] = i;
+  // Time differentiation: all variables with derivatives, inputs are piecewise constant
+  std::vector<MX> j1, j2;
+  for (casadi_int i = 0; i < var_map.size(); ++i) {
+    if (var_map[i] >= 0) {
+      j1.push_back(var_ext[i]);
+      j2.push_back(var_ext[var_map[i]]);
+    }
+  }
+  if (has_t()) {
+    j1.push_back(time());
+    j2.push_back(1);
+  }
+  // Differentiate the equations, one level at a time to share subexpressions
+  eq_ext.resize(eq_map.size());
+  std::vector<casadi_int> eq_order(eq_map.size(), 0);
+  for (casadi_int i = 0; i < eq_map.size(); ++i) {
+    if (eq_map[i] >= 0) eq_order[eq_map[i]] = eq_order[i] + 1;
+  }
+  casadi_int max_order = *std::max_element(eq_order.begin(), eq_order.end());
+  for (casadi_int ord = 1; ord <= max_order; ++ord) {
+    std::vector<casadi_int> target;
+    std::vector<MX> block;
+    for (casadi_int i = 0; i < eq_map.size(); ++i) {
+      if (eq_map[i] >= 0 && eq_order[eq_map[i]] == ord) {
+        target.push_back(i);
+        block.push_back(eq_ext[i]);
+      }
+    }
+    std::vector<MX> dblock = vertsplit(jtimes(vertcat(block), vertcat(j1), vertcat(j2)));
+    for (size_t k = 0; k < target.size(); ++k) eq_ext[eq_map[target[k]]] = dblock[k];
+  }
+  // Numerical Jacobian at the start values, derivatives zero
+  MX V = vertcat(var_ext);
+  std::set<MXNode*> v_set;
+  for (const MX& v : var_ext) v_set.insert(v.get());
+  std::vector<MX> other;
+  std::vector<DM> other_val;
+  for (const MX& s : symvar(vertcat(eq_ext))) {
+    if (v_set.count(s.get())) continue;
+    other.push_back(s);
+    DM s_val = DM::zeros(s.sparsity());
+    if (has(s.name())) {
+      const Variable& v = variable(s.name());
+      if (v.start.size() == s.nnz()) s_val = DM(s.sparsity(), v.start);
+    }
+    other_val.push_back(s_val);
+  }
+  std::vector<double> v_val(var_ext.size(), 0);
+  for (casadi_int i = 0; i < nx; ++i) v_val[i] = variable(x_ind[i]).start.at(0);
+  for (casadi_int i = 0; i < nz; ++i) v_val[2 * nx + i] = variable(z_ind[i]).start.at(0);
+  for (double& e : v_val) if (std::isnan(e)) e = 0;
+  Function jfcn("jfcn", {V, veccat(other)}, {jacobian(vertcat(eq_ext), V)});
+  DM J = jfcn(std::vector<DM>{v_val, veccat(other_val)}).at(0);
+  const casadi_int *J_colind = J.colind(), *J_row = J.row();
+  const std::vector<double>& J_nz = J.nonzeros();
+  // Position of each equation among the differentiated equations of the current order
+  std::vector<casadi_int> h_pos(eq_ext.size(), -1);
+  // Dummy derivatives: Start with the highest order equations and derivatives
+  std::vector<bool> dummy(var_ext.size(), false);
+  std::vector<casadi_int> g, z;
+  for (casadi_int i = 0; i < eq_map.size(); ++i) if (eq_map[i] < 0) g.push_back(i);
+  for (casadi_int i = 0; i < var_map.size(); ++i) if (var_map[i] < 0) z.push_back(i);
+  casadi_int n_dummy = 0;
+  while (true) {
+    // Differentiated equations, derivatives of variables
+    std::vector<casadi_int> h, cand;
+    for (casadi_int e : g) if (eq_inv[e] >= 0) h.push_back(e);
+    if (h.empty()) break;
+    for (casadi_int v : z) if (var_inv[v] >= 0) cand.push_back(v);
+    casadi_int nh = h.size(), nc = cand.size();
+    casadi_assert(nc >= nh, "Dummy derivative selection failed");
+    // Select columns by Gaussian elimination with complete pivoting. The submatrix is
+    // gathered from the sparse Jacobian but eliminated densely, which limits this step
+    // to a few hundred differentiated equations per order
+    std::vector<double> H(nh * nc, 0);
+    double H_max = 0;
+    for (casadi_int r = 0; r < nh; ++r) h_pos[h[r]] = r;
+    for (casadi_int c = 0; c < nc; ++c) {
+      for (casadi_int k = J_colind[cand[c]]; k < J_colind[cand[c] + 1]; ++k) {
+        casadi_int r = h_pos[J_row[k]];
+        if (r < 0) continue;
+        H[r + c * nh] = J_nz[k];
+        H_max = std::max(H_max, std::fabs(J_nz[k]));
+      }
+    }
+    for (casadi_int e : h) h_pos[e] = -1;
+    std::vector<bool> row_used(nh, false), col_used(nc, false);
+    std::vector<casadi_int> sel;
+    for (casadi_int k = 0; k < nh; ++k) {
+      casadi_int pr = -1, pc = -1;
+      double p_max = 0;
+      for (casadi_int c = 0; c < nc; ++c) {
+        if (col_used[c]) continue;
+        for (casadi_int r = 0; r < nh; ++r) {
+          if (!row_used[r] && std::fabs(H[r + c * nh]) > p_max) {
+            p_max = std::fabs(H[r + c * nh]);
+            pr = r;
+            pc = c;
+          }
+        }
+      }
+      casadi_assert(p_max > 1e-12 * H_max, "Cannot select dummy derivatives: "
+        "Jacobian singular at the start values");
+      row_used[pr] = col_used[pc] = true;
+      sel.push_back(cand[pc]);
+      // Eliminate
+      for (casadi_int r = 0; r < nh; ++r) {
+        if (row_used[r]) continue;
+        double f = H[r + pc * nh] / H[pr + pc * nh];
+        for (casadi_int c = 0; c < nc; ++c) H[r + c * nh] -= f * H[pr + c * nh];
+      }
+    }
+    // Selected derivatives become algebraic variables
+    for (casadi_int v : sel) dummy[v] = true;
+    n_dummy += sel.size();
+    // Continue with the equations and variables one order lower
+    g.clear();
+    for (casadi_int e : h) g.push_back(eq_inv[e]);
+    z.clear();
+    for (casadi_int v : sel) z.push_back(var_inv[v]);
+  }
+  // Model variables for the new symbols
+  std::vector<casadi_int> vind(var_ext.size(), -1);
+  for (casadi_int i = 0; i < nx; ++i) vind[i] = x_ind[i];
+  for (casadi_int i = 0; i < nz; ++i) vind[2 * nx + i] = z_ind[i];
+  std::vector<MX> v_old, v_new;
+  for (casadi_int i = 0; i < var_ext.size(); ++i) {
+    if (vind[i] >= 0) continue;
+    // Name after the variable being differentiated
+    casadi_int i0 = var_inv[i];
+    Variable& v = add(unique_name("der_" + variable(vind[i0]).name, true),
+      Causality::LOCAL, Variability::CONTINUOUS, Dict());
+    vind[i] = v.index;
+    v_old.push_back(var_ext[i]);
+    v_new.push_back(v.v);
+  }
+  eq_ext = substitute(eq_ext, v_old, v_new);
+  // Reclassify: differential states are the variables with a derivative that is not a dummy
+  for (casadi_int i = 0; i < var_ext.size(); ++i) {
+    Variable& v = variable(vind[i]);
+    if (var_map[i] >= 0 && !dummy[var_map[i]]) {
+      // Differential state, its derivative is an algebraic variable
+      categorize(v.index, Category::X);
+      (void)get_der(v.index, true);
+      Variable& der_v = variable(v.der);
+      der_v.bind = assign(der_v.name, variable(vind[var_map[i]]).v).index;
+      categorize(der_v.index, Category::W);
+    } else {
+      // Algebraic variable
+      if (v.category == Category::X) {
+        // Previous time derivative no longer needed
+        categorize(v.der, Category::CALCULATED);
+      }
+      categorize(v.index, Category::Z);
+    }
+  }
+  // Replace the algebraic equations
+  residuals_.clear();
+  for (const MX& e : eq_ext) {
+    Variable& alg = add(unique_name("__alg__"), Causality::LOCAL, Variability::CONTINUOUS,
+      e, {{"dimension", std::vector<casadi_int>{1}}});
+    categorize(alg.index, Category::CALCULATED);
+    residuals_.push_back(alg.index);
+  }
+  casadi_assert_dev(size(Category::Z) == residuals_.size());
+  if (debug_) {
+    uout() << "Reduced index " << max_order + 1 << " to 1: " << (eq_ext.size() - nx - nz)
+      << " equations differentiated, " << n_dummy << " dummy derivatives" << std::endl;
+  }
 }
 
 void DaeBuilderInternal::tearing_variables(std::vector<std::string>* res,
@@ -2423,7 +2960,7 @@ void DaeBuilderInternal::sort_dependent(std::vector<MX>& v, std::vector<MX>& vde
   // Add diagonal (equation is v-vdef = 0)
   Jv = Jv + Sparsity::diag(Jv.size1());
   // If lower triangular, nothing to do
-  if (Jv.is_triu()) return;
+  if (Jv.is_tril()) return;
   // Perform a Dulmage-Mendelsohn decomposition
   std::vector<casadi_int> rowperm, colperm, rowblock, colblock, coarse_rowblock, coarse_colblock;
   (void)Jv.btf(rowperm, colperm, rowblock, colblock, coarse_rowblock, coarse_colblock);
@@ -2890,7 +3427,7 @@ void DaeBuilderInternal::categorize(size_t ind, Category cat) {
   if (v.category == cat) return;
   // Remove from current category, if any
   if (v.category != Category::NUMEL) {
-    remove(indices(v.category), ind);
+    remove(indices(v.category), ind, !is_acyclic(v.category));
     v.category = Category::NUMEL;
   }
   // Add to new category, if any
@@ -2899,31 +3436,90 @@ void DaeBuilderInternal::categorize(size_t ind, Category cat) {
     if (is_acyclic(cat)) {
       indices.push_back(ind);
     } else {
-      insert(indices, ind);
+      insert(indices, ind, !unsorted_.at(static_cast<size_t>(cat)));
     }
     v.category = cat;
   }
 }
 
-void DaeBuilderInternal::insert(std::vector<size_t>& v, size_t ind) const {
-  // Keep list ordered: Insert at location corresponding to model variable index
-  size_t loc = v.size();
-  for (size_t i = 0; i < v.size(); ++i) {
-    if (variable(v[i]).index >= ind) {
-      loc = i;
-      break;
+void DaeBuilderInternal::categorize(const std::vector<size_t>& ind,
+    const std::vector<Category>& cat) {
+  casadi_assert_dev(ind.size() == cat.size());
+  // Simulate the sequence: original category, final category and time of last change
+  std::map<size_t, std::pair<Category, Category>> changed;
+  std::vector<casadi_int> last_change(n_variables(), -1);
+  for (size_t k = 0; k < ind.size(); ++k) {
+    Category old_cat = variable(ind[k]).category;
+    auto it = changed.find(ind[k]);
+    if (it != changed.end()) old_cat = it->second.second;
+    if (old_cat == cat[k]) continue;
+    if (it == changed.end()) {
+      changed[ind[k]] = std::make_pair(old_cat, cat[k]);
+    } else {
+      it->second.second = cat[k];
+    }
+    last_change[ind[k]] = k;
+  }
+  if (changed.empty()) return;
+  // Remove from the original categories, one pass per category
+  std::vector<bool> affected(enum_traits<Category>::n_enum, false);
+  for (auto& c : changed) {
+    if (c.second.first != Category::NUMEL) affected[static_cast<size_t>(c.second.first)] = true;
+  }
+  for (size_t c = 0; c < affected.size(); ++c) {
+    if (!affected[c]) continue;
+    std::vector<size_t>& v = indices(static_cast<Category>(c));
+    v.erase(std::remove_if(v.begin(), v.end(), [&](size_t i) {
+      auto it = changed.find(i);
+      return it != changed.end() && it->second.first == static_cast<Category>(c);}), v.end());
+  }
+  // Add to the new categories in the order of the last change
+  std::vector<std::pair<casadi_int, size_t>> added;
+  for (auto& c : changed) {
+    variable(c.first).category = c.second.second;
+    if (c.second.second != Category::NUMEL) added.emplace_back(last_change[c.first], c.first);
+  }
+  std::sort(added.begin(), added.end());
+  for (auto& a : added) {
+    Category c = variable(a.second).category;
+    if (is_acyclic(c)) {
+      indices(c).push_back(a.second);
+    } else {
+      // Same position as a sequential insert
+      insert(indices(c), a.second, !unsorted_.at(static_cast<size_t>(c)));
     }
   }
-  v.insert(v.begin() + loc, ind);
 }
 
-void DaeBuilderInternal::remove(std::vector<size_t>& v, size_t ind) const {
-  for (auto it = v.begin(); it != v.end(); ++it) {
-    if (*it == ind) {
+void DaeBuilderInternal::insert(std::vector<size_t>& v, size_t ind, bool sorted) const {
+  // Keep list ordered: Insert at location corresponding to model variable index
+  if (!sorted) {
+    // List may have been reordered: Insert before the first element >= ind
+    v.insert(std::find_if(v.begin(), v.end(), [ind](size_t i) { return i >= ind; }), ind);
+  } else if (v.empty() || v.back() < ind) {
+    // Common case when loading models: append
+    v.push_back(ind);
+  } else {
+    v.insert(std::lower_bound(v.begin(), v.end(), ind), ind);
+  }
+}
+
+void DaeBuilderInternal::remove(std::vector<size_t>& v, size_t ind, bool ordered) const {
+  if (ordered) {
+    // Binary search, unless the list has been reordered
+    auto it = std::lower_bound(v.begin(), v.end(), ind);
+    if (it != v.end() && *it == ind) {
       v.erase(it);
       return;
     }
   }
+  // Search from the back, most recently added first
+  for (auto it = v.rbegin(); it != v.rend(); ++it) {
+    if (*it == ind) {
+      v.erase(std::next(it).base());
+      return;
+    }
+  }
   casadi_error("Variable not found");
 }
 
@@ -3549,12 +4145,17 @@ void DaeBuilderInternal::import_model_structure(const XmlNode& n) {
   // Do not use the automatic selection of outputs based on output causality
   outputs_.clear();
 
+  // Category changes, applied in bulk
+  std::vector<size_t> cat_ind;
+  std::vector<Category> cat_new;
+
   // Algebraic variables are handled internally in the FMU
   for (size_t i = 0; i < n_variables(); ++i) {
     Variable& v = variable(i);
     if (v.category == Category::Z) {
       // Mark as dependent variable, no need for an algebraic equation anymore
-      categorize(v.index, Category::W);
+      cat_ind.push_back(v.index);
+      cat_new.push_back(Category::W);
     }
   }
 
@@ -3582,8 +4183,10 @@ void DaeBuilderInternal::import_model_structure(const XmlNode& n) {
         Variable& v = variable(derivatives_.back());
         // Add to list of states and derivative to list of dependent variables
         casadi_assert(v.parent >= 0, "Error processing derivative info for " + v.name);
-        categorize(v.index, Category::W);
-        categorize(v.parent, Category::X);
+        cat_ind.push_back(v.index);
+        cat_new.push_back(Category::W);
+        cat_ind.push_back(v.parent);
+        cat_new.push_back(Category::X);
         // Map der field to derivative variable
         variable(v.parent).der = derivatives_.back();
         // Get dependencies
@@ -3609,6 +4212,7 @@ void DaeBuilderInternal::import_model_structure(const XmlNode& n) {
         casadi_error("Unknown ModelStructure element: " + e.name);
       }
     }
+    categorize(cat_ind, cat_new);
   } else {
     // Derivatives
     if (n.has_child("Derivatives")) {
@@ -3619,12 +4223,15 @@ void DaeBuilderInternal::import_model_structure(const XmlNode& n) {
         Variable& v = variable(derivatives_.back());
         // Add to list of states and derivative to list of dependent variables
         casadi_assert(v.parent >= 0, "Error processing derivative info for " + v.name);
-        categorize(v.index, Category::W);
-        categorize(v.parent, Category::X);
+        cat_ind.push_back(v.index);
+        cat_new.push_back(Category::W);
+        cat_ind.push_back(v.parent);
+        cat_new.push_back(Category::X);
         // Map der field to derivative variable
         variable(v.parent).der = derivatives_.back();
       }
     }
+    categorize(cat_ind, cat_new);
 
     // What if dependencies attributed is missing from Outputs,Derivatives?
     // Depends on x_ having been populated
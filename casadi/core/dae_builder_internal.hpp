@@ -268,6 +268,12 @@ class CASADI_EXPORT DaeBuilderInternal : public SharedObjectInternal {
 
   /// Identify free variables and residual equations
   void tear();
+
+  /// Causalize the algebraic equations: BLT decomposition and tearing
+  void causalize(const Dict& opts);
+
+  /// Reduce the index to one with the dummy derivative method
+  void reduce_index(const Dict& opts);
   ///@}
 
   /** @name Import and export
@@ -276,6 +282,9 @@ class CASADI_EXPORT DaeBuilderInternal : public SharedObjectInternal {
   /// Import existing problem from FMI/XML
   void load_fmi_description(const std::string& filename);
 
+  /// Parse an XML file, or load it from the cache keyed on the GUID
+  XmlNode read_xml(const std::string& filename) const;
+
   /// Get current date and time in the ISO 8601 format
   static std::string iso_8601_time();
 
@@ -486,6 +495,7 @@ protected:
   bool debug_;
   double fmutol_;
   bool ignore_time_;
+  std::string cache_dir_;
 
   // FMI attributes
   std::string fmi_version_;
@@ -541,6 +551,9 @@ protected:
   /// Ordered variables
   std::vector<std::vector<size_t>> indices_;
 
+  /// Categories that may no longer be sorted by variable index, e.g. after reorder
+  std::vector<bool> unsorted_;
+
   // Initial equations
   std::vector<size_t> init_;
 
@@ -596,11 +609,14 @@ protected:
   /// Set or change the category for a variable
   void categorize(size_t ind, Category cat);
 
-  /// Insert into list of variables, keeping it ordered
-  void insert(std::vector<size_t>& v, size_t ind) const;
+  /// Change the categories of multiple variables, same result as calling categorize in sequence
+  void categorize(const std::vector<size_t>& ind, const std::vector<Category>& cat);
+
+  /// Insert into list of variables, before the first variable with a larger or equal index
+  void insert(std::vector<size_t>& v, size_t ind, bool sorted = false) const;
 
   /// Remove from list of variables
-  void remove(std::vector<size_t>& v, size_t ind) const;
+  void remove(std::vector<size_t>& v, size_t ind, bool ordered = false) const;
 
   /// Get causality
   Causality causality(size_t ind) const;
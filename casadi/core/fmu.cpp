@@ -274,6 +274,14 @@ void Fmu::free_instance(void* instance) const {
   }
 }
 
+void Fmu::release_mem(FmuMemory* m) const {
+  try {
+    return (*this)->release_mem(m);
+  } catch(std::exception& e) {
+    THROW_ERROR("release_mem", e.what());
+  }
+}
+
 void Fmu::set(FmuMemory* m, size_t ind, const double* value) const {
   try {
     return (*this)->set(m, ind, value);
@@ -292,8 +300,12 @@ void Fmu::request(FmuMemory* m, size_t ind) const {
 
 int Fmu::eval(FmuMemory* m) const {
   try {
-    return (*this)->eval(m);
+    int flag = (*this)->eval(m);
+    // Instances that failed are not reused
+    if (flag) m->failed = true;
+    return flag;
   } catch(std::exception& e) {
+    m->failed = true;
     THROW_ERROR("eval", e.what());
   }
 }
@@ -341,8 +353,12 @@ void Fmu::request_fwd(FmuMemory* m, casadi_int ind) const {
 
 int Fmu::eval_fwd(FmuMemory* m, bool independent_seeds) const {
   try {
-    return (*this)->eval_fwd(m, independent_seeds);
+    int flag = (*this)->eval_fwd(m, independent_seeds);
+    // Instances that failed are not reused
+    if (flag) m->failed = true;
+    return flag;
   } catch(std::exception& e) {
+    m->failed = true;
     THROW_ERROR("eval_fwd", e.what());
   }
 }
@@ -398,8 +414,12 @@ void Fmu::request_adj(FmuMemory* m, casadi_int ind) const {
 
 int Fmu::eval_adj(FmuMemory* m) const {
   try {
-    return (*this)->eval_adj(m);
+    int flag = (*this)->eval_adj(m);
+    // Instances that failed are not reused
+    if (flag) m->failed = true;
+    return flag;
   } catch(std::exception& e) {
+    m->failed = true;
     THROW_ERROR("eval_adj", e.what());
   }
 }
@@ -1139,27 +1159,47 @@ int FmuInternal::discrete_states_iter(void* instance) const {
 int FmuInternal::init_mem(FmuMemory* m) const {
   // Ensure not already instantiated
   casadi_assert(m->instance == 0, "Already instantiated");
+  m->failed = false;
+  // Reuse an instance, if available
+  void* instance = nullptr;
+  {
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(instance_pool_mtx_);
+#endif // CASADI_WITH_THREAD
+    if (!instance_pool_.empty()) {
+      instance = instance_pool_.back();
+      instance_pool_.pop_back();
+    }
+  }
+  // Discard the state of the previous user
+  if (instance && reset(instance)) {
+    free_instance(instance);
+    instance = nullptr;
+  }
   // Create instance
-  m->instance = instantiate();
+  if (!instance) instance = instantiate();
   // Set all values
-  if (set_values(m->instance)) {
+  if (set_values(instance)) {
     casadi_warning("FmuInternal::set_values failed");
+    free_instance(instance);
     return 1;
   }
-  // Initialization mode begins
-  if (enter_initialization_mode(m->instance)) return 1;
-  // Initialization mode ends
-  if (exit_initialization_mode(m->instance)) return 1;
-  // Initial event iteration
-  if (discrete_states_iter(m->instance)) return 1;
-  // Continuous-time mode
-  if (enter_continuous_time_mode(m->instance)) return 1;
+  // Initialization, initial event iteration, continuous-time mode
+  if (enter_initialization_mode(instance) || exit_initialization_mode(instance)
+      || discrete_states_iter(instance) || enter_continuous_time_mode(instance)) {
+    // Do not return a partially initialized instance to the pool
+    free_instance(instance);
+    return 1;
+  }
+  m->instance = instance;
   // Allocate/reset input buffer
   m->ibuf_.resize(iind_.size());
   std::fill(m->ibuf_.begin(), m->ibuf_.end(), casadi::nan);
   // Allocate/reset output buffer
   m->obuf_.resize(oind_.size());
   std::fill(m->obuf_.begin(), m->obuf_.end(), casadi::nan);
+  m->oknown_.resize(oind_.size());
+  std::fill(m->oknown_.begin(), m->oknown_.end(), false);
   // Maximum input or output
   size_t max_io = std::max(iind_.size(), oind_.size());
   // Allocate/reset seeds
@@ -1180,6 +1220,25 @@ int FmuInternal::init_mem(FmuMemory* m) const {
   return 0;
 }
 
+void FmuInternal::release_mem(FmuMemory* m) const {
+  casadi_assert(m->instance != 0, "Not instantiated");
+  if (m->failed) {
+    // The instance may be in an error state
+    free_instance(m->instance);
+  } else {
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(instance_pool_mtx_);
+#endif // CASADI_WITH_THREAD
+    instance_pool_.push_back(m->instance);
+  }
+  m->instance = nullptr;
+}
+
+void FmuInternal::clear_instance_pool() {
+  for (void* instance : instance_pool_) free_instance(instance);
+  instance_pool_.clear();
+}
+
 void FmuInternal::set(FmuMemory* m, size_t ind, const double* value) const {
   if (value) {
     // Argument is given
@@ -1215,12 +1274,28 @@ int FmuInternal::eval(FmuMemory* m) const {
   gather_io(m);
   // Number of inputs and outputs
   size_t n_set = m->id_in_.size();
-  size_t n_out = m->id_out_.size();
-  // Set all variables
-  if (set_real(m->instance, get_ptr(m->vr_in_), n_set, get_ptr(m->v_in_), n_set)) {
-    casadi_warning("Setting FMU variables failed");
-    return 1;
+  // Set the variables that changed
+  if (n_set > 0) {
+    if (set_real(m->instance, get_ptr(m->vr_in_), n_set, get_ptr(m->v_in_), n_set)) {
+      casadi_warning("Setting FMU variables failed");
+      return 1;
+    }
+    // Outputs need to be recalculated
+    std::fill(m->oknown_.begin(), m->oknown_.end(), false);
+  } else {
+    // Skip outputs that are already known
+    size_t n_out = 0;
+    for (size_t k = 0; k < m->id_out_.size(); ++k) {
+      if (!m->oknown_[m->id_out_[k]]) {
+        m->id_out_[n_out] = m->id_out_[k];
+        m->vr_out_[n_out] = m->vr_out_[k];
+        n_out++;
+      }
+    }
+    m->id_out_.resize(n_out);
+    m->vr_out_.resize(n_out);
   }
+  size_t n_out = m->id_out_.size();
   // Quick return if nothing requested
   if (n_out == 0) return 0;
   // Calculate all variables
@@ -1233,6 +1308,7 @@ int FmuInternal::eval(FmuMemory* m) const {
   auto it = m->v_out_.begin();
   for (size_t id : m->id_out_) {
     m->obuf_[id] = *it++;
+    m->oknown_[id] = true;
   }
   // Successful return
   return 0;
@@ -168,6 +168,11 @@ class CASADI_EXPORT Fmu
   // Free FMU instance
   void free_instance(void* instance) const;
 
+  /** \brief Release the instance of a memory block to the instance pool
+
+      \identifier{2f3} */
+  void release_mem(FmuMemory* m) const;
+
   // Set value
   void set(FmuMemory* m, size_t ind, const double* value) const;
 
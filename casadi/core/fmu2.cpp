@@ -30,6 +30,8 @@
 namespace casadi {
 
 Fmu2::~Fmu2() {
+  // Free pooled instances while the DLL is still loaded
+  clear_instance_pool();
 }
 
 std::string Fmu2::system_infix() const {
@@ -237,7 +239,7 @@ void Fmu2::free_instance(void* instance) const {
   }
 }
 
-int Fmu2::reset(void* instance) {
+int Fmu2::reset(void* instance) const {
   auto c = static_cast<fmi2Component>(instance);
   fmi2Status status = reset_(c);
   if (status != fmi2OK) {
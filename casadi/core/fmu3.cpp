@@ -30,6 +30,8 @@
 namespace casadi {
 
 Fmu3::~Fmu3() {
+  // Free pooled instances while the DLL is still loaded
+  clear_instance_pool();
 }
 
 std::string Fmu3::system_infix() const {
@@ -231,7 +233,7 @@ void Fmu3::free_instance(void* instance) const {
   }
 }
 
-int Fmu3::reset(void* instance) {
+int Fmu3::reset(void* instance) const {
   auto c = static_cast<fmi3Instance>(instance);
   fmi3Status status = reset_(c);
   if (status != fmi3OK) {
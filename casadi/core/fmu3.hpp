@@ -113,7 +113,7 @@ class CASADI_EXPORT Fmu3 : public FmuInternal {
   void free_instance(void* instance) const override;
 
   // Reset solver
-  int reset(void* instance);
+  int reset(void* instance) const override;
 
   // Enter initialization mode
   int enter_initialization_mode(void* instance) const override;
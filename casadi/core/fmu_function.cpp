@@ -92,19 +92,13 @@ void FmuFunction::free_mem(void *mem) const {
   // Free slave memory
   for (FmuMemory*& s : m->slaves) {
     if (!s) continue;
-    // Free FMU memory
-    if (s->instance) {
-      fmu_.free_instance(s->instance);
-      s->instance = nullptr;
-    }
+    // Return FMU instance to the pool
+    if (s->instance) fmu_.release_mem(s);
     // Free the slave
     delete s;
   }
-  // Free FMI memory
-  if (m->instance) {
-    fmu_.free_instance(m->instance);
-    m->instance = nullptr;
-  }
+  // Return FMU instance to the pool
+  if (m->instance) fmu_.release_mem(m);
   // Free the memory object
   delete m;
 }
@@ -174,6 +168,7 @@ FmuFunction::FmuFunction(const std::string& name, const Fmu& fmu,
   new_forward_ = true;
   new_hessian_ = true;
   hessian_coloring_ = true;
+  jac_reverse_ = false;
   parallelization_ = Parallelization::SERIAL;
   // Number of parallel tasks, by default
   max_n_tasks_ = 1;
@@ -221,6 +216,11 @@ const Options FmuFunction::options_
     {"uses_directional_derivatives",
      {OT_BOOL,
       "Use the analytic forward directional derivative support in the FMU"}},
+    {"uses_adjoint_derivatives",
+     {OT_BOOL,
+      "Use the analytic adjoint directional derivative support in the FMU. "
+      "The extended Jacobian is then calculated row-wise if this requires fewer FMU calls "
+      "and the Hessian by finite differences of adjoint directional derivatives"}},
     {"validate_forward",
      {OT_BOOL,
       "Compare forward derivatives with finite differences for validation"}},
@@ -484,14 +484,32 @@ void FmuFunction::init(const Dict& opts) {
   if (verbose_) casadi_message("Jacobian graph coloring: " + str(jac_sp_.size2())
     + " -> " + str(jac_colors_.size2()) + " directions");
 
+  // Seeding the rows requires fewer FMU calls if the transpose needs fewer colors
+  jac_reverse_ = false;
+  if (has_jac_ && uses_adjoint_derivatives_ && !validate_forward_) {
+    jac_sp_trans_ = jac_sp_.transpose(jac_rmap_);
+    jac_rcolors_ = jac_sp_trans_.uni_coloring();
+    jac_reverse_ = jac_rcolors_.size2() < jac_colors_.size2();
+    if (verbose_) casadi_message("Transposed Jacobian graph coloring: " + str(jac_sp_.size1())
+      + " -> " + str(jac_rcolors_.size2()) + " directions, "
+      + (jac_reverse_ ? "using adjoint" : "using forward") + " derivatives for Jacobian");
+  }
+
   // Setup Jacobian memory
   casadi_jac_setup(&p_, jac_sp_, jac_colors_);
   p_.nom_in = get_ptr(jac_nom_in_);
   p_.map_out = get_ptr(jac_out_);
   p_.map_in = get_ptr(jac_in_);
+  if (jac_reverse_) {
+    // Rows of the extended Jacobian are seeded
+    casadi_jac_setup(&p_rev_, jac_sp_trans_, jac_rcolors_);
+    p_rev_.map_out = get_ptr(jac_in_);
+    p_rev_.map_in = get_ptr(jac_out_);
+  }
 
   // Do not use more threads than there are colors in the Jacobian
-  max_jac_tasks_ = std::min(max_n_tasks_, jac_colors_.size2());
+  max_jac_tasks_ = std::min(max_n_tasks_,
+    jac_reverse_ ? jac_rcolors_.size2() : jac_colors_.size2());
 
   // Work vector for storing extended Jacobian, shared between threads
   if (has_jac_) {
@@ -562,7 +580,7 @@ void FmuFunction::init(const Dict& opts) {
 
   // Work vectors for Jacobian/adjoint/Hessian calculation, for each thread
   casadi_int jac_iw, jac_w;
-  casadi_jac_work(&p_, &jac_iw, &jac_w);
+  casadi_jac_work(jac_reverse_ ? &p_rev_ : &p_, &jac_iw, &jac_w);
   alloc_iw(max_n_tasks_ * jac_iw, true);
   alloc_w(max_n_tasks_ * jac_w, true);
 }
@@ -904,7 +922,7 @@ int FmuFunction::eval(const double** arg, double** res, casadi_int* iw, double*
     s->jac_nz = jac_nz;
     s->hess_nz = hess_nz;
     // Thread specific memory
-    casadi_jac_init(&p_, &s->d, &iw, &w);
+    casadi_jac_init(jac_reverse_ ? &p_rev_ : &p_, &s->d, &iw, &w);
     if (task < max_hess_tasks_) {
       // Perturbed adjoint sensitivities
       s->pert_asens = w;
@@ -917,8 +935,18 @@ int FmuFunction::eval(const double** arg, double** res, casadi_int* iw, double*
   // Evaluate everything except Hessian, possibly in parallel
   if (verbose_) casadi_message("Evaluating regular outputs, forward sens, extended Jacobian");
   if (eval_all(m, max_jac_tasks_, true, need_jac, need_fwd, need_adj, false)) return 1;
+  // Row-wise Jacobian: adjoint sensitivities from the calculated Jacobian
+  if (need_jac && jac_reverse_ && need_adj) {
+    for (casadi_int d = 0; d < nadj_; ++d) {
+      propagate_adj(jac_nz, aseed + d * fmu_.n_out(), asens + d * fmu_.n_in());
+    }
+  }
   // Evaluate Hessian
   if (need_hess) {
+    // Unperturbed adjoint sensitivities, if not already calculated with the Jacobian
+    if (uses_adjoint_derivatives_ && !need_jac) {
+      if (eval_adj_jac(m, asens)) return 1;
+    }
     if (verbose_) casadi_message("Evaluating extended Hessian");
     if (eval_all(m, max_hess_tasks_, false, false, false, false, true)) return 1;
     // Post-process Hessian
@@ -1080,8 +1108,30 @@ int FmuFunction::eval_task(FmuMemory* m, casadi_int task, casadi_int n_task,
       }
     }
   }
-  // Evalute extended Jacobian and/or adjoint derivatives
-  if (need_jac || (need_adj && !uses_adjoint_derivatives_)) {
+  // Evaluate extended Jacobian row-wise
+  if (need_jac && jac_reverse_) {
+    // Selection of colors to be evaluated for the thread
+    casadi_int c_begin = (task * jac_rcolors_.size2()) / n_task;
+    casadi_int c_end = ((task + 1) * jac_rcolors_.size2()) / n_task;
+    // Loop over colors
+    for (casadi_int c = c_begin; c < c_end; ++c) {
+      // Print progress
+      if (print_progress_) print("Jacobian calculation, thread %d/%d: Seeding output %d/%d\n",
+        task + 1, n_task, c - c_begin + 1, c_end - c_begin);
+      // Get derivative directions, outputs in the same color depend on disjoint inputs
+      casadi_jac_pre(&p_rev_, &m->d, c);
+      // Calculate derivatives
+      fmu_.set_adj(m, m->d.nseed, m->d.iseed, m->d.seed);
+      fmu_.request_adj(m, m->d.nsens, m->d.isens, m->d.wrt);
+      if (fmu_.eval_adj(m)) return 1;
+      fmu_.get_adj(m, m->d.nsens, m->d.isens, m->d.sens);
+      // Collect Jacobian nonzeros
+      for (casadi_int i = 0; i < m->d.nsens; ++i) {
+        m->jac_nz[jac_rmap_[m->d.nzind[i]]] = m->d.sens[i];
+      }
+    }
+  } else if (need_jac || (need_adj && !uses_adjoint_derivatives_)) {
+    // Evalute extended Jacobian column-wise and/or adjoint derivatives
     // Selection of colors to be evaluated for the thread
     casadi_int c_begin = (task * jac_colors_.size2()) / n_task;
     casadi_int c_end = ((task + 1) * jac_colors_.size2()) / n_task;
@@ -1206,23 +1256,8 @@ int FmuFunction::eval_task(FmuMemory* m, casadi_int task, casadi_int n_task,
       }
       // Calculate perturbed inputs
       if (fmu_.eval(m)) return 1;
-      // Clear perturbed adjoint sensitivities
-      std::fill(m->pert_asens, m->pert_asens + fmu_.n_in(), 0);
-      // Loop over colors of the Jacobian
-      for (casadi_int c1 = 0; c1 < jac_colors_.size2(); ++c1) {
-       // Get derivative directions
-       casadi_jac_pre(&p_, &m->d, c1);
-       // Calculate derivatives
-       fmu_.set_fwd(m, m->d.nseed, m->d.iseed, m->d.seed);
-       fmu_.request_fwd(m, m->d.nsens, m->d.isens, m->d.wrt);
-       if (fmu_.eval_fwd(m, true)) return 1;
-       fmu_.get_fwd(m, m->d.nsens, m->d.isens, m->d.sens);
-       // Scale derivatives
-       casadi_jac_scale(&p_, &m->d);
-       // Propagate adjoint sensitivities
-       for (casadi_int i = 0; i < m->d.nsens; ++i)
-         m->pert_asens[m->d.wrt[i]] += m->aseed[m->d.isens[i]] * m->d.sens[i];
-      }
+      // Perturbed adjoint sensitivities
+      if (eval_adj_jac(m, m->pert_asens)) return 1;
       // Count how many times each input is calculated
       std::fill(m->star_iw, m->star_iw + fmu_.n_in(), 0);
       for (casadi_int v = 0; v < nv; ++v) {
@@ -1260,6 +1295,55 @@ int FmuFunction::eval_task(FmuMemory* m, casadi_int task, casadi_int n_task,
   return 0;
 }
 
+int FmuFunction::eval_adj_jac(FmuMemory* m, double* asens) const {
+  // Clear adjoint sensitivities
+  std::fill(asens, asens + fmu_.n_in(), 0);
+  if (uses_adjoint_derivatives_) {
+    // A single adjoint directional derivative
+    for (size_t i : jac_out_) {
+      casadi_int id = i;
+      fmu_.set_adj(m, 1, &id, m->aseed + i);
+    }
+    casadi_int wrt_id = -1;
+    for (size_t j : jac_in_) {
+      casadi_int id = j;
+      fmu_.request_adj(m, 1, &id, &wrt_id);
+    }
+    if (fmu_.eval_adj(m)) return 1;
+    for (size_t j : jac_in_) {
+      casadi_int id = j;
+      fmu_.get_adj(m, 1, &id, asens + j);
+    }
+  } else {
+    // Loop over colors of the Jacobian
+    for (casadi_int c = 0; c < jac_colors_.size2(); ++c) {
+      // Get derivative directions
+      casadi_jac_pre(&p_, &m->d, c);
+      // Calculate derivatives
+      fmu_.set_fwd(m, m->d.nseed, m->d.iseed, m->d.seed);
+      fmu_.request_fwd(m, m->d.nsens, m->d.isens, m->d.wrt);
+      if (fmu_.eval_fwd(m, true)) return 1;
+      fmu_.get_fwd(m, m->d.nsens, m->d.isens, m->d.sens);
+      // Scale derivatives
+      casadi_jac_scale(&p_, &m->d);
+      // Propagate adjoint sensitivities
+      for (casadi_int i = 0; i < m->d.nsens; ++i)
+        asens[m->d.wrt[i]] += m->aseed[m->d.isens[i]] * m->d.sens[i];
+    }
+  }
+  return 0;
+}
+
+void FmuFunction::propagate_adj(const double* jac_nz, const double* aseed,
+    double* asens) const {
+  const casadi_int *colind = jac_sp_.colind(), *row = jac_sp_.row();
+  for (casadi_int c = 0; c < jac_sp_.size2(); ++c) {
+    for (casadi_int k = colind[c]; k < colind[c + 1]; ++k) {
+      asens[jac_in_[c]] += aseed[jac_out_[row[k]]] * jac_nz[k];
+    }
+  }
+}
+
 void FmuFunction::check_hessian(FmuMemory* m, const double *hess_nz, casadi_int* iw) const {
   // Get Hessian sparsity pattern
   casadi_int n = hess_sp_.size1();
@@ -1580,7 +1664,7 @@ Dict FmuFunction::get_stats(void *mem) const {
 
 void FmuFunction::serialize_body(SerializingStream &s) const {
   FunctionInternal::serialize_body(s);
-  s.version("FmuFunction", 3);
+  s.version("FmuFunction", 4);
 
   s.pack("FmuFunction::Fmu", fmu_);
 
@@ -1634,6 +1718,8 @@ void FmuFunction::serialize_body(SerializingStream &s) const {
   s.pack("FmuFunction::jac_colors", jac_colors_);
   s.pack("FmuFunction::hess_colors", hess_colors_);
   s.pack("FmuFunction::nonlin", nonlin_);
+  s.pack("FmuFunction::jac_reverse", jac_reverse_);
+  s.pack("FmuFunction::jac_rcolors", jac_rcolors_);
 
 
   s.pack("FmuFunction::max_jac_tasks", max_jac_tasks_);
@@ -1643,7 +1729,7 @@ void FmuFunction::serialize_body(SerializingStream &s) const {
 }
 
 FmuFunction::FmuFunction(DeserializingStream& s) : FunctionInternal(s) {
-  s.version("FmuFunction", 3);
+  int version = s.version("FmuFunction", 3, 4);
 
   s.unpack("FmuFunction::Fmu", fmu_);
 
@@ -1708,6 +1794,12 @@ FmuFunction::FmuFunction(DeserializingStream& s) : FunctionInternal(s) {
   s.unpack("FmuFunction::jac_colors", jac_colors_);
   s.unpack("FmuFunction::hess_colors", hess_colors_);
   s.unpack("FmuFunction::nonlin", nonlin_);
+  if (version >= 4) {
+    s.unpack("FmuFunction::jac_reverse", jac_reverse_);
+    s.unpack("FmuFunction::jac_rcolors", jac_rcolors_);
+  } else {
+    jac_reverse_ = false;
+  }
 
   s.unpack("FmuFunction::max_jac_tasks", max_jac_tasks_);
   s.unpack("FmuFunction::max_hess_tasks", max_hess_tasks_);
@@ -1719,6 +1811,12 @@ FmuFunction::FmuFunction(DeserializingStream& s) : FunctionInternal(s) {
     p_.nom_in = get_ptr(jac_nom_in_);
     p_.map_out = get_ptr(jac_out_);
     p_.map_in = get_ptr(jac_in_);
+    if (jac_reverse_) {
+      jac_sp_trans_ = jac_sp_.transpose(jac_rmap_);
+      casadi_jac_setup(&p_rev_, jac_sp_trans_, jac_rcolors_);
+      p_rev_.map_out = get_ptr(jac_in_);
+      p_rev_.map_in = get_ptr(jac_out_);
+    }
   }
 
 }
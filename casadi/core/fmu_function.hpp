@@ -59,6 +59,8 @@ struct CASADI_EXPORT FmuMemory : public FunctionMemory {
   casadi_jac_data<double> d;
   // Instance memory
   void* instance;
+  // Has an evaluation failed since the instance was initialized?
+  bool failed;
   // Additional (slave) memory objects
   std::vector<FmuMemory*> slaves;
   // Input and output buffers
@@ -67,6 +69,8 @@ struct CASADI_EXPORT FmuMemory : public FunctionMemory {
   std::vector<double> isens_, osens_;
   // Which inputs and outputs have been marked
   std::vector<bool> imarked_, omarked_;
+  // Which outputs in obuf_ are consistent with the inputs set
+  std::vector<bool> oknown_;
   // Derivative with respect to
   std::vector<size_t> wrt_;
   // Current known/unknown variables
@@ -80,7 +84,7 @@ struct CASADI_EXPORT FmuMemory : public FunctionMemory {
   // Work vector (reals)
   std::vector<double> v_in_, v_out_, d_in_, d_out_, fd_out_, v_pert_;
   // Constructor
-  explicit FmuMemory(const FmuFunction& self) : self(self), instance(nullptr) {}
+  explicit FmuMemory(const FmuFunction& self) : self(self), instance(nullptr), failed(false) {}
 };
 
 /// Type of parallelization
@@ -220,11 +224,18 @@ class CASADI_EXPORT FmuFunction : public FunctionInternal {
   // Graph coloring
   Sparsity jac_colors_, hess_colors_;
 
+  // Calculate the extended Jacobian row-wise, using adjoint derivatives
+  bool jac_reverse_;
+
+  // Transpose of extended Jacobian sparsity, its graph coloring and nonzero mapping
+  Sparsity jac_sp_trans_, jac_rcolors_;
+  std::vector<casadi_int> jac_rmap_;
+
   // Nonlinearly entering variables
   std::vector<casadi_int> nonlin_;
 
-  // Jacobian memory
-  casadi_jac_prob<double> p_;
+  // Jacobian memory, column-wise and row-wise
+  casadi_jac_prob<double> p_, p_rev_;
 
   // Number of parallel tasks
   casadi_int max_jac_tasks_, max_hess_tasks_, max_n_tasks_;
@@ -264,6 +275,12 @@ class CASADI_EXPORT FmuFunction : public FunctionInternal {
   int eval_task(FmuMemory* m, casadi_int task, casadi_int n_task,
     bool need_nondiff, bool need_jac, bool need_fwd, bool need_adj, bool need_hess) const;
 
+  // Adjoint sensitivities of the extended Jacobian outputs, first adjoint direction
+  int eval_adj_jac(FmuMemory* m, double* asens) const;
+
+  // Propagate adjoint sensitivities through a calculated extended Jacobian
+  void propagate_adj(const double* jac_nz, const double* aseed, double* asens) const;
+
   // Remove NaNs from Hessian (necessary for star coloring approach)
   void remove_nans(double *hess_nz, casadi_int* iw) const;
 
@@ -30,6 +30,14 @@
 #include "shared_object.hpp"
 #include "resource.hpp"
 
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.mutex.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <mutex>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
+
 /// \cond INTERNAL
 
 namespace casadi {
@@ -177,6 +185,20 @@ class CASADI_EXPORT FmuInternal : public SharedObjectInternal {
   // Free FMU instance
   virtual void free_instance(void* c) const = 0;
 
+  // Reset an FMU instance to the state after instantiation
+  virtual int reset(void* instance) const = 0;
+
+  /** \brief Return the instance of a memory block to the pool
+
+      The instance is reset and initialized again before it is handed to the
+      next memory block. Instances whose evaluation failed are freed instead.
+
+      \identifier{2f2} */
+  void release_mem(FmuMemory* m) const;
+
+  // Free all pooled instances, must be called by the destructor of derived classes
+  void clear_instance_pool();
+
   // Set value
   void set(FmuMemory* m, size_t ind, const double* value) const;
 
@@ -340,6 +362,12 @@ class CASADI_EXPORT FmuInternal : public SharedObjectInternal {
   size_t nx_;
   // Instead of set_real+get_real, do set_real+get_real+get_derivatives+get_real
   bool do_evaluation_dance_;
+
+  // Instances that are not in use
+  mutable std::vector<void*> instance_pool_;
+#ifdef CASADI_WITH_THREAD
+  mutable std::mutex instance_pool_mtx_;
+#endif // CASADI_WITH_THREAD
 };
 
 template<typename T>
@@ -33,6 +33,7 @@
 #include "mapsum.hpp"
 #include "conic.hpp"
 #include "jit_function.hpp"
+#include "lazy_function.hpp"
 #include "serializing_stream.hpp"
 #include "serializer.hpp"
 #include "tools.hpp"
@@ -1267,7 +1268,15 @@ namespace casadi {
 
 
   void Function::save(const std::string &fname, const Dict& opts) const {
-    FileSerializer fs(fname, opts);
+    // Indexed archive with lazily loaded nested functions?
+    Dict stream_opts = opts;
+    auto it = stream_opts.find("lazy");
+    if (it!=stream_opts.end()) {
+      bool lazy = it->second;
+      stream_opts.erase(it);
+      if (lazy) return FunctionArchive::save(*this, fname, stream_opts);
+    }
+    FileSerializer fs(fname, stream_opts);
     fs.pack(*this);
   }
 
@@ -1346,7 +1355,9 @@ namespace casadi {
     return deserialize(s);
   }
 
-  Function Function::load(const std::string& filename) {
+  Function Function::load(const std::string& filename, const Dict& opts) {
+    if (FunctionArchive::is_archive(filename)) return FunctionArchive::load(filename, opts);
+    casadi_assert(opts.empty(), "Options for 'load' only apply to archives saved with 'lazy'.");
     FileDeserializer fs(filename);
     auto t = fs.pop_type();
     if (t==SerializerBase::SerializationType::SERIALIZED_FUNCTION) {
@@ -898,11 +898,18 @@ namespace casadi {
 
     /** \brief Serialize
 
+        Options: "debug" adds type decorations, "bulk" writes raw bytes with
+        numeric arrays as contiguous blocks (faster, not text-safe)
+
         \identifier{1x2} */
     std::string serialize(const Dict& opts=Dict()) const;
 
     /** \brief Save Function to a file
 
+        Pass {"bulk": true} for a compact binary file that loads with block reads.
+        Pass {"lazy": true} for an indexed archive: every nested Function is stored once,
+        as a separate entry, and is deserialized only when first used after \ref load
+
         \see load
 
         \identifier{240} */
@@ -1192,8 +1199,13 @@ namespace casadi {
 
     /** \brief Build function from serialization
 
+        Archives written with {"lazy": true} are memory-mapped, so that processes
+        loading the same file share its pages. For archives, {"preload": true}
+        deserializes all entries right away, concurrently on up to "max_num_threads"
+        threads, instead of on first use
+
         \identifier{1y1} */
-    static Function load(const std::string& filename);
+    static Function load(const std::string& filename, const Dict& opts=Dict());
 
     /** \brief Build function from serialization
 
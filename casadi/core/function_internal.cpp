@@ -36,6 +36,7 @@
 #include "rootfinder_impl.hpp"
 #include "map.hpp"
 #include "mapsum.hpp"
+#include "multistart.hpp"
 #include "switch.hpp"
 #include "interpolant_impl.hpp"
 #include "nlpsol_impl.hpp"
@@ -4158,6 +4159,7 @@ namespace casadi {
     {"Switch", Switch::deserialize},
     {"Map", Map::deserialize},
     {"MapSum", MapSum::deserialize},
+    {"Multistart", Multistart::deserialize},
     {"Nlpsol", Nlpsol::deserialize},
     {"Rootfinder", Rootfinder::deserialize},
     {"Integrator", Integrator::deserialize},
@@ -287,6 +287,22 @@ namespace casadi {
     const Dict& init_solver_options=Dict());
   /// @}
 
+#ifndef SWIG
+  /// \cond INTERNAL
+  namespace IndexReduction {
+    /** \brief Structural index reduction
+
+        Equations are the rows and variables the columns of graph.
+        var_map and eq_map are extended with the derivatives introduced, see dae_reduce_index
+
+        \identifier{2f7} */
+    CASADI_EXPORT void dae_struct_detect(const std::string& algorithm,
+      const Sparsity& graph, std::vector<casadi_int>& var_map,
+      std::vector<casadi_int>& eq_map, casadi_int max_iter);
+  } // namespace IndexReduction
+  /// \endcond
+#endif // SWIG
+
 } // namespace casadi
 
 #endif // CASADI_INTEGRATION_TOOLS_HPP
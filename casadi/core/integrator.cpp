@@ -1867,6 +1867,7 @@ FixedStepIntegrator::FixedStepIntegrator(const std::string& name, const Function
 
   // Default options
   nk_target_ = 20;
+  dense_output_ = false;
 }
 
 FixedStepIntegrator::~FixedStepIntegrator() {
@@ -1882,6 +1883,12 @@ const Options FixedStepIntegrator::options_
     {"simplify",
       {OT_BOOL,
       "Implement as MX Function (codegeneratable/serializable) default: false"}},
+    {"dense_output",
+      {OT_BOOL,
+      "Take finite elements independently of the output times and obtain the outputs "
+      "by interpolation within the finite elements. Finite elements still end at step "
+      "changes in the controls. Not used for the backward problem or with events. "
+      "default: false"}},
     {"simplify_options",
       {OT_DICT,
       "Any options to pass to simplified form Function constructor"}}
@@ -1960,12 +1967,25 @@ void FixedStepIntegrator::init(const Dict& opts) {
   for (auto&& op : opts) {
     if (op.first=="number_of_finite_elements") {
       nk_target_ = op.second;
+    } else if (op.first=="dense_output") {
+      dense_output_ = op.second;
     }
   }
 
   // Consistency check
   casadi_assert(nk_target_ > 0, "Number of finite elements must be strictly positive");
 
+  // Dense output requires a finite element grid known at initialization for events and taping
+  if (dense_output_ && ne_ > 0) {
+    casadi_warning("Option 'dense_output' is not supported with events and will be ignored");
+    dense_output_ = false;
+  }
+  if (dense_output_ && nrx_ > 0) {
+    casadi_warning("Option 'dense_output' is not supported with backward states "
+      "and will be ignored");
+    dense_output_ = false;
+  }
+
   // Target interval length
   double h_target = (tout_.back() - t0_) / nk_target_;
 
@@ -1981,6 +2001,13 @@ void FixedStepIntegrator::init(const Dict& opts) {
   // Setup discrete time dynamics
   setup_step();
 
+  // Interpolation within the finite elements
+  if (dense_output_) {
+    casadi_assert(has_function("dense"), "Option 'dense_output' not supported for "
+      + class_name());
+    if (nfwd_ > 0) create_forward("dense", nfwd_);
+  }
+
   // Get discrete time dimensions
   const Function& F = get_function(has_function("step") ? "step" : "implicit_step");
   nv1_ = F.nnz_out(STEP_VF);
@@ -2004,6 +2031,14 @@ void FixedStepIntegrator::init(const Dict& opts) {
     alloc_w((disc_.back() + 1) * nx_, true); // x_tape
     alloc_w(disc_.back() * nv_, true); // v_tape
   }
+
+  // Current finite element, if dense output
+  if (dense_output_) {
+    alloc_w(nx_, true); // x_elem
+    alloc_w(nq_, true); // q_elem
+    alloc_w(nx_, true); // x_elem_prev
+    alloc_w(nq_, true); // q_elem_prev
+  }
 }
 
 void FixedStepIntegrator::set_work(void* mem, const double**& arg, double**& res,
@@ -2029,6 +2064,14 @@ void FixedStepIntegrator::set_work(void* mem, const double**& arg, double**& res
     m->x_tape = w; w += (disc_.back() + 1) * nx_;
     m->v_tape = w; w += disc_.back() * nv_;
   }
+
+  // Current finite element, if dense output
+  if (dense_output_) {
+    m->x_elem = w; w += nx_;
+    m->q_elem = w; w += nq_;
+    m->x_elem_prev = w; w += nx_;
+    m->q_elem_prev = w; w += nq_;
+  }
 }
 
 int FixedStepIntegrator::init_mem(void* mem) const {
@@ -2041,6 +2084,9 @@ int FixedStepIntegrator::init_mem(void* mem) const {
 int FixedStepIntegrator::advance_noevent(IntegratorMemory* mem) const {
   auto m = static_cast<FixedStepMemory*>(mem);
 
+  // Take finite elements independently of the output times
+  if (dense_output_) return advance_dense(m);
+
   // State at previous step
   double* x_prev = m->tmp1;
 
@@ -2076,6 +2122,49 @@ int FixedStepIntegrator::advance_noevent(IntegratorMemory* mem) const {
   return 0;
 }
 
+int FixedStepIntegrator::advance_dense(FixedStepMemory* m) const {
+  // Target finite element length
+  double h_target = (tout_.back() - t0_) / nk_target_;
+
+  // Take steps until the current finite element contains the next output time
+  while (m->t_elem_end < m->t_next) {
+    // Distribute the steps evenly until the next change in input or the end,
+    // allowing for rounding errors in the accumulated time
+    double t_left = m->t_stop - m->t_elem_end;
+    casadi_int nj = std::max(casadi_int(1),
+      static_cast<casadi_int>(std::ceil(t_left / h_target - 1e-8)));
+    double h = t_left / nj;
+
+    // Update the previous step
+    casadi_copy(m->x_elem, nx_, m->x_elem_prev);
+    casadi_copy(m->v, nv_, m->v_prev);
+    casadi_copy(m->q_elem, nq_, m->q_elem_prev);
+
+    // Take step
+    stepF(m, m->t_elem_end, h, m->x_elem_prev, m->v_prev, m->x_elem, m->v, m->q_elem);
+    casadi_axpy(nq_, 1., m->q_elem_prev, m->q_elem);
+
+    // Update the finite element, landing exactly on the stopping time
+    m->t_elem_start = m->t_elem_end;
+    m->t_elem_end = nj == 1 ? m->t_stop : m->t_elem_start + h;
+  }
+
+  if (m->t_next == m->t_elem_end) {
+    // Output time coincides with the end of the finite element
+    casadi_copy(m->x_elem, nx_, m->x);
+    casadi_copy(m->q_elem, nq_, m->q);
+    if (m->t_elem_end > m->t_elem_start) casadi_copy(m->v + nv_ - nz_, nz_, m->z);
+  } else {
+    // Interpolate within the finite element
+    double h = m->t_elem_end - m->t_elem_start;
+    double theta = (m->t_next - m->t_elem_start) / h;
+    denseF(m, m->t_elem_start, h, theta, m->x_elem_prev, m->v, m->x, m->z, m->q);
+    casadi_axpy(nq_, 1., m->q_elem_prev, m->q);
+  }
+
+  return 0;
+}
+
 void FixedStepIntegrator::retreat(IntegratorMemory* mem, const double* u,
     double* adj_x, double* adj_p, double* adj_u) const {
   auto m = static_cast<FixedStepMemory*>(mem);
@@ -2147,6 +2236,41 @@ void FixedStepIntegrator::stepF(FixedStepMemory* m, double t, double h,
   }
 }
 
+void FixedStepIntegrator::denseF(FixedStepMemory* m, double t, double h, double theta,
+    const double* x0, const double* v, double* x, double* z, double* q) const {
+  // Evaluate nondifferentiated
+  std::fill(m->arg, m->arg + DENSE_NUM_IN, nullptr);
+  m->arg[DENSE_T] = &t;  // t
+  m->arg[DENSE_H] = &h;  // h
+  m->arg[DENSE_X0] = x0;  // x0
+  m->arg[DENSE_V] = v;  // v
+  m->arg[DENSE_P] = m->p;  // p
+  m->arg[DENSE_U] = m->u;  // u
+  m->arg[DENSE_THETA] = &theta;  // theta
+  std::fill(m->res, m->res + DENSE_NUM_OUT, nullptr);
+  m->res[DENSE_X] = x;  // x
+  m->res[DENSE_Z] = z;  // z
+  m->res[DENSE_Q] = q;  // q
+  calc_function(m, "dense");
+  // Evaluate sensitivities
+  if (nfwd_ > 0) {
+    m->arg[DENSE_NUM_IN + DENSE_X] = x;  // out:x
+    m->arg[DENSE_NUM_IN + DENSE_Z] = z;  // out:z
+    m->arg[DENSE_NUM_IN + DENSE_Q] = q;  // out:q
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_T] = nullptr;  // fwd:t
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_H] = nullptr;  // fwd:h
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_X0] = x0 + nx1_;  // fwd:x0
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_V] = v + nv1_;  // fwd:v
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_P] = m->p + np1_;  // fwd:p
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_U] = m->u + nu1_;  // fwd:u
+    m->arg[DENSE_NUM_IN + DENSE_NUM_OUT + DENSE_THETA] = nullptr;  // fwd:theta
+    m->res[DENSE_X] = x + nx1_;  // fwd:x
+    m->res[DENSE_Z] = z + nz1_;  // fwd:z
+    m->res[DENSE_Q] = q + nq1_;  // fwd:q
+    calc_function(m, forward_name("dense", nfwd_));
+  }
+}
+
 void FixedStepIntegrator::stepB(FixedStepMemory* m, double t, double h,
     const double* x0, const double* xf, const double* vf,
     const double* adj_xf, const double* rv0,
@@ -2219,6 +2343,13 @@ void FixedStepIntegrator::reset(IntegratorMemory* mem, bool first_call) const {
       casadi_copy(m->x, nx_, m->x_tape);
     }
   }
+
+  // Start a new finite element at the current time
+  if (dense_output_) {
+    casadi_copy(m->x, nx_, m->x_elem);
+    casadi_copy(m->q, nq_, m->q_elem);
+    m->t_elem_start = m->t_elem_end = m->t;
+  }
 }
 
 void FixedStepIntegrator::resetB(IntegratorMemory* mem) const {
@@ -2480,8 +2611,9 @@ Integrator::Integrator(DeserializingStream & s) : OracleFunction(s) {
 void FixedStepIntegrator::serialize_body(SerializingStream &s) const {
   Integrator::serialize_body(s);
 
-  s.version("FixedStepIntegrator", 3);
+  s.version("FixedStepIntegrator", 4);
   s.pack("FixedStepIntegrator::nk_target", nk_target_);
+  s.pack("FixedStepIntegrator::dense_output", dense_output_);
   s.pack("FixedStepIntegrator::disc", disc_);
   s.pack("FixedStepIntegrator::nv", nv_);
   s.pack("FixedStepIntegrator::nv1", nv1_);
@@ -2490,8 +2622,13 @@ void FixedStepIntegrator::serialize_body(SerializingStream &s) const {
 }
 
 FixedStepIntegrator::FixedStepIntegrator(DeserializingStream & s) : Integrator(s) {
-  s.version("FixedStepIntegrator", 3);
+  int version = s.version("FixedStepIntegrator", 3, 4);
   s.unpack("FixedStepIntegrator::nk_target", nk_target_);
+  if (version >= 4) {
+    s.unpack("FixedStepIntegrator::dense_output", dense_output_);
+  } else {
+    dense_output_ = false;
+  }
   s.unpack("FixedStepIntegrator::disc", disc_);
   s.unpack("FixedStepIntegrator::nv", nv_);
   s.unpack("FixedStepIntegrator::nv1", nv1_);
@@ -524,6 +524,38 @@ enum StepOut {
   STEP_NUM_OUT
 };
 
+/// Input arguments of a dense output function
+enum DenseIn {
+  /// Time at the beginning of the step
+  DENSE_T,
+  /// Step size
+  DENSE_H,
+  /// State vector at the beginning of the step
+  DENSE_X0,
+  /// Dependent variables of the step
+  DENSE_V,
+  /// Parameter
+  DENSE_P,
+  /// Controls
+  DENSE_U,
+  /// Normalized time within the step, between 0 and 1
+  DENSE_THETA,
+  /// Number of arguments
+  DENSE_NUM_IN
+};
+
+/// Output arguments of a dense output function
+enum DenseOut {
+  /// Interpolated state vector
+  DENSE_X,
+  /// Interpolated algebraic variables
+  DENSE_Z,
+  /// Quadrature state contribution since the beginning of the step
+  DENSE_Q,
+  /// Number of arguments
+  DENSE_NUM_OUT
+};
+
 /// Input arguments of a backward stepping function
 enum BStepIn {
   BSTEP_T,
@@ -561,6 +593,15 @@ struct CASADI_EXPORT FixedStepMemory : public IntegratorMemory {
 
   /// State and dependent variables at all times
   double *x_tape, *v_tape;
+
+  /// Dense output: state and quadratures at the end of the current finite element
+  double *x_elem, *q_elem;
+
+  /// Dense output: state and quadratures at the beginning of the current finite element
+  double *x_elem_prev, *q_elem_prev;
+
+  /// Dense output: time at the beginning and end of the current finite element
+  double t_elem_start, t_elem_end;
 };
 
 class CASADI_EXPORT FixedStepIntegrator : public Integrator {
@@ -621,6 +662,9 @@ class CASADI_EXPORT FixedStepIntegrator : public Integrator {
       \identifier{25j} */
   int advance_noevent(IntegratorMemory* mem) const override;
 
+  /// Advance solution in time, interpolating within the finite elements
+  int advance_dense(FixedStepMemory* m) const;
+
   /// Reset the backward problem and take time to tf
   void resetB(IntegratorMemory* mem) const override;
 
@@ -644,9 +688,16 @@ class CASADI_EXPORT FixedStepIntegrator : public Integrator {
     const double* adj_xf, const double* rv0,
     double* adj_x0, double* adj_p, double* adj_u) const;
 
+  /// Interpolate within an integrator step
+  void denseF(FixedStepMemory* m, double t, double h, double theta,
+    const double* x0, const double* v, double* x, double* z, double* q) const;
+
   // Target number of finite elements
   casadi_int nk_target_;
 
+  // Obtain outputs by interpolation rather than by stopping at each output time
+  bool dense_output_;
+
   // Number of steps per control interval
   std::vector<casadi_int> disc_;
 
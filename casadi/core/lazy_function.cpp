@@ -0,0 +1,418 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "lazy_function.hpp"
+#include "serializing_stream.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <streambuf>
+
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace casadi {
+
+  const char FunctionArchive::magic[8] = {'C', 'S', 'D', 'L', 'A', 'Z', 'Y', '1'};
+
+  // Read-only stream over mapped bytes, without copying
+  class ArchiveBuffer : public std::streambuf {
+  public:
+    ArchiveBuffer(const char* data, size_t size) {
+      char* p = const_cast<char*>(data);
+      setg(p, p, p + size);
+    }
+  };
+
+  FunctionArchive::FunctionArchive(const std::string& fname) : data_(nullptr), size_(0) {
+#ifdef _WIN32
+    std::ifstream in(fname, std::ios::binary);
+    casadi_assert(in.good(), "Could not open archive '" + fname + "'.");
+    buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else // _WIN32
+    int fd = open(fname.c_str(), O_RDONLY);
+    casadi_assert(fd>=0, "Could not open archive '" + fname + "'.");
+    struct stat st;
+    if (fstat(fd, &st)) {
+      close(fd);
+      casadi_error("Could not stat archive '" + fname + "'.");
+    }
+    size_ = st.st_size;
+    void* p = size_ ? mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    // The mapping stays valid after closing the descriptor
+    close(fd);
+    casadi_assert(p!=MAP_FAILED, "Could not map archive '" + fname + "'.");
+    data_ = static_cast<const char*>(p);
+#endif // _WIN32
+
+    // Header
+    casadi_assert(size_>=16 && std::memcmp(data_, magic, 8)==0,
+      "'" + fname + "' is not a Function archive.");
+    uint64_t toc_offset;
+    std::memcpy(&toc_offset, data_ + 8, 8);
+    casadi_assert(toc_offset>=16 && toc_offset<size_, "Corrupt archive '" + fname + "'.");
+
+    // Table of contents
+    ArchiveBuffer buf(data_ + toc_offset, size_ - toc_offset);
+    std::istream in(&buf);
+    DeserializingStream s(in);
+    s.version("FunctionArchive", 1);
+    casadi_int n;
+    s.unpack("FunctionArchive::n_entry", n);
+    toc_.resize(n);
+    for (Entry& e : toc_) {
+      casadi_int offset, length;
+      s.unpack("FunctionArchive::offset", offset);
+      s.unpack("FunctionArchive::length", length);
+      e.offset = offset;
+      e.length = length;
+      casadi_assert(e.offset + e.length <= toc_offset, "Corrupt archive '" + fname + "'.");
+      s.unpack("FunctionArchive::name", e.name);
+      s.unpack("FunctionArchive::name_in", e.name_in);
+      s.unpack("FunctionArchive::name_out", e.name_out);
+      s.unpack("FunctionArchive::sparsity_in", e.sparsity_in);
+      s.unpack("FunctionArchive::sparsity_out", e.sparsity_out);
+      s.unpack("FunctionArchive::default_in", e.default_in);
+      s.unpack("FunctionArchive::sz_arg", e.sz_arg);
+      s.unpack("FunctionArchive::sz_res", e.sz_res);
+      s.unpack("FunctionArchive::sz_iw", e.sz_iw);
+      s.unpack("FunctionArchive::sz_w", e.sz_w);
+      s.unpack("FunctionArchive::has_forward", e.has_forward);
+      s.unpack("FunctionArchive::has_reverse", e.has_reverse);
+      s.unpack("FunctionArchive::has_jacobian", e.has_jacobian);
+      s.unpack("FunctionArchive::has_codegen", e.has_codegen);
+    }
+    proxy_.resize(n);
+  }
+
+  FunctionArchive::~FunctionArchive() {
+#ifndef _WIN32
+    if (data_) munmap(const_cast<char*>(data_), size_);
+#endif // _WIN32
+  }
+
+  bool FunctionArchive::is_archive(const std::string& fname) {
+    std::ifstream in(fname, std::ios::binary);
+    char head[8];
+    if (!in.read(head, 8)) return false;
+    return std::memcmp(head, magic, 8)==0;
+  }
+
+  void FunctionArchive::save(const Function& f, const std::string& fname, const Dict& opts) {
+    casadi_assert(!f.is_null(), "Cannot archive a null Function.");
+    // Entries are written in bulk mode unless requested otherwise
+    Dict stream_opts = {{"bulk", true}};
+    for (auto&& op : opts) stream_opts[op.first] = op.second;
+
+    std::ofstream out(fname, std::ios::binary);
+    casadi_assert(out.good(), "Could not open '" + fname + "' for writing.");
+
+    // Header, the table of contents offset is filled in at the end
+    uint64_t toc_offset = 0;
+    out.write(magic, 8);
+    out.write(reinterpret_cast<const char*>(&toc_offset), 8);
+
+    // Functions to be written, in order of discovery, starting with the root
+    std::vector<Function> entries = {f};
+    std::unordered_map<void*, casadi_int> index = {{f.get(), 0}};
+    auto archiver = [&](const Function& g) {
+      auto it = index.find(g.get());
+      if (it!=index.end()) return it->second;
+      casadi_int k = entries.size();
+      index[g.get()] = k;
+      entries.push_back(g);
+      return k;
+    };
+
+    // Each entry is an independent stream, nested Functions are queued by the archiver
+    std::vector<casadi_int> offset, length;
+    for (size_t k=0; k<entries.size(); ++k) {
+      Function g = entries[k];
+      offset.push_back(static_cast<casadi_int>(out.tellp()));
+      SerializingStream s(out, stream_opts);
+      s.set_archiver(archiver);
+      g.serialize(s);
+      length.push_back(static_cast<casadi_int>(out.tellp()) - offset.back());
+    }
+
+    // Table of contents
+    toc_offset = static_cast<uint64_t>(out.tellp());
+    SerializingStream s(out, stream_opts);
+    s.version("FunctionArchive", 1);
+    s.pack("FunctionArchive::n_entry", static_cast<casadi_int>(entries.size()));
+    for (size_t k=0; k<entries.size(); ++k) {
+      const Function& g = entries[k];
+      s.pack("FunctionArchive::offset", offset[k]);
+      s.pack("FunctionArchive::length", length[k]);
+      s.pack("FunctionArchive::name", g.name());
+      s.pack("FunctionArchive::name_in", g.name_in());
+      s.pack("FunctionArchive::name_out", g.name_out());
+      std::vector<Sparsity> sp_in, sp_out;
+      for (casadi_int i=0; i<g.n_in(); ++i) sp_in.push_back(g.sparsity_in(i));
+      for (casadi_int i=0; i<g.n_out(); ++i) sp_out.push_back(g.sparsity_out(i));
+      s.pack("FunctionArchive::sparsity_in", sp_in);
+      s.pack("FunctionArchive::sparsity_out", sp_out);
+      std::vector<double> default_in;
+      for (casadi_int i=0; i<g.n_in(); ++i) default_in.push_back(g.default_in(i));
+      s.pack("FunctionArchive::default_in", default_in);
+      s.pack("FunctionArchive::sz_arg", static_cast<casadi_int>(g.sz_arg()));
+      s.pack("FunctionArchive::sz_res", static_cast<casadi_int>(g.sz_res()));
+      s.pack("FunctionArchive::sz_iw", static_cast<casadi_int>(g.sz_iw()));
+      s.pack("FunctionArchive::sz_w", static_cast<casadi_int>(g.sz_w()));
+      // Derivative and codegen support, queried when the proxy is constructed
+      s.pack("FunctionArchive::has_forward", g->has_forward(1));
+      s.pack("FunctionArchive::has_reverse", g->has_reverse(1));
+      s.pack("FunctionArchive::has_jacobian", g->has_jacobian());
+      s.pack("FunctionArchive::has_codegen", g->has_codegen());
+    }
+
+    // Fill in the offset
+    out.seekp(8);
+    out.write(reinterpret_cast<const char*>(&toc_offset), 8);
+    casadi_assert(out.good(), "Failed to write '" + fname + "'.");
+  }
+
+  Function FunctionArchive::load(const std::string& fname, const Dict& opts) {
+    // Default options
+    bool preload = false;
+#ifdef CASADI_WITH_THREAD
+    casadi_int max_num_threads = std::max(1u, std::thread::hardware_concurrency());
+#else // CASADI_WITH_THREAD
+    casadi_int max_num_threads = 1;
+#endif // CASADI_WITH_THREAD
+
+    // Read options
+    for (auto&& op : opts) {
+      if (op.first=="preload") {
+        preload = op.second;
+      } else if (op.first=="max_num_threads") {
+        max_num_threads = op.second;
+      } else {
+        casadi_error("Unknown option: '" + op.first + "'.");
+      }
+    }
+    casadi_assert(max_num_threads >= 1, "'max_num_threads' must be positive");
+#ifndef CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Deserialization creates symbolic expressions
+    if (preload && max_num_threads > 1) {
+      casadi_warning("CasADi was not compiled with WITH_THREADSAFE_SYMBOLICS=ON. "
+                     "Falling back to serial deserialization.");
+      max_num_threads = 1;
+    }
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+
+    auto archive = std::make_shared<FunctionArchive>(fname);
+    if (preload) return archive->preload(max_num_threads);
+    // The root is deserialized right away, nested Functions keep the archive alive
+    return archive->deserialize(0);
+  }
+
+  Function FunctionArchive::preload(casadi_int max_num_threads) {
+    casadi_int n = toc_.size();
+    // Proxies are kept alive until the Functions referring to them are deserialized
+    std::vector<Function> proxies(n);
+    for (casadi_int k=1; k<n; ++k) proxies[k] = proxy(k);
+
+    // Entries are distributed dynamically over the threads
+    Function root;
+    std::atomic<casadi_int> next(0);
+    casadi_int n_thread = std::min(max_num_threads, n);
+    std::vector<std::exception_ptr> ex(n_thread);
+    auto worker = [&](casadi_int t) {
+      try {
+        for (casadi_int k=next++; k<n; k=next++) {
+          if (k==0) {
+            root = deserialize(0);
+          } else {
+            static_cast<const LazyFunction*>(proxies[k].get())->loaded();
+          }
+        }
+      } catch (...) {
+        ex[t] = std::current_exception();
+      }
+    };
+
+#ifdef CASADI_WITH_THREAD
+    std::vector<std::thread> threads;
+    threads.reserve(n_thread-1);
+    for (casadi_int t=1; t<n_thread; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto&& th : threads) th.join();
+#else // CASADI_WITH_THREAD
+    worker(0);
+#endif // CASADI_WITH_THREAD
+
+    // Propagate errors
+    for (auto&& e : ex) {
+      if (e) std::rethrow_exception(e);
+    }
+    return root;
+  }
+
+  Function FunctionArchive::deserialize(casadi_int k) {
+    const Entry& e = entry(k);
+    ArchiveBuffer buf(data_ + e.offset, e.length);
+    std::istream in(&buf);
+    DeserializingStream s(in);
+    std::shared_ptr<FunctionArchive> self = shared_from_this();
+    s.set_unarchiver([self](casadi_int j) { return self->proxy(j);});
+    return Function::deserialize(s);
+  }
+
+  Function FunctionArchive::proxy(casadi_int k) {
+    casadi_assert(k>=0 && k<static_cast<casadi_int>(toc_.size()),
+      "Archive entry " + str(k) + " out of range.");
+    // Share the proxy as long as it is alive, like a shared Function in an eager load
+    {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+      std::lock_guard<std::mutex> lock(mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+      SharedObject temp;
+      if (proxy_[k].shared_if_alive(temp)) return shared_cast<Function>(temp);
+    }
+    Function ret = Function::create(new LazyFunction(shared_from_this(), k), Dict());
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    std::lock_guard<std::mutex> lock(mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Another thread may have been first
+    SharedObject temp;
+    if (proxy_[k].shared_if_alive(temp)) return shared_cast<Function>(temp);
+    proxy_[k] = ret;
+    return ret;
+  }
+
+  LazyFunction::LazyFunction(const std::shared_ptr<FunctionArchive>& archive, casadi_int k)
+    : FunctionInternal(archive->entry(k).name), archive_(archive), k_(k) {
+  }
+
+  LazyFunction::~LazyFunction() {
+    clear_mem();
+  }
+
+  void LazyFunction::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    // Work vectors of the deserialized Function, from the table of contents
+    alloc_arg(entry().sz_arg);
+    alloc_res(entry().sz_res);
+    alloc_iw(entry().sz_iw);
+    alloc_w(entry().sz_w);
+  }
+
+  const Function& LazyFunction::loaded() const {
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    std::lock_guard<std::mutex> lock(mtx_);
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+    if (f_.is_null()) {
+      if (verbose_) casadi_message("Loading '" + name_ + "' from archive");
+      f_ = archive_->deserialize(k_);
+    }
+    return f_;
+  }
+
+  bool LazyFunction::is_a(const std::string& type, bool recursive) const {
+    return type=="LazyFunction"
+      || (recursive && FunctionInternal::is_a(type, recursive));
+  }
+
+  Function LazyFunction::unwrap(const Function& f) {
+    if (!f.is_a("LazyFunction")) return f;
+    return f.get<LazyFunction>()->loaded();
+  }
+
+  int LazyFunction::eval(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    return loaded()(arg, res, iw, w);
+  }
+
+  int LazyFunction::eval_sx(const SXElem** arg, SXElem** res, casadi_int* iw, SXElem* w,
+      void* mem, bool always_inline, bool never_inline) const {
+    return loaded()(arg, res, iw, w, 0);
+  }
+
+  int LazyFunction::sp_forward(const bvec_t** arg, bvec_t** res,
+      casadi_int* iw, bvec_t* w, void* mem) const {
+    return loaded()(arg, res, iw, w, 0);
+  }
+
+  int LazyFunction::sp_reverse(bvec_t** arg, bvec_t** res,
+      casadi_int* iw, bvec_t* w, void* mem) const {
+    return loaded().rev(arg, res, iw, w, 0);
+  }
+
+  Function LazyFunction::get_forward(casadi_int nfwd, const std::string& name,
+      const std::vector<std::string>& inames,
+      const std::vector<std::string>& onames,
+      const Dict& opts) const {
+    return loaded()->get_forward(nfwd, name, inames, onames, opts);
+  }
+
+  Function LazyFunction::get_reverse(casadi_int nadj, const std::string& name,
+      const std::vector<std::string>& inames,
+      const std::vector<std::string>& onames,
+      const Dict& opts) const {
+    return loaded()->get_reverse(nadj, name, inames, onames, opts);
+  }
+
+  Function LazyFunction::get_jacobian(const std::string& name,
+      const std::vector<std::string>& inames,
+      const std::vector<std::string>& onames,
+      const Dict& opts) const {
+    return loaded()->get_jacobian(name, inames, onames, opts);
+  }
+
+  void LazyFunction::codegen_declarations(CodeGenerator& g) const {
+    g.add_dependency(loaded());
+  }
+
+  void LazyFunction::codegen_body(CodeGenerator& g) const {
+    g << "if (" << g(loaded(), "arg", "res", "iw", "w") << ") return 1;\n";
+  }
+
+  void LazyFunction::serialize_type(SerializingStream &s) const {
+    loaded()->serialize_type(s);
+  }
+
+  void LazyFunction::serialize_body(SerializingStream &s) const {
+    loaded()->serialize_body(s);
+  }
+
+} // namespace casadi
@@ -0,0 +1,269 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_LAZY_FUNCTION_HPP
+#define CASADI_LAZY_FUNCTION_HPP
+
+#include "function_internal.hpp"
+
+#include <memory>
+
+/// \cond INTERNAL
+
+namespace casadi {
+
+  /** \brief Indexed, memory-mapped Function archive
+
+      Layout: an 8 byte magic, the 8 byte offset of the table of contents, one
+      independently deserializable stream per Function and finally the table of contents.
+      Nested Functions are written once, as entries of their own, and referred to by index.
+      The table of contents holds the signature and work vector sizes of every entry, so
+      that a nested Function can be represented by a LazyFunction until it is first used.
+
+      The file is mapped read-only, so the pages are shared between processes that load
+      the same archive.
+
+      \identifier{2ej} */
+  class CASADI_EXPORT FunctionArchive
+    : public std::enable_shared_from_this<FunctionArchive> {
+  public:
+    /// Table of contents entry
+    struct Entry {
+      size_t offset, length;
+      std::string name;
+      std::vector<std::string> name_in, name_out;
+      std::vector<Sparsity> sparsity_in, sparsity_out;
+      std::vector<double> default_in;
+      casadi_int sz_arg, sz_res, sz_iw, sz_w;
+      bool has_forward, has_reverse, has_jacobian, has_codegen;
+    };
+
+    /// Map a file
+    explicit FunctionArchive(const std::string& fname);
+
+    /// Unmap
+    ~FunctionArchive();
+
+    /// Write an archive
+    static void save(const Function& f, const std::string& fname, const Dict& opts);
+
+    /// Load the root Function of an archive, nested Functions are deserialized on first use
+    static Function load(const std::string& fname, const Dict& opts=Dict());
+
+    /// Is the file an archive?
+    static bool is_archive(const std::string& fname);
+
+    /// Table of contents entry
+    const Entry& entry(casadi_int k) const { return toc_.at(k);}
+
+    /// Deserialize an entry
+    Function deserialize(casadi_int k);
+
+    /// Get the (shared) proxy for an entry
+    Function proxy(casadi_int k);
+
+    /** \brief Deserialize all entries concurrently, returns the root
+
+        Entries are independent streams, references between them go through
+        proxies, so they can be deserialized in any order
+
+        \identifier{2ez} */
+    Function preload(casadi_int max_num_threads);
+
+    /// Magic bytes
+    static const char magic[8];
+
+  private:
+    // Mapped bytes
+    const char* data_;
+    size_t size_;
+    // Read into memory where mapping is not available
+    std::vector<char> buffer_;
+    // Table of contents
+    std::vector<Entry> toc_;
+    // Proxies handed out so far
+    std::vector<WeakRef> proxy_;
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Protect proxy_
+    std::mutex mtx_;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+  };
+
+  /** \brief Function deserialized from an archive on first use
+
+      \identifier{2ek} */
+  class CASADI_EXPORT LazyFunction : public FunctionInternal {
+  public:
+    /// Constructor
+    LazyFunction(const std::shared_ptr<FunctionArchive>& archive, casadi_int k);
+
+    /** \brief Destructor
+
+        \identifier{2el} */
+    ~LazyFunction() override;
+
+    /** \brief Get type name
+
+        \identifier{2em} */
+    std::string class_name() const override {return "LazyFunction";}
+
+    /** \brief Check if the function is of a particular type
+
+        Refers to the proxy, use unwrap to inspect the deserialized Function
+
+        \identifier{2en} */
+    bool is_a(const std::string& type, bool recursive) const override;
+
+    /** \brief Deserialized Function behind a proxy, or the Function itself
+
+        \identifier{2fc} */
+    static Function unwrap(const Function& f);
+
+    /// Initialize
+    void init(const Dict& opts) override;
+
+    /// Deserialized Function, loaded on first call
+    const Function& loaded() const;
+
+    /// Has the Function been deserialized?
+    bool is_loaded() const { return !f_.is_null();}
+
+    ///@{
+    /** \brief Number of function inputs and outputs
+
+        \identifier{2eo} */
+    size_t get_n_in() override { return entry().name_in.size();}
+    size_t get_n_out() override { return entry().name_out.size();}
+    ///@}
+
+    /// @{
+    /** \brief Sparsities of function inputs and outputs
+
+        \identifier{2ep} */
+    Sparsity get_sparsity_in(casadi_int i) override { return entry().sparsity_in.at(i);}
+    Sparsity get_sparsity_out(casadi_int i) override { return entry().sparsity_out.at(i);}
+    /// @}
+
+    ///@{
+    /** \brief Names of function input and outputs
+
+        \identifier{2eq} */
+    std::string get_name_in(casadi_int i) override { return entry().name_in.at(i);}
+    std::string get_name_out(casadi_int i) override { return entry().name_out.at(i);}
+    /// @}
+
+    /** \brief Get default input value
+
+        \identifier{2er} */
+    double get_default_in(casadi_int ind) const override { return entry().default_in.at(ind);}
+
+    /// Evaluate numerically
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+    /// Evaluate with symbolic scalars
+    int eval_sx(const SXElem** arg, SXElem** res, casadi_int* iw, SXElem* w, void* mem,
+      bool always_inline, bool never_inline) const override;
+
+    ///@{
+    /** \brief Propagate sparsity
+
+        \identifier{2es} */
+    bool has_spfwd() const override { return true;}
+    bool has_sprev() const override { return true;}
+    int sp_forward(const bvec_t** arg, bvec_t** res,
+      casadi_int* iw, bvec_t* w, void* mem) const override;
+    int sp_reverse(bvec_t** arg, bvec_t** res,
+      casadi_int* iw, bvec_t* w, void* mem) const override;
+    ///@}
+
+    ///@{
+    /** \brief Derivatives, generated by the deserialized Function
+
+        \identifier{2et} */
+    bool has_forward(casadi_int nfwd) const override { return entry().has_forward;}
+    Function get_forward(casadi_int nfwd, const std::string& name,
+                         const std::vector<std::string>& inames,
+                         const std::vector<std::string>& onames,
+                         const Dict& opts) const override;
+    bool has_reverse(casadi_int nadj) const override { return entry().has_reverse;}
+    Function get_reverse(casadi_int nadj, const std::string& name,
+                         const std::vector<std::string>& inames,
+                         const std::vector<std::string>& onames,
+                         const Dict& opts) const override;
+    bool has_jacobian() const override { return entry().has_jacobian;}
+    Function get_jacobian(const std::string& name,
+                          const std::vector<std::string>& inames,
+                          const std::vector<std::string>& onames,
+                          const Dict& opts) const override;
+    ///@}
+
+    /** \brief Is codegen supported?
+
+        \identifier{2eu} */
+    bool has_codegen() const override { return entry().has_codegen;}
+
+    /** \brief Generate code for the declarations of the C function
+
+        \identifier{2ev} */
+    void codegen_declarations(CodeGenerator& g) const override;
+
+    /** \brief Generate code for the body of the C function
+
+        \identifier{2ew} */
+    void codegen_body(CodeGenerator& g) const override;
+
+    /** \brief Serialize the deserialized Function, the proxy is not visible in the stream
+
+        \identifier{2ex} */
+    void serialize_type(SerializingStream &s) const override;
+
+    /** \brief Serialize an object without type information
+
+        \identifier{2ey} */
+    void serialize_body(SerializingStream &s) const override;
+
+  protected:
+    // Table of contents entry
+    const FunctionArchive::Entry& entry() const { return archive_->entry(k_);}
+
+    // Archive
+    std::shared_ptr<FunctionArchive> archive_;
+
+    // Entry index
+    casadi_int k_;
+
+    // Deserialized Function
+    mutable Function f_;
+
+#ifdef CASADI_WITH_THREADSAFE_SYMBOLICS
+    // Protect f_
+    mutable std::mutex mtx_;
+#endif // CASADI_WITH_THREADSAFE_SYMBOLICS
+  };
+
+} // namespace casadi
+/// \endcond
+
+#endif // CASADI_LAZY_FUNCTION_HPP
@@ -0,0 +1,352 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "multistart.hpp"
+#include "nlpsol_impl.hpp"
+#include "lazy_function.hpp"
+#include "serializing_stream.hpp"
+
+#include <atomic>
+
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#include <mingw.mutex.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#include <mutex>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
+
+namespace casadi {
+
+  Function nlpsol_multistart(const std::string& name, const Function& solver,
+                             casadi_int n_start, const Dict& opts) {
+    return Function::create(new Multistart(name, solver, n_start), opts);
+  }
+
+  Multistart::Multistart(const std::string& name, const Function& solver, casadi_int n_start)
+    : FunctionInternal(name), solver_(LazyFunction::unwrap(solver)), n_start_(n_start) {
+    casadi_assert(solver_.is_a("Nlpsol", true),
+      "Multistart requires an NLP solver instance, got '" + solver_.class_name() + "'");
+    casadi_assert(n_start >= 1, "Number of starts must be positive, got " + str(n_start));
+  }
+
+  Multistart::~Multistart() {
+    clear_mem();
+  }
+
+  bool Multistart::is_a(const std::string& type, bool recursive) const {
+    return type=="Multistart"
+      || (recursive && FunctionInternal::is_a(type, recursive));
+  }
+
+  const Options Multistart::options_
+  = {{&FunctionInternal::options_},
+     {{"max_num_threads",
+       {OT_INT,
+        "Maximum number of concurrent solves [default: number of hardware threads]"}},
+      {"abort_dominated",
+       {OT_BOOL,
+        "Abort a run as soon as it reaches a feasible iterate whose objective exceeds the "
+        "best converged objective of the other runs (the incumbent) by more than "
+        "dominance_margin. Requires support for iteration callbacks in the solver [false]"}},
+      {"dominance_margin",
+       {OT_DOUBLE,
+        "Relative objective margin for abort_dominated [default: 0.1]"}},
+      {"dominance_tol",
+       {OT_DOUBLE,
+        "Primal infeasibility below which an iterate counts as feasible for "
+        "abort_dominated [default: 1e-6]"}}
+     }
+  };
+
+  void Multistart::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    // Default options
+#ifdef CASADI_WITH_THREAD
+    max_num_threads_ = std::max(1u, std::thread::hardware_concurrency());
+#else // CASADI_WITH_THREAD
+    max_num_threads_ = 1;
+#endif // CASADI_WITH_THREAD
+    abort_dominated_ = false;
+    dominance_margin_ = 0.1;
+    dominance_tol_ = 1e-6;
+
+    // Read options
+    for (auto&& op : opts) {
+      if (op.first=="max_num_threads") {
+        max_num_threads_ = op.second;
+      } else if (op.first=="abort_dominated") {
+        abort_dominated_ = op.second;
+      } else if (op.first=="dominance_margin") {
+        dominance_margin_ = op.second;
+      } else if (op.first=="dominance_tol") {
+        dominance_tol_ = op.second;
+      }
+    }
+    casadi_assert(max_num_threads_ >= 1, "'max_num_threads' must be positive");
+#ifndef CASADI_WITH_THREAD
+    if (max_num_threads_ > 1) {
+      casadi_warning("CasADi was not compiled with WITH_THREAD=ON. "
+                     "Falling back to serial evaluation.");
+      max_num_threads_ = 1;
+    }
+#endif // CASADI_WITH_THREAD
+
+    // Work vectors for each thread, solution buffers for each thread and the best start
+    casadi_int n_thread = std::min(max_num_threads_, n_start_);
+    size_t sz_sol = 0;
+    for (casadi_int i=0; i<n_out_; ++i) sz_sol += nnz_out(i);
+    alloc_arg(solver_.sz_arg() * n_thread);
+    alloc_res(solver_.sz_res() * n_thread);
+    alloc_iw(solver_.sz_iw() * n_thread);
+    alloc_w(sz_sol + (solver_.sz_w() + sz_sol) * n_thread);
+  }
+
+  std::vector<std::string> Multistart::get_function() const {
+    return {"solver"};
+  }
+
+  const Function& Multistart::get_function(const std::string &name) const {
+    casadi_assert(has_function(name),
+      "No function \"" + name + "\" in " + name_ + ". " +
+      "Available functions: " + join(get_function()) + ".");
+    return solver_;
+  }
+
+  bool Multistart::has_function(const std::string& fname) const {
+    return fname=="solver";
+  }
+
+  Sparsity Multistart::get_sparsity_in(casadi_int i) {
+    // One column per start for the initial guess
+    if (i==NLPSOL_X0) return repmat(solver_.sparsity_in(i), 1, n_start_);
+    return solver_.sparsity_in(i);
+  }
+
+  int Multistart::init_mem(void* mem) const {
+    if (FunctionInternal::init_mem(mem)) return 1;
+    auto m = static_cast<MultistartMemory*>(mem);
+    m->f.resize(n_start_);
+    m->pr_inf.resize(n_start_);
+    m->iter_count.resize(n_start_);
+    m->return_status.resize(n_start_);
+    m->success.resize(n_start_);
+    m->aborted.resize(n_start_);
+    m->best = -1;
+    return 0;
+  }
+
+  double Multistart::primal_infeasibility(const double** arg, const double* x,
+                                          const double* g) const {
+    // Missing bounds are infinite, cf. nlpsol_default_in
+    double r = 0;
+    casadi_int nx = solver_.nnz_out(NLPSOL_X), ng = solver_.nnz_out(NLPSOL_G);
+    for (casadi_int i=0; i<nx; ++i) {
+      if (arg[NLPSOL_LBX]) r = std::fmax(r, arg[NLPSOL_LBX][i] - x[i]);
+      if (arg[NLPSOL_UBX]) r = std::fmax(r, x[i] - arg[NLPSOL_UBX][i]);
+    }
+    for (casadi_int i=0; i<ng; ++i) {
+      if (arg[NLPSOL_LBG]) r = std::fmax(r, arg[NLPSOL_LBG][i] - g[i]);
+      if (arg[NLPSOL_UBG]) r = std::fmax(r, g[i] - arg[NLPSOL_UBG][i]);
+    }
+    return r;
+  }
+
+  int Multistart::eval(const double** arg, double** res, casadi_int* iw, double* w,
+                       void* mem) const {
+    auto m = static_cast<MultistartMemory*>(mem);
+    setup(mem, arg, res, iw, w);
+
+    // Offsets of the outputs in a solution buffer
+    std::vector<casadi_int> offset(n_out_ + 1, 0);
+    for (casadi_int i=0; i<n_out_; ++i) offset[i+1] = offset[i] + nnz_out(i);
+    casadi_int nx0 = solver_.nnz_in(NLPSOL_X0);
+
+    // Shared state: best solution so far and incumbent (best converged) objective
+    double* best_sol = w;
+    w += offset.back();
+    m->best = -1;
+    double incumbent = inf;
+#ifdef CASADI_WITH_THREAD
+    std::mutex mtx;
+#endif // CASADI_WITH_THREAD
+
+    // Is start k better than the best start so far?
+    auto better = [&](casadi_int k) {
+      if (m->best < 0) return true;
+      casadi_int b = m->best;
+      if (m->success[k] != m->success[b]) return static_cast<bool>(m->success[k]);
+      if (!m->success[k] && m->pr_inf[k] != m->pr_inf[b]) return m->pr_inf[k] < m->pr_inf[b];
+      return m->f[k] < m->f[b];
+    };
+
+    // Starts are distributed dynamically over the threads
+    std::atomic<casadi_int> next(0);
+    casadi_int n_thread = std::min(max_num_threads_, n_start_);
+    std::vector<std::exception_ptr> ex(n_thread);
+
+    auto worker = [&](casadi_int t) {
+      try {
+        // Solver instance and work vectors local to the thread
+        scoped_checkout<Function> smem(solver_);
+        auto sm = static_cast<NlpsolMemory*>(solver_.memory(smem));
+        const double** arg1 = arg + n_in_ + t * solver_.sz_arg();
+        double** res1 = res + n_out_ + t * solver_.sz_res();
+        casadi_int* iw1 = iw + t * solver_.sz_iw();
+        double* w1 = w + t * (solver_.sz_w() + offset.back());
+        double* sol = w1 + solver_.sz_w();
+        bool aborted = false;
+
+        // Remove the callback before the memory is released, also on errors
+        struct StopCheckGuard {
+          NlpsolMemory* sm;
+          ~StopCheckGuard() { sm->stop_check = nullptr;}
+        } stop_check_guard{sm};
+
+        // Abort runs that cannot improve on the incumbent
+        if (abort_dominated_) {
+          sm->stop_check = [&](double f, double pr_inf) {
+            if (!(pr_inf <= dominance_tol_)) return false;
+#ifdef CASADI_WITH_THREAD
+            std::lock_guard<std::mutex> lock(mtx);
+#endif // CASADI_WITH_THREAD
+            aborted = f > incumbent + dominance_margin_ * std::fmax(1., std::fabs(incumbent));
+            return aborted;
+          };
+        }
+
+        for (casadi_int k; (k = next++) < n_start_; ) {
+          // Same problem data, initial guess from column k
+          std::copy_n(arg, n_in_, arg1);
+          arg1[NLPSOL_X0] = arg[NLPSOL_X0] ? arg[NLPSOL_X0] + k * nx0 : nullptr;
+          for (casadi_int i=0; i<n_out_; ++i) res1[i] = sol + offset[i];
+          aborted = false;
+
+          // Solve
+          try {
+            solver_(arg1, res1, iw1, w1, smem);
+            Dict stats = solver_.stats(smem);
+            m->success[k] = sm->success;
+            auto it = stats.find("iter_count");
+            m->iter_count[k] = it==stats.end() ? sm->n_iter : it->second.to_int();
+            it = stats.find("return_status");
+            m->return_status[k] = it==stats.end() ? stats.at("unified_return_status").to_string()
+              : it->second.to_string();
+          } catch (std::exception& e) {
+            casadi_warning("Start " + str(k) + " raised an exception: " + std::string(e.what()));
+            casadi_fill(sol, offset.back(), nan);
+            m->success[k] = false;
+            m->iter_count[k] = -1;
+            m->return_status[k] = "Exception";
+          }
+          m->aborted[k] = aborted;
+          m->f[k] = sol[offset[NLPSOL_F]];
+          m->pr_inf[k] = primal_infeasibility(arg, sol + offset[NLPSOL_X],
+            sol + offset[NLPSOL_G]);
+          if (m->pr_inf[k] != m->pr_inf[k]) m->pr_inf[k] = inf;
+
+          // Update incumbent and best solution
+#ifdef CASADI_WITH_THREAD
+          std::lock_guard<std::mutex> lock(mtx);
+#endif // CASADI_WITH_THREAD
+          if (m->success[k]) incumbent = std::fmin(incumbent, m->f[k]);
+          if (better(k)) {
+            m->best = k;
+            casadi_copy(sol, offset.back(), best_sol);
+          }
+        }
+      } catch (...) {
+        ex[t] = std::current_exception();
+      }
+    };
+
+#ifdef CASADI_WITH_THREAD
+    std::vector<std::thread> threads;
+    threads.reserve(n_thread-1);
+    for (casadi_int t=1; t<n_thread; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto&& th : threads) th.join();
+#else // CASADI_WITH_THREAD
+    worker(0);
+#endif // CASADI_WITH_THREAD
+
+    // Propagate errors
+    for (auto&& e : ex) {
+      if (e) std::rethrow_exception(e);
+    }
+
+    // Return the best solution
+    for (casadi_int i=0; i<n_out_; ++i) {
+      casadi_copy(best_sol + offset[i], nnz_out(i), res[i]);
+    }
+    return 0;
+  }
+
+  Dict Multistart::get_stats(void* mem) const {
+    Dict stats = FunctionInternal::get_stats(mem);
+    auto m = static_cast<MultistartMemory*>(mem);
+    std::vector<bool> success, aborted;
+    assign_vector(m->success, success);
+    assign_vector(m->aborted, aborted);
+    stats["f"] = m->f;
+    stats["pr_inf"] = m->pr_inf;
+    stats["iter_count"] = m->iter_count;
+    stats["return_status"] = m->return_status;
+    stats["success_all"] = success;
+    stats["aborted"] = aborted;
+    stats["best"] = m->best;
+    stats["success"] = m->best >= 0 && m->success[m->best];
+    casadi_int n_aborted = 0;
+    for (char a : m->aborted) n_aborted += a;
+    stats["n_aborted"] = n_aborted;
+    return stats;
+  }
+
+  void Multistart::serialize_body(SerializingStream &s) const {
+    FunctionInternal::serialize_body(s);
+    s.version("Multistart", 1);
+    s.pack("Multistart::solver", solver_);
+    s.pack("Multistart::n_start", n_start_);
+    s.pack("Multistart::max_num_threads", max_num_threads_);
+    s.pack("Multistart::abort_dominated", abort_dominated_);
+    s.pack("Multistart::dominance_margin", dominance_margin_);
+    s.pack("Multistart::dominance_tol", dominance_tol_);
+  }
+
+  Multistart::Multistart(DeserializingStream& s) : FunctionInternal(s) {
+    s.version("Multistart", 1);
+    s.unpack("Multistart::solver", solver_);
+    s.unpack("Multistart::n_start", n_start_);
+    s.unpack("Multistart::max_num_threads", max_num_threads_);
+    s.unpack("Multistart::abort_dominated", abort_dominated_);
+    s.unpack("Multistart::dominance_margin", dominance_margin_);
+    s.unpack("Multistart::dominance_tol", dominance_tol_);
+  }
+
+} // namespace casadi
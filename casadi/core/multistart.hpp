@@ -0,0 +1,178 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_MULTISTART_HPP
+#define CASADI_MULTISTART_HPP
+
+#include "function_internal.hpp"
+
+/// \cond INTERNAL
+
+namespace casadi {
+
+  /** \brief Multistart memory
+
+      \identifier{2dy} */
+  struct CASADI_EXPORT MultistartMemory : public FunctionMemory {
+    // Per start: objective, primal infeasibility, iterations, return status
+    std::vector<double> f, pr_inf;
+    std::vector<casadi_int> iter_count;
+    std::vector<std::string> return_status;
+    // Per start: success, aborted as dominated (char to allow concurrent writes)
+    std::vector<char> success, aborted;
+    // Index of the best start
+    casadi_int best;
+  };
+
+  /** Solve an NLP from multiple initial guesses concurrently */
+  class CASADI_EXPORT Multistart : public FunctionInternal {
+  public:
+    /// Constructor
+    Multistart(const std::string& name, const Function& solver, casadi_int n_start);
+
+    /** \brief Destructor
+
+        \identifier{2dz} */
+    ~Multistart() override;
+
+    /** \brief Get type name
+
+        \identifier{2e0} */
+    std::string class_name() const override {return "Multistart";}
+
+    /** \brief Check if the function is of a particular type
+
+        \identifier{2e1} */
+    bool is_a(const std::string& type, bool recursive) const override;
+
+    ///@{
+    /** \brief Options
+
+        \identifier{2e2} */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    /// Initialize
+    void init(const Dict& opts) override;
+
+    // Get list of dependency functions
+    std::vector<std::string> get_function() const override;
+
+    // Get a dependency function
+    const Function& get_function(const std::string &name) const override;
+
+    // Check if a particular dependency exists
+    bool has_function(const std::string& fname) const override;
+
+    ///@{
+    /** \brief Number of function inputs and outputs
+
+        \identifier{2e3} */
+    size_t get_n_in() override { return solver_.n_in();}
+    size_t get_n_out() override { return solver_.n_out();}
+    ///@}
+
+    /// @{
+    /** \brief Sparsities of function inputs and outputs
+
+        \identifier{2e4} */
+    Sparsity get_sparsity_in(casadi_int i) override;
+    Sparsity get_sparsity_out(casadi_int i) override { return solver_.sparsity_out(i);}
+    /// @}
+
+    ///@{
+    /** \brief Names of function input and outputs
+
+        \identifier{2e5} */
+    std::string get_name_in(casadi_int i) override { return solver_.name_in(i);}
+    std::string get_name_out(casadi_int i) override { return solver_.name_out(i);}
+    /// @}
+
+    /** \brief Get default input value
+
+        \identifier{2e6} */
+    double get_default_in(casadi_int ind) const override { return solver_.default_in(ind);}
+
+    /** \brief Create memory block
+
+        \identifier{2e7} */
+    void* alloc_mem() const override { return new MultistartMemory();}
+
+    /** \brief Initalize memory block
+
+        \identifier{2e8} */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block
+
+        \identifier{2e9} */
+    void free_mem(void *mem) const override { delete static_cast<MultistartMemory*>(mem);}
+
+    /// Evaluate numerically
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /** \brief Serialize an object without type information
+
+        \identifier{2ea} */
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation
+
+        \identifier{2eb} */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new Multistart(s); }
+
+  protected:
+    /** \brief Deserializing constructor
+
+        \identifier{2ec} */
+    explicit Multistart(DeserializingStream& s);
+
+    // Primal infeasibility of a solution
+    double primal_infeasibility(const double** arg, const double* x, const double* g) const;
+
+    // NLP solver
+    Function solver_;
+
+    // Number of starts
+    casadi_int n_start_;
+
+    // Maximum number of concurrent solves
+    casadi_int max_num_threads_;
+
+    // Abort runs that are dominated by the incumbent
+    bool abort_dominated_;
+
+    // Relative objective margin and feasibility tolerance for dominance
+    double dominance_margin_, dominance_tol_;
+  };
+
+} // namespace casadi
+/// \endcond
+
+#endif // CASADI_MULTISTART_HPP
@@ -33,6 +33,18 @@
 #include <stack>
 #include <typeinfo>
 
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#include <mingw.mutex.h>
+#include <mingw.condition_variable.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
+
 // Throw informative error message
 #define CASADI_THROW_ERROR(FNAME, WHAT) \
 throw CasadiException("Error in MXFunction::" FNAME " at " + CASADI_WHERE + ":\n"\
@@ -71,7 +83,16 @@ namespace casadi {
         "Allow construction with free variables (Default: false)"}},
       {"allow_duplicate_io_names",
        {OT_BOOL,
-        "Allow construction with duplicate io names (Default: false)"}}
+        "Allow construction with duplicate io names (Default: false)"}},
+      {"max_num_threads",
+       {OT_INT,
+        "Evaluate independent function calls concurrently using up to this many "
+        "threads (Default: 1, i.e. sequential evaluation)"}},
+      {"compact_work",
+       {OT_BOOL,
+        "Place work vector elements with a linear scan over their live ranges, "
+        "allowing reuse between elements of different sizes. "
+        "Cannot be combined with max_num_threads>1 (Default: false)"}}
      }
   };
 
@@ -80,6 +101,8 @@ namespace casadi {
     //opts["default_in"] = default_in_;
     opts["live_variables"] = live_variables_;
     opts["print_instructions"] = print_instructions_;
+    opts["max_num_threads"] = max_num_threads_;
+    opts["compact_work"] = !worknnz_.empty();
     return opts;
   }
 
@@ -115,8 +138,10 @@ namespace casadi {
     // Default (temporary) options
     live_variables_ = true;
     print_instructions_ = false;
+    max_num_threads_ = 1;
     bool cse_opt = false;
     bool allow_free = false;
+    bool compact = false;
 
     // Read options
     for (auto&& op : opts) {
@@ -130,9 +155,25 @@ namespace casadi {
         cse_opt = op.second;
       } else if (op.first=="allow_free") {
         allow_free = op.second;
+      } else if (op.first=="max_num_threads") {
+        max_num_threads_ = op.second;
+      } else if (op.first=="compact_work") {
+        compact = op.second;
       }
     }
 
+    casadi_assert(max_num_threads_>=1, "Option 'max_num_threads' must be positive");
+#ifndef CASADI_WITH_THREAD
+    if (max_num_threads_>1) {
+      casadi_warning("CasADi was not compiled with WITH_THREAD=ON. "
+                     "Falling back to sequential evaluation.");
+      max_num_threads_ = 1;
+    }
+#endif // CASADI_WITH_THREAD
+    // The compacted layout is only valid for the sequential order of evaluation
+    casadi_assert(!(compact && max_num_threads_>1),
+      "Options 'compact_work' and 'max_num_threads'>1 cannot be combined");
+
     // Check/set default inputs
     if (default_in_.empty()) {
       default_in_.resize(n_in_, 0);
@@ -260,6 +301,9 @@ namespace casadi {
     // Work vector size
     casadi_int worksize = 0;
 
+    // Reuse elements with the same sparsity (the compaction below does its own reuse)
+    bool reuse = live_variables_ && !compact;
+
     // Find a place in the work vector for the operation
     for (auto&& e : algorithm_) {
 
@@ -283,7 +327,7 @@ namespace casadi {
             casadi_int remaining = --refcount[ch_ind];
 
             // Free variable for reuse
-            if (live_variables_ && remaining==0) {
+            if (reuse && remaining==0) {
 
               // Get a pointer to the sparsity pattern of the argument that can be freed
               casadi_int nnz = nodes[ch_ind]->sparsity().nnz();
@@ -309,7 +353,7 @@ namespace casadi {
           if (e.res[c]>=0) {
 
             // Are reuse of variables (live variables) enabled?
-            if (live_variables_) {
+            if (reuse) {
               // Get a pointer to the sparsity pattern node
               casadi_int nnz = e.data->sparsity(c).nnz();
 
@@ -340,6 +384,14 @@ namespace casadi {
       }
     }
 
+    // Schedule independent calls for concurrent evaluation
+    init_parallel();
+
+    if (verbose_ && !par_order_.empty()) {
+      casadi_message("Parallel evaluation: " + str(par_offset_.size()-1) + " levels, "
+                     "up to " + str(max_num_threads_) + " concurrent calls");
+    }
+
     // Allocate work vectors (numeric)
     workloc_.resize(worksize+1);
     std::fill(workloc_.begin(), workloc_.end(), -1);
@@ -361,6 +413,21 @@ namespace casadi {
       }
     }
     workloc_.back()=wind;
+
+    // Compact the work vector
+    worknnz_.clear();
+    if (compact) {
+      wind = compact_work();
+      workloc_.back()=wind;
+    }
+
+    // Each concurrent call gets its own slice of the work vectors
+    if (!par_order_.empty()) {
+      alloc_arg(max_num_threads_*par_sz_arg_);
+      alloc_res(max_num_threads_*par_sz_res_);
+      alloc_iw(max_num_threads_*par_sz_iw_);
+      sz_w = std::max(sz_w, static_cast<size_t>(max_num_threads_)*par_sz_w_);
+    }
     for (casadi_int i=0; i<workloc_.size(); ++i) {
       if (workloc_[i]<0) workloc_[i] = i==0 ? 0 : workloc_[i-1];
       workloc_[i] += sz_w;
@@ -428,6 +495,257 @@ namespace casadi {
     }
   }
 
+  void MXFunction::init_parallel() {
+    par_order_.clear();
+    par_offset_.clear();
+    par_sz_arg_ = par_sz_res_ = par_sz_iw_ = par_sz_w_ = 0;
+    if (max_num_threads_<=1) return;
+
+    // Number of work vector elements
+    casadi_int n_work = 0;
+    for (auto&& e : algorithm_) {
+      for (casadi_int i : e.arg) n_work = std::max(n_work, i+1);
+      for (casadi_int i : e.res) n_work = std::max(n_work, i+1);
+    }
+
+    // Dependency level of each instruction. With live variables, work vector
+    // elements are reused, so read-after-write, write-after-read and
+    // write-after-write conflicts must all be respected
+    std::vector<casadi_int> last_write(n_work, -1), last_read(n_work, -1);
+    std::vector<casadi_int> level(algorithm_.size());
+    casadi_int n_level = 0;
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      const AlgEl& e = algorithm_[k];
+      casadi_int l = 0;
+      for (casadi_int i : e.arg) {
+        if (i>=0) l = std::max(l, last_write[i]+1);
+      }
+      if (e.op!=OP_OUTPUT) {
+        for (casadi_int i : e.res) {
+          if (i>=0) l = std::max(l, std::max(last_write[i], last_read[i])+1);
+        }
+      }
+      for (casadi_int i : e.arg) {
+        if (i>=0) last_read[i] = std::max(last_read[i], l);
+      }
+      if (e.op!=OP_OUTPUT) {
+        for (casadi_int i : e.res) {
+          if (i>=0) last_write[i] = l;
+        }
+      }
+      level[k] = l;
+      n_level = std::max(n_level, l+1);
+    }
+
+    // Count function calls per level
+    std::vector<casadi_int> n_call(n_level, 0);
+    casadi_int max_call = 0;
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      if (algorithm_[k].op==OP_CALL) {
+        max_call = std::max(max_call, ++n_call[level[k]]);
+      }
+    }
+
+    // Nothing to gain if no two calls are independent
+    if (max_call<2) return;
+
+    // No use for more threads than concurrent calls
+    max_num_threads_ = std::min(max_num_threads_, max_call);
+
+    // Sort instructions by level, preserving the original order within a level
+    par_offset_.resize(n_level+1, 0);
+    for (casadi_int l : level) par_offset_[l+1]++;
+    for (casadi_int l=0; l<n_level; ++l) par_offset_[l+1] += par_offset_[l];
+    std::vector<casadi_int> pos(par_offset_.begin(), par_offset_.end()-1);
+    par_order_.resize(algorithm_.size());
+    for (casadi_int k=0; k<algorithm_.size(); ++k) par_order_[pos[level[k]]++] = k;
+
+    // Work vector requirements of a single call
+    for (auto&& e : algorithm_) {
+      if (e.op==OP_CALL) {
+        par_sz_arg_ = std::max(par_sz_arg_, e.data->sz_arg());
+        par_sz_res_ = std::max(par_sz_res_, e.data->sz_res());
+        par_sz_iw_ = std::max(par_sz_iw_, e.data->sz_iw());
+        par_sz_w_ = std::max(par_sz_w_, e.data->sz_w());
+      }
+    }
+  }
+
+  casadi_int MXFunction::compact_work() {
+    casadi_int n_work = workloc_.size()-1;
+
+    // Size of each element
+    worknnz_.assign(n_work, 0);
+    for (auto&& e : algorithm_) {
+      if (e.op==OP_OUTPUT) continue;
+      for (casadi_int c=0; c<e.res.size(); ++c) {
+        if (e.res[c]>=0) worknnz_[e.res[c]] = e.data->sparsity(c).nnz();
+      }
+    }
+
+    // Last instruction reading each element
+    std::vector<casadi_int> last_use(n_work, -1);
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      for (casadi_int i : algorithm_[k].arg) {
+        if (i>=0) last_use[i] = k;
+      }
+    }
+
+    // Free blocks, sorted by offset and by size
+    std::map<casadi_int, casadi_int> free_by_offset;
+    std::set<std::pair<casadi_int, casadi_int> > free_by_size;
+    casadi_int sz = 0;
+
+    // Allocate a block, best fit
+    auto alloc_block = [&](casadi_int n) -> casadi_int {
+      if (n==0) return 0;
+      auto it = free_by_size.lower_bound(std::make_pair(n, casadi_int(-1)));
+      if (it!=free_by_size.end()) {
+        casadi_int n_block = it->first, offset = it->second;
+        free_by_size.erase(it);
+        free_by_offset.erase(offset);
+        if (n_block>n) {
+          free_by_offset[offset+n] = n_block-n;
+          free_by_size.insert(std::make_pair(n_block-n, offset+n));
+        }
+        return offset;
+      }
+      // Grow the work vector, starting from a free block at the end if any
+      casadi_int offset = sz;
+      if (!free_by_offset.empty()) {
+        auto last = std::prev(free_by_offset.end());
+        if (last->first+last->second==sz) {
+          offset = last->first;
+          free_by_size.erase(std::make_pair(last->second, last->first));
+          free_by_offset.erase(last);
+        }
+      }
+      sz = offset+n;
+      return offset;
+    };
+
+    // Free a block, merging with adjacent free blocks
+    auto free_block = [&](casadi_int offset, casadi_int n) {
+      if (n==0) return;
+      auto next = free_by_offset.lower_bound(offset);
+      if (next!=free_by_offset.end() && next->first==offset+n) {
+        n += next->second;
+        free_by_size.erase(std::make_pair(next->second, next->first));
+        next = free_by_offset.erase(next);
+      }
+      if (next!=free_by_offset.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first+prev->second==offset) {
+          offset = prev->first;
+          n += prev->second;
+          free_by_size.erase(std::make_pair(prev->second, prev->first));
+          free_by_offset.erase(prev);
+        }
+      }
+      free_by_offset[offset] = n;
+      free_by_size.insert(std::make_pair(n, offset));
+    };
+
+    // Linear scan over the algorithm
+    std::fill(workloc_.begin(), workloc_.end(), 0);
+    std::vector<bool> placed(n_work, false), freed(n_work, false);
+    for (casadi_int k=0; k<algorithm_.size(); ++k) {
+      const AlgEl& e = algorithm_[k];
+      if (e.op!=OP_OUTPUT) {
+        // Evaluate in-place if an argument of the same size is not needed afterwards
+        casadi_int n_inplace = e.data->n_inplace();
+        if (n_inplace>0 && !e.res.empty() && e.res[0]>=0 && worknnz_[e.res[0]]>0) {
+          for (casadi_int c=0; c<n_inplace; ++c) {
+            casadi_int i = e.arg[c];
+            if (i<0 || last_use[i]!=k || freed[i] || worknnz_[i]!=worknnz_[e.res[0]]) continue;
+            // Not allowed if also read by an argument that cannot be overwritten
+            if (std::find(e.arg.begin()+n_inplace, e.arg.end(), i)!=e.arg.end()) continue;
+            workloc_[e.res[0]] = workloc_[i];
+            placed[e.res[0]] = true;
+            freed[i] = true;
+            break;
+          }
+        }
+        // Allocate the remaining results
+        for (casadi_int i : e.res) {
+          if (i>=0 && !placed[i]) {
+            workloc_[i] = alloc_block(worknnz_[i]);
+            placed[i] = true;
+          }
+        }
+      }
+      // Free arguments not needed afterwards
+      for (casadi_int i : e.arg) {
+        if (i>=0 && last_use[i]==k && !freed[i]) {
+          free_block(workloc_[i], worknnz_[i]);
+          freed[i] = true;
+        }
+      }
+      // Free results that are never read
+      if (e.op!=OP_OUTPUT) {
+        for (casadi_int i : e.res) {
+          if (i>=0 && last_use[i]<k && !freed[i]) {
+            free_block(workloc_[i], worknnz_[i]);
+            freed[i] = true;
+          }
+        }
+      }
+    }
+
+    if (verbose_) {
+      casadi_message("Compacted work vector: " + str(sz) + " elements instead of "
+                     + str(work_size_default()) + " with live variables");
+    }
+    return sz;
+  }
+
+  casadi_int MXFunction::work_size() const {
+    // The element at the lowest offset starts right after the call temporaries
+    if (workloc_.size()<2) return 0;
+    return workloc_.back() - *std::min_element(workloc_.begin(), workloc_.end()-1);
+  }
+
+  casadi_int MXFunction::work_size_default() const {
+    if (worknnz_.empty()) return work_size();
+
+    // Number of reads of each element
+    std::vector<casadi_int> n_use(worknnz_.size(), 0);
+    for (auto&& e : algorithm_) {
+      for (casadi_int i : e.arg) {
+        if (i>=0) n_use[i]++;
+      }
+    }
+
+    // Simulate the default rule, reusing only elements with equal nnz
+    casadi_int sz_default = 0;
+    std::map<casadi_int, casadi_int> n_unused;
+    for (auto&& e : algorithm_) {
+      casadi_int first_to_free = 0;
+      casadi_int last_to_free = e.data->n_inplace();
+      for (casadi_int task=0; task<2; ++task) {
+        for (casadi_int c=last_to_free-1; c>=first_to_free; --c) {
+          casadi_int i = e.arg[c];
+          if (i>=0 && --n_use[i]==0) n_unused[worknnz_[i]]++;
+        }
+        if (task==1) break;
+        first_to_free = last_to_free;
+        last_to_free = e.arg.size();
+        for (casadi_int c=0; c<e.res.size(); ++c) {
+          if (e.res[c]<0) continue;
+          casadi_int nnz = e.op==OP_OUTPUT ? e.data->sparsity(c).nnz() : worknnz_[e.res[c]];
+          casadi_int& n = n_unused[nnz];
+          if (n>0) {
+            n--;
+          } else if (e.op!=OP_OUTPUT) {
+            sz_default += nnz;
+          }
+        }
+      }
+    }
+
+    return sz_default;
+  }
+
   int MXFunction::eval(const double** arg, double** res,
       casadi_int* iw, double* w, void* mem) const {
     if (verbose_) casadi_message(name_ + "::eval");
@@ -444,6 +762,11 @@ namespace casadi {
                    + str(free_vars_) + " are free.");
     }
 
+    // Evaluate independent calls concurrently
+    if (!par_order_.empty() && !print_instructions_) {
+      return eval_parallel(arg, res, iw, w);
+    }
+
     // Operation number (for printing)
     casadi_int k = 0;
 
@@ -487,6 +810,147 @@ namespace casadi {
     return 0;
   }
 
+  int MXFunction::eval_parallel(const double** arg, double** res,
+      casadi_int* iw, double* w) const {
+#ifndef CASADI_WITH_THREAD
+    casadi_error("MXFunction::eval_parallel requires WITH_THREAD=ON");
+    return 1;
+#else // CASADI_WITH_THREAD
+    // Function calls in the current level
+    std::vector<const AlgEl*> calls;
+
+    // Return flag and exception raised, for each thread
+    std::vector<int> ret_values(max_num_threads_, 0);
+    std::vector<std::exception_ptr> ex(max_num_threads_);
+
+    // Evaluate every stride:th call of a level, starting with call t,
+    // using the slice of the work vectors belonging to thread t
+    auto eval_calls = [&](casadi_int t, casadi_int stride) {
+      const double** arg1 = arg + n_in_ + t*par_sz_arg_;
+      double** res1 = res + n_out_ + t*par_sz_res_;
+      casadi_int* iw1 = iw + t*par_sz_iw_;
+      double* w1 = w + t*par_sz_w_;
+      ret_values[t] = 0;
+      try {
+        for (casadi_int j=t; j<calls.size(); j+=stride) {
+          const AlgEl& e = *calls[j];
+          for (casadi_int i=0; i<e.arg.size(); ++i)
+            arg1[i] = e.arg[i]>=0 ? w+workloc_[e.arg[i]] : nullptr;
+          for (casadi_int i=0; i<e.res.size(); ++i)
+            res1[i] = e.res[i]>=0 ? w+workloc_[e.res[i]] : nullptr;
+          if (e.data->eval(arg1, res1, iw1, w1)) {
+            ret_values[t] = 1;
+            break;
+          }
+        }
+      } catch (...) {
+        ex[t] = std::current_exception();
+      }
+    };
+
+    // Worker threads, started once and reused for all levels
+    std::mutex mtx;
+    std::condition_variable cv_start, cv_done;
+    casadi_int generation = 0, n_busy = 0;
+    bool stop = false;
+    auto worker = [&](casadi_int t) {
+      casadi_int seen = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(mtx);
+          cv_start.wait(lock, [&] { return stop || generation!=seen;});
+          if (stop) return;
+          seen = generation;
+        }
+        eval_calls(t, max_num_threads_);
+        std::lock_guard<std::mutex> lock(mtx);
+        if (--n_busy==0) cv_done.notify_one();
+      }
+    };
+    std::vector<std::thread> threads;
+
+    // Stop and join the workers when leaving, also on errors
+    struct WorkerGuard {
+      std::vector<std::thread>& threads;
+      std::mutex& mtx;
+      std::condition_variable& cv_start;
+      bool& stop;
+      ~WorkerGuard() {
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          stop = true;
+        }
+        cv_start.notify_all();
+        for (auto&& th : threads) th.join();
+      }
+    } guard{threads, mtx, cv_start, stop};
+    threads.reserve(max_num_threads_-1);
+    for (casadi_int t=1; t<max_num_threads_; ++t) threads.emplace_back(worker, t);
+
+    // Loop over dependency levels
+    for (casadi_int l=0; l+1<par_offset_.size(); ++l) {
+      calls.clear();
+      for (casadi_int k=par_offset_[l]; k<par_offset_[l+1]; ++k) {
+        const AlgEl& e = algorithm_[par_order_[k]];
+        if (e.op==OP_CALL) {
+          // Postpone until all other instructions of the level have been evaluated
+          calls.push_back(&e);
+        } else if (e.op==OP_INPUT) {
+          double *w1 = w+workloc_[e.res.front()];
+          casadi_int nnz=e.data.nnz();
+          casadi_int i=e.data->ind();
+          casadi_int nz_offset=e.data->offset();
+          if (arg[i]==nullptr) {
+            std::fill(w1, w1+nnz, 0);
+          } else {
+            std::copy(arg[i]+nz_offset, arg[i]+nz_offset+nnz, w1);
+          }
+        } else if (e.op==OP_OUTPUT) {
+          double *w1 = w+workloc_[e.arg.front()];
+          casadi_int nnz=e.data->dep().nnz();
+          casadi_int i=e.data->ind();
+          casadi_int nz_offset=e.data->offset();
+          if (res[i]) std::copy(w1, w1+nnz, res[i]+nz_offset);
+        } else {
+          const double** arg1 = arg+n_in_;
+          double** res1 = res+n_out_;
+          for (casadi_int i=0; i<e.arg.size(); ++i)
+            arg1[i] = e.arg[i]>=0 ? w+workloc_[e.arg[i]] : nullptr;
+          for (casadi_int i=0; i<e.res.size(); ++i)
+            res1[i] = e.res[i]>=0 ? w+workloc_[e.res[i]] : nullptr;
+          if (e.data->eval(arg1, res1, iw, w)) return 1;
+        }
+      }
+
+      // Evaluate the calls, the calling thread takes the first share
+      if (calls.empty()) continue;
+      casadi_int n_thread = calls.size()==1 ? 1 : max_num_threads_;
+      if (n_thread>1) {
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          n_busy = n_thread-1;
+          generation++;
+        }
+        cv_start.notify_all();
+      }
+      eval_calls(0, n_thread);
+      if (n_thread>1) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_done.wait(lock, [&] { return n_busy==0;});
+      }
+
+      // Propagate errors as in sequential evaluation
+      for (casadi_int t=0; t<n_thread; ++t) {
+        if (ex[t]) std::rethrow_exception(ex[t]);
+      }
+      for (casadi_int t=0; t<n_thread; ++t) {
+        if (ret_values[t]) return 1;
+      }
+    }
+    return 0;
+#endif // CASADI_WITH_THREAD
+  }
+
   std::string MXFunction::print(const AlgEl& el) const {
     std::stringstream s;
     if (el.op==OP_OUTPUT) {
@@ -1266,7 +1730,7 @@ namespace casadi {
       arg_is_ref.resize(e.arg.size());
       for (casadi_int i=0; i<e.arg.size(); ++i) {
         casadi_int j=e.arg.at(i);
-        if (j>=0 && workloc_.at(j)!=workloc_.at(j+1)) {
+        if (j>=0 && work_nnz(j)!=0) {
           arg.at(i) = j;
           arg_is_ref.at(i) = work_is_ref.at(j);
         } else {
@@ -1279,7 +1743,7 @@ namespace casadi {
       res.resize(e.res.size());
       for (casadi_int i=0; i<e.res.size(); ++i) {
         casadi_int j=e.res.at(i);
-        if (j>=0 && workloc_.at(j)!=workloc_.at(j+1)) {
+        if (j>=0 && work_nnz(j)!=0) {
           res.at(i) = j;
         } else {
           res.at(i) = -1;
@@ -1299,7 +1763,7 @@ namespace casadi {
 
       for (casadi_int i=0; i<e.res.size(); ++i) {
         casadi_int j=e.res.at(i);
-        if (j>=0 && workloc_.at(j)!=workloc_.at(j+1)) {
+        if (j>=0 && work_nnz(j)!=0) {
           work_is_ref.at(j) = res_is_ref.at(i);
           if (res_is_ref.at(i)) {
             needs_reference[j] = true;
@@ -1319,7 +1783,7 @@ namespace casadi {
 
     // Declare scalar work vector elements as local variables
     for (casadi_int i=0; i<workloc_.size()-1; ++i) {
-      casadi_int n=workloc_[i+1]-workloc_[i];
+      casadi_int n=work_nnz(i);
       if (n==0) continue;
       /* Could use local variables for small work vector elements here, e.g.:
          ...
@@ -1833,6 +2297,10 @@ namespace casadi {
   Dict MXFunction::get_stats(void* mem) const {
     Dict stats = XFunction::get_stats(mem);
 
+    // Size of the work vector region holding the elements
+    stats["work_size"] = work_size();
+    stats["work_size_default"] = work_size_default();
+
     Function dep;
     for (auto&& e : algorithm_) {
       if (e.op==OP_CALL) {
@@ -1850,7 +2318,7 @@ namespace casadi {
   void MXFunction::serialize_body(SerializingStream &s) const {
     XFunction<MXFunction, MX, MXNode>::serialize_body(s);
 
-    s.version("MXFunction", 2);
+    s.version("MXFunction", 4);
     s.pack("MXFunction::n_instr", algorithm_.size());
 
     // Loop over algorithm
@@ -1865,13 +2333,21 @@ namespace casadi {
     s.pack("MXFunction::default_in", default_in_);
     s.pack("MXFunction::live_variables", live_variables_);
     s.pack("MXFunction::print_instructions", print_instructions_);
+    s.pack("MXFunction::max_num_threads", max_num_threads_);
+    s.pack("MXFunction::par_order", par_order_);
+    s.pack("MXFunction::par_offset", par_offset_);
+    s.pack("MXFunction::par_sz_arg", par_sz_arg_);
+    s.pack("MXFunction::par_sz_res", par_sz_res_);
+    s.pack("MXFunction::par_sz_iw", par_sz_iw_);
+    s.pack("MXFunction::par_sz_w", par_sz_w_);
+    s.pack("MXFunction::worknnz", worknnz_);
 
     XFunction<MXFunction, MX, MXNode>::delayed_serialize_members(s);
   }
 
 
   MXFunction::MXFunction(DeserializingStream& s) : XFunction<MXFunction, MX, MXNode>(s) {
-    int version = s.version("MXFunction", 1, 2);
+    int version = s.version("MXFunction", 1, 4);
     size_t n_instructions;
     s.unpack("MXFunction::n_instr", n_instructions);
     algorithm_.resize(n_instructions);
@@ -1889,6 +2365,23 @@ namespace casadi {
     s.unpack("MXFunction::live_variables", live_variables_);
     print_instructions_ = false;
     if (version >= 2) s.unpack("MXFunction::print_instructions", print_instructions_);
+    max_num_threads_ = 1;
+    par_sz_arg_ = par_sz_res_ = par_sz_iw_ = par_sz_w_ = 0;
+    if (version >= 3) {
+      s.unpack("MXFunction::max_num_threads", max_num_threads_);
+      s.unpack("MXFunction::par_order", par_order_);
+      s.unpack("MXFunction::par_offset", par_offset_);
+      s.unpack("MXFunction::par_sz_arg", par_sz_arg_);
+      s.unpack("MXFunction::par_sz_res", par_sz_res_);
+      s.unpack("MXFunction::par_sz_iw", par_sz_iw_);
+      s.unpack("MXFunction::par_sz_w", par_sz_w_);
+    }
+    if (version >= 4) s.unpack("MXFunction::worknnz", worknnz_);
+#ifndef CASADI_WITH_THREAD
+    // Schedule cannot be used without thread support
+    par_order_.clear();
+    par_offset_.clear();
+#endif // CASADI_WITH_THREAD
 
     XFunction<MXFunction, MX, MXNode>::delayed_deserialize_members(s);
   }
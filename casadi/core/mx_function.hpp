@@ -81,6 +81,14 @@ namespace casadi {
         \identifier{21} */
     std::vector<casadi_int> workloc_;
 
+    /** \brief Number of nonzeros of each element in the w_ vector
+
+        Only set if the work vector has been compacted, in which case the
+        offsets in workloc_ are no longer sorted
+
+        \identifier{2dq} */
+    std::vector<casadi_int> worknnz_;
+
 
     std::vector<bool> workstate_;
 
@@ -96,6 +104,18 @@ namespace casadi {
     /// Print instructions during evaluation
     bool print_instructions_;
 
+    /// Maximum number of threads for evaluating independent calls
+    casadi_int max_num_threads_;
+
+    /// Instructions sorted by dependency level (parallel evaluation)
+    std::vector<casadi_int> par_order_;
+
+    /// Offsets into par_order_ for each dependency level
+    std::vector<casadi_int> par_offset_;
+
+    /// Work vector sizes reserved for each concurrent call
+    size_t par_sz_arg_, par_sz_res_, par_sz_iw_, par_sz_w_;
+
     /** \brief Constructor
 
         \identifier{22} */
@@ -114,6 +134,40 @@ namespace casadi {
         \identifier{24} */
     int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
 
+    /** \brief  Evaluate level by level, calls within a level run concurrently
+
+        \identifier{2do} */
+    int eval_parallel(const double** arg, double** res, casadi_int* iw, double* w) const;
+
+    /** \brief  Build the dependency level schedule for parallel evaluation
+
+        \identifier{2dp} */
+    void init_parallel();
+
+    /** \brief  Place work vector elements using a linear scan over live ranges
+
+        Returns the size of the work vector region holding the elements
+
+        \identifier{2dr} */
+    casadi_int compact_work();
+
+    /** \brief  Size of the work vector region holding the elements
+
+        \identifier{2f9} */
+    casadi_int work_size() const;
+
+    /** \brief  Size of the work vector region with the default live variable rule
+
+        \identifier{2fa} */
+    casadi_int work_size_default() const;
+
+    /** \brief  Number of nonzeros of a work vector element
+
+        \identifier{2ds} */
+    casadi_int work_nnz(casadi_int i) const {
+      return worknnz_.empty() ? workloc_[i+1]-workloc_[i] : worknnz_[i];
+    }
+
     /** \brief  Print description
 
         \identifier{25} */
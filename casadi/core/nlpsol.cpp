@@ -43,6 +43,25 @@ namespace casadi {
     return Nlpsol::getPlugin(name).doc;
   }
 
+  // Get the memory of an NLP solver instance that has been evaluated
+  static void* nlpsol_sens_memory(const Function& solver, int mem) {
+    casadi_assert(solver.is_a("Nlpsol", true),
+      "Expected an NLP solver instance, got '" + solver.class_name() + "'");
+    casadi_assert(solver->has_memory(mem),
+      "No solution available: Solver was not yet numerically evaluated.");
+    return solver.memory(mem);
+  }
+
+  DMDict nlpsol_sens_forward(const Function& solver, const DMDict& fseed, int mem) {
+    void* m = nlpsol_sens_memory(solver, mem);
+    return solver.get<Nlpsol>()->sens_forward(m, fseed);
+  }
+
+  DMDict nlpsol_sens_reverse(const Function& solver, const DMDict& aseed, int mem) {
+    void* m = nlpsol_sens_memory(solver, mem);
+    return solver.get<Nlpsol>()->sens_reverse(m, aseed);
+  }
+
   template<class X>
   Function construct_nlpsol(const std::string& name, const std::string& solver,
                   const std::map<std::string, X>& nlp, const Dict& opts) {
@@ -383,6 +402,11 @@ namespace casadi {
       {"no_nlp_grad",
        {OT_BOOL,
         "Prevent the creation of the 'nlp_grad' function"}},
+      {"hess_vec",
+       {OT_BOOL,
+        "Create the function 'nlp_hess_vec' (x, p, lam:f, lam:g, v) -> (hv), the product of "
+        "the Hessian of the Lagrangian with a vector, by forward-over-reverse "
+        "algorithmic differentiation without forming the Hessian (default false)"}},
       {"bound_consistency",
        {OT_BOOL,
         "Ensure that primal-dual solution is consistent with the bounds"}},
@@ -440,6 +464,7 @@ namespace casadi {
     OracleFunction::init(opts);
 
     // Read options
+    bool hess_vec = false;
     for (auto&& op : opts) {
       if (op.first=="iteration_callback") {
         fcallback_ = op.second;
@@ -467,6 +492,8 @@ namespace casadi {
         calc_g_ = op.second;
       } else if (op.first=="no_nlp_grad") {
         no_nlp_grad_ = op.second;
+      } else if (op.first=="hess_vec") {
+        hess_vec = op.second;
       } else if (op.first=="bound_consistency") {
         bound_consistency_ = op.second;
       } else if (op.first=="min_lam") {
@@ -571,6 +598,25 @@ namespace casadi {
                       {"f", "g", "grad:gamma:x", "grad:gamma:p"},
                       {{"gamma", {"f", "g"}}});
     }
+
+    // Matrix-free Hessian of the Lagrangian
+    if (hess_vec) create_hess_vec();
+  }
+
+  void Nlpsol::create_hess_vec() {
+    if (has_function("nlp_hess_vec")) return;
+    // Symbolic primal-dual point and direction
+    std::vector<MX> arg = oracle_.mx_in();
+    MX lam_f = MX::sym("lam_f", oracle_.sparsity_out(NL_F));
+    MX lam_g = MX::sym("lam_g", oracle_.sparsity_out(NL_G));
+    MX v = MX::sym("v", oracle_.sparsity_in(NL_X));
+    std::vector<MX> res = oracle_(arg);
+    // Gradient of the Lagrangian by a reverse sweep with the multipliers as seeds
+    MX grad_l = MX::reverse(res, {arg[NL_X]}, {{lam_f, lam_g}}).at(0).at(0);
+    // Directional derivative of the gradient by a forward sweep
+    MX hv = MX::forward({grad_l}, {arg[NL_X]}, {{v}}).at(0).at(0);
+    create_function("nlp_hess_vec", {arg[NL_X], arg[NL_P], lam_f, lam_g, v},
+                    {densify(hv)}, {"x", "p", "lam:f", "lam:g", "v"}, {"hv"});
   }
 
   int detect_bounds_callback(const double** arg, double** res,
@@ -607,6 +653,11 @@ namespace casadi {
     m->success = false;
     m->d_nlp.prob = nullptr;
     m->unified_return_status = SOLVER_RET_UNKNOWN;
+    m->sens_avail = m->sens_fact = false;
+    m->sens_z.resize(nx_ + ng_);
+    m->sens_lam.resize(nx_ + ng_);
+    m->sens_p.resize(np_);
+    m->sens_lam_p.resize(np_);
     return 0;
   }
 
@@ -766,6 +817,17 @@ namespace casadi {
       bound_consistency(nx_+ng_, d_nlp->z, d_nlp->lam, d_nlp->lbz, d_nlp->ubz);
     }
 
+    // Keep the solution for parametric sensitivity analysis
+    m->sens_fact = false;
+    m->sens_avail = !flag;
+    if (m->sens_avail) {
+      casadi_copy(d_nlp->z, nx_ + ng_, get_ptr(m->sens_z));
+      casadi_copy(d_nlp->lam, nx_ + ng_, get_ptr(m->sens_lam));
+      casadi_copy(d_nlp->p, np_, get_ptr(m->sens_p));
+      casadi_copy(d_nlp->lam_p, np_, get_ptr(m->sens_lam_p));
+      m->sens_f = d_nlp->objective;
+    }
+
     // Get optimal solution
     casadi_copy(d_nlp->z, nx_, d_nlp->x);
 
@@ -1118,7 +1180,281 @@ namespace casadi {
     return Function(name, arg, res, inames, onames, options);
   }
 
+  void Nlpsol::sens_factorize(NlpsolMemory* m) const {
+    casadi_assert(detect_simple_bounds_is_simple_.empty(),
+      "Simple bound detection not compatible with parametric sensitivities");
+    casadi_assert(m->sens_avail,
+      "No solution available: The solver has not been called successfully.");
+    // Quick return if already factorized
+    if (m->sens_fact) return;
+
+    // First call: Keep the KKT function, fix the sparsity of the KKT matrix
+    if (m->sens_kkt_fcn.is_null()) {
+      m->sens_kkt_fcn = kkt();
+      const Sparsity& sp_jg = m->sens_kkt_fcn.sparsity_out(0);
+      const Sparsity& sp_hl = m->sens_kkt_fcn.sparsity_out(1);
+      m->sens_jg.resize(sp_jg.nnz());
+      m->sens_hl.resize(sp_hl.nnz());
+      // Nonzero indices, offset by one to tell them apart from added entries
+      std::vector<double> ind_jg(sp_jg.nnz()), ind_hl(sp_hl.nnz());
+      for (casadi_int k = 0; k < sp_jg.nnz(); ++k) ind_jg[k] = static_cast<double>(k + 1);
+      for (casadi_int k = 0; k < sp_hl.nnz(); ++k) ind_hl[k] = static_cast<double>(k + 1);
+      DM H_11 = project(DM(sp_hl, ind_hl), sp_hl + Sparsity::diag(nx_));
+      DM H_21(sp_jg, ind_jg);
+      DM H = DM::blockcat({{H_11, H_21.T()}, {H_21, DM(Sparsity::diag(ng_))}});
+      m->sens_kkt_map.resize(H.nnz());
+      for (casadi_int k = 0; k < H.nnz(); ++k) {
+        m->sens_kkt_map[k] = static_cast<casadi_int>(H.nonzeros()[k]) - 1;
+      }
+      m->sens_kkt.resize(H.nnz());
+      m->sens_linsol = Linsol(name_ + "_sens_linsol", sens_linsol_, H.sparsity(),
+        sens_linsol_options_);
+      m->sens_linsol_mem = m->sens_linsol.checkout();
+    }
+
+    // Hessian of the Lagrangian, Jacobian of the constraints
+    const double one = 1;
+    m->sens_kkt_fcn({get_ptr(m->sens_z), get_ptr(m->sens_p), &one, get_ptr(m->sens_lam) + nx_},
+      {get_ptr(m->sens_jg), get_ptr(m->sens_hl)});
+
+    // KKT matrix with the active set given by the multiplier signs, cf. get_forward
+    const Sparsity& sp = m->sens_linsol.sparsity();
+    const casadi_int *colind = sp.colind(), *row = sp.row();
+    for (casadi_int c = 0; c < nx_ + ng_; ++c) {
+      bool active_c = std::fabs(m->sens_lam[c]) > min_lam_;
+      for (casadi_int k = colind[c]; k < colind[c + 1]; ++k) {
+        casadi_int r = row[k], i = m->sens_kkt_map[k];
+        bool active_r = std::fabs(m->sens_lam[r]) > min_lam_;
+        double& v = m->sens_kkt[k];
+        if (r < nx_ && c < nx_) {
+          // diag(iIx)*HL + diag(bIx)
+          v = active_r ? (r == c ? 1 : 0) : i < 0 ? 0 : m->sens_hl[i];
+        } else if (r < nx_) {
+          // diag(iIx)*JG'
+          v = active_r || i < 0 ? 0 : m->sens_jg[i];
+        } else if (c < nx_) {
+          // diag(bIg)*JG
+          v = active_r && i >= 0 ? m->sens_jg[i] : 0;
+        } else {
+          // -diag(iIg)
+          v = r == c && !active_c ? -1 : 0;
+        }
+      }
+    }
+
+    // Numerical factorization, reused for all subsequent directions
+    casadi_assert(!m->sens_linsol.nfact(get_ptr(m->sens_kkt), m->sens_linsol_mem),
+      "Failed to factorize the KKT system");
+    m->sens_fact = true;
+  }
+
+  // Seeds in a dictionary as a dense (n-by-nd) block of nonzeros, nd determined by first seed
+  static std::vector<double> sens_seed(const DMDict& seed, const std::string& name,
+                                       casadi_int n, casadi_int& nd) {
+    auto it = seed.find(name);
+    if (it == seed.end() || it->second.is_empty()) return std::vector<double>();
+    const DM& s = it->second;
+    casadi_assert(s.size1() == n, "Dimension mismatch for seed '" + name + "': "
+      "Expected " + str(n) + " rows, got " + str(s.size1()) + ".");
+    if (nd < 0) nd = s.size2();
+    casadi_assert(s.size2() == nd, "Dimension mismatch for seed '" + name + "': "
+      "Expected " + str(nd) + " directions, got " + str(s.size2()) + ".");
+    return densify(s).nonzeros();
+  }
+
+  DMDict Nlpsol::sens_forward(void* mem, const DMDict& fseed) const {
+    auto m = static_cast<NlpsolMemory*>(mem);
+    for (auto&& e : fseed) index_in(e.first);  // Check names
+
+    // Collect seeds, initial guesses are unused
+    casadi_int nfwd = -1;
+    std::vector<double> fwd_lbx = sens_seed(fseed, "lbx", nx_, nfwd);
+    std::vector<double> fwd_ubx = sens_seed(fseed, "ubx", nx_, nfwd);
+    std::vector<double> fwd_lbg = sens_seed(fseed, "lbg", ng_, nfwd);
+    std::vector<double> fwd_ubg = sens_seed(fseed, "ubg", ng_, nfwd);
+    std::vector<double> fwd_p = sens_seed(fseed, "p", np_, nfwd);
+    if (nfwd < 0) nfwd = 1;
+
+    // Make sure KKT system is factorized
+    sens_factorize(m);
+
+    // fwd_nlp_grad has the signature
+    // (x, p, lam_f, lam_g, f, g, grad_x, grad_p,
+    //  fwd_x, fwd_p, fwd_lam_f, fwd_lam_g)
+    // -> (fwd_f, fwd_g, fwd_grad_x, fwd_grad_p)
+    Function& fwd_nlp_grad = m->sens_fwd[nfwd];
+    if (fwd_nlp_grad.is_null()) fwd_nlp_grad = get_function("nlp_grad").forward(nfwd);
+    std::vector<DM> vv(fwd_nlp_grad.n_in(), 0);
+    for (casadi_int i = 0; i < 8; ++i) vv[i] = DM(fwd_nlp_grad.sparsity_in(i));
+    vv[0].nonzeros().assign(m->sens_z.begin(), m->sens_z.begin() + nx_);
+    vv[1].nonzeros() = m->sens_p;
+    vv[2] = 1;
+    vv[3].nonzeros().assign(m->sens_lam.begin() + nx_, m->sens_lam.end());
+    vv[4] = m->sens_f;
+    vv[5].nonzeros().assign(m->sens_z.begin() + nx_, m->sens_z.end());
+    for (casadi_int i = 0; i < nx_; ++i) vv[6].nonzeros()[i] = -m->sens_lam[i];
+    for (casadi_int i = 0; i < np_; ++i) vv[7].nonzeros()[i] = -m->sens_lam_p[i];
+    if (!fwd_p.empty()) vv[9] = DM(fwd_nlp_grad.sparsity_in(9), fwd_p);
+
+    // Calculate sensitivities from fwd_p
+    std::vector<DM> r = fwd_nlp_grad(vv);
+    std::vector<double> fwd_g_p = r.at(1).nonzeros();
+    std::vector<double> fwd_gL_p = r.at(2).nonzeros();
+
+    // Propagate forward seeds to the right-hand-sides
+    casadi_int nz = nx_ + ng_;
+    std::vector<double> v(nz * nfwd, 0);
+    for (casadi_int d = 0; d < nfwd; ++d) {
+      for (casadi_int i = 0; i < nz; ++i) {
+        double lam = m->sens_lam[i];
+        bool ub = lam > min_lam_, lb = lam < -min_lam_;
+        const std::vector<double>& fwd_lb = i < nx_ ? fwd_lbx : fwd_lbg;
+        const std::vector<double>& fwd_ub = i < nx_ ? fwd_ubx : fwd_ubg;
+        casadi_int k = d * (i < nx_ ? nx_ : ng_) + (i < nx_ ? i : i - nx_);
+        double& vk = v[d * nz + i];
+        if (lb && !fwd_lb.empty()) vk += fwd_lb[k];
+        if (ub && !fwd_ub.empty()) vk += fwd_ub[k];
+        if (i < nx_) {
+          if (!lb && !ub) vk -= fwd_gL_p[k];
+        } else {
+          if (lb || ub) vk -= fwd_g_p[k];
+        }
+      }
+    }
+
+    // Solve for all directions with the stored factorization
+    casadi_assert(!m->sens_linsol.solve(get_ptr(m->sens_kkt), get_ptr(v), nfwd, false,
+      m->sens_linsol_mem), "Failed to solve the KKT system");
+
+    // Calculate sensitivities in f, g, lam_x and lam_p
+    std::vector<double> fwd_x(nx_ * nfwd), fwd_lam_g(ng_ * nfwd);
+    for (casadi_int d = 0; d < nfwd; ++d) {
+      std::copy(v.begin() + d * nz, v.begin() + d * nz + nx_, fwd_x.begin() + d * nx_);
+      std::copy(v.begin() + d * nz + nx_, v.begin() + (d + 1) * nz,
+        fwd_lam_g.begin() + d * ng_);
+    }
+    vv[8] = DM(fwd_nlp_grad.sparsity_in(8), fwd_x);
+    vv[11] = DM(fwd_nlp_grad.sparsity_in(11), fwd_lam_g);
+    r = fwd_nlp_grad(vv);
+
+    // Forward sensitivities
+    DMDict ret;
+    ret["x"] = DM::reshape(DM(fwd_x), nx_, nfwd);
+    ret["f"] = DM::reshape(DM(r.at(0).nonzeros()), 1, nfwd);
+    ret["g"] = DM::reshape(DM(r.at(1).nonzeros()), ng_, nfwd);
+    ret["lam_x"] = -DM::reshape(DM(r.at(2).nonzeros()), nx_, nfwd);
+    ret["lam_g"] = DM::reshape(DM(fwd_lam_g), ng_, nfwd);
+    ret["lam_p"] = -DM::reshape(DM(r.at(3).nonzeros()), np_, nfwd);
+    return ret;
+  }
+
+  DMDict Nlpsol::sens_reverse(void* mem, const DMDict& aseed) const {
+    auto m = static_cast<NlpsolMemory*>(mem);
+    for (auto&& e : aseed) index_out(e.first);  // Check names
+
+    // Collect seeds
+    casadi_int nadj = -1;
+    std::vector<double> adj_x = sens_seed(aseed, "x", nx_, nadj);
+    std::vector<double> adj_f = sens_seed(aseed, "f", 1, nadj);
+    std::vector<double> adj_g = sens_seed(aseed, "g", ng_, nadj);
+    std::vector<double> adj_lam_x = sens_seed(aseed, "lam_x", nx_, nadj);
+    std::vector<double> adj_lam_g = sens_seed(aseed, "lam_g", ng_, nadj);
+    std::vector<double> adj_lam_p = sens_seed(aseed, "lam_p", np_, nadj);
+    if (nadj < 0) nadj = 1;
+
+    // Make sure KKT system is factorized
+    sens_factorize(m);
+
+    // rev_nlp_grad has the signature
+    // (x, p, lam_f, lam_g, f, g, grad_x, grad_p,
+    //  adj_f, adj_g, adj_grad_x, adj_grad_p)
+    // -> (adj_x, adj_p, adj_lam_f, adj_lam_g)
+    Function& rev_nlp_grad = m->sens_adj[nadj];
+    if (rev_nlp_grad.is_null()) rev_nlp_grad = get_function("nlp_grad").reverse(nadj);
+    std::vector<DM> vv(rev_nlp_grad.n_in(), 0);
+    for (casadi_int i = 0; i < 8; ++i) vv[i] = DM(rev_nlp_grad.sparsity_in(i));
+    vv[0].nonzeros().assign(m->sens_z.begin(), m->sens_z.begin() + nx_);
+    vv[1].nonzeros() = m->sens_p;
+    vv[2] = 1;
+    vv[3].nonzeros().assign(m->sens_lam.begin() + nx_, m->sens_lam.end());
+    vv[4] = m->sens_f;
+    vv[5].nonzeros().assign(m->sens_z.begin() + nx_, m->sens_z.end());
+    for (casadi_int i = 0; i < nx_; ++i) vv[6].nonzeros()[i] = -m->sens_lam[i];
+    for (casadi_int i = 0; i < np_; ++i) vv[7].nonzeros()[i] = -m->sens_lam_p[i];
+    if (!adj_f.empty()) vv[8] = DM(rev_nlp_grad.sparsity_in(8), adj_f);
+    if (!adj_g.empty()) vv[9] = DM(rev_nlp_grad.sparsity_in(9), adj_g);
+    if (!adj_lam_x.empty()) vv[10] = -DM(rev_nlp_grad.sparsity_in(10), adj_lam_x);
+    if (!adj_lam_p.empty()) vv[11] = -DM(rev_nlp_grad.sparsity_in(11), adj_lam_p);
+
+    // Calculate sensitivities from f, g, lam_x and lam_p
+    std::vector<DM> r = rev_nlp_grad(vv);
+    std::vector<double> adj_x0 = r.at(0).nonzeros();
+    DM adj_p0 = DM::reshape(DM(r.at(1).nonzeros()), np_, nadj);
+    std::vector<double> adj_lam_g0 = r.at(3).nonzeros();
+
+    // Right-hand-sides
+    casadi_int nz = nx_ + ng_;
+    std::vector<double> v(nz * nadj);
+    for (casadi_int d = 0; d < nadj; ++d) {
+      for (casadi_int i = 0; i < nx_; ++i) {
+        v[d * nz + i] = adj_x0[d * nx_ + i] + (adj_x.empty() ? 0 : adj_x[d * nx_ + i]);
+      }
+      for (casadi_int i = 0; i < ng_; ++i) {
+        v[d * nz + nx_ + i] = adj_lam_g0[d * ng_ + i]
+          + (adj_lam_g.empty() ? 0 : adj_lam_g[d * ng_ + i]);
+      }
+    }
+
+    // Solve the transposed system for all directions with the stored factorization
+    casadi_assert(!m->sens_linsol.solve(get_ptr(m->sens_kkt), get_ptr(v), nadj, true,
+      m->sens_linsol_mem), "Failed to solve the KKT system");
+
+    // Distribute beta_x_bar, beta_g_bar over the active bounds
+    std::vector<double> asens_lbx(nx_ * nadj, 0), asens_ubx(nx_ * nadj, 0);
+    std::vector<double> asens_lbg(ng_ * nadj, 0), asens_ubg(ng_ * nadj, 0);
+    std::vector<double> beta_x(nx_ * nadj, 0), beta_g(ng_ * nadj, 0);
+    for (casadi_int d = 0; d < nadj; ++d) {
+      for (casadi_int i = 0; i < nz; ++i) {
+        double lam = m->sens_lam[i], beta = v[d * nz + i];
+        bool ub = lam > min_lam_, lb = lam < -min_lam_;
+        if (i < nx_) {
+          casadi_int k = d * nx_ + i;
+          if (lb) asens_lbx[k] = beta;
+          if (ub) asens_ubx[k] = beta;
+          if (!lb && !ub) beta_x[k] = beta;
+        } else {
+          casadi_int k = d * ng_ + i - nx_;
+          if (lb) asens_lbg[k] = beta;
+          if (ub) asens_ubg[k] = beta;
+          if (lb || ub) beta_g[k] = beta;
+        }
+      }
+    }
+
+    // Calculate sensitivities in p
+    vv[8] = 0;
+    vv[9] = DM(rev_nlp_grad.sparsity_in(9), beta_g);
+    vv[10] = DM(rev_nlp_grad.sparsity_in(10), beta_x);
+    vv[11] = 0;
+    r = rev_nlp_grad(vv);
+
+    // Reverse sensitivities
+    DMDict ret;
+    ret["lbx"] = DM::reshape(DM(asens_lbx), nx_, nadj);
+    ret["ubx"] = DM::reshape(DM(asens_ubx), nx_, nadj);
+    ret["lbg"] = DM::reshape(DM(asens_lbg), ng_, nadj);
+    ret["ubg"] = DM::reshape(DM(asens_ubg), ng_, nadj);
+    ret["p"] = adj_p0 - DM::reshape(DM(r.at(1).nonzeros()), np_, nadj);
+    return ret;
+  }
+
   int Nlpsol::callback(NlpsolMemory* m) const {
+    // Termination requested by a driver
+    if (m->stop_check) {
+      auto d_nlp = &m->d_nlp;
+      double pr_inf = casadi_max_viol(nx_ + ng_, d_nlp->z, d_nlp->lbz, d_nlp->ubz);
+      if (m->stop_check(d_nlp->objective, pr_inf)) return 1;
+    }
     // Quick return if no callback function
     if (fcallback_.is_null()) return 0;
     // Callback inputs
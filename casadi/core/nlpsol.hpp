@@ -137,6 +137,41 @@ namespace casadi {
   CASADI_EXPORT std::vector<double> nlpsol_default_in();
   ///@}
 
+  /** \brief Forward parametric sensitivities of the last NLP solution
+
+      Seeds are given for the inputs "p", "lbx", "ubx", "lbg" and "ubg" of \a solver,
+      one column per direction. Returns the sensitivities of all outputs ("x", "f", ...),
+      again with one column per direction. The active set and the KKT system are taken
+      from the last successful call of \a solver using the memory object \a mem.
+      The KKT matrix is factorized once per solve and reused between calls.
+
+      \identifier{2dw} */
+  CASADI_EXPORT DMDict nlpsol_sens_forward(const Function& solver, const DMDict& fseed,
+                                           int mem=0);
+
+  /** \brief Reverse parametric sensitivities of the last NLP solution
+
+      Seeds are given for the outputs of \a solver, one column per direction. Returns the
+      sensitivities of the inputs "p", "lbx", "ubx", "lbg" and "ubg". Shares the KKT
+      factorization with ::nlpsol_sens_forward.
+
+      \identifier{2dx} */
+  CASADI_EXPORT DMDict nlpsol_sens_reverse(const Function& solver, const DMDict& aseed,
+                                           int mem=0);
+
+  /** \brief Solve an NLP from multiple initial guesses concurrently
+
+      Creates a Function with the same inputs and outputs as \a solver, except that the
+      initial guess "x0" has \a n_start columns, one per start. The starts are distributed
+      over a pool of threads, each with its own checked out memory of \a solver, and the
+      best solution is returned: the lowest objective among the converged runs or, if no
+      run converged, the least infeasible one. Per-start objectives, iteration counts and
+      return statuses are available in the statistics.
+
+      \identifier{2ed} */
+  CASADI_EXPORT Function nlpsol_multistart(const std::string& name, const Function& solver,
+                                           casadi_int n_start, const Dict& opts=Dict());
+
   /** \brief Get all options for a plugin
 
       \identifier{1t5} */
@@ -29,6 +29,9 @@
 #include "nlpsol.hpp"
 #include "oracle_function.hpp"
 #include "plugin_interface.hpp"
+#include "linsol.hpp"
+
+#include <functional>
 
 
 /// \cond INTERNAL
@@ -46,6 +49,25 @@ namespace casadi {
     bool success;
     // Return status
     UnifiedReturnStatus unified_return_status;
+    // Last successful solution, kept for parametric sensitivity analysis
+    bool sens_avail;
+    std::vector<double> sens_z, sens_lam, sens_p, sens_lam_p;
+    double sens_f;
+    // Factored KKT system at the last solution
+    bool sens_fact;
+    Linsol sens_linsol;
+    casadi_int sens_linsol_mem;
+    std::vector<double> sens_kkt;
+    // Functions for parametric sensitivities, kept alive between calls
+    Function sens_kkt_fcn;
+    std::map<casadi_int, Function> sens_fwd, sens_adj;
+    // Nonzeros of the constraint Jacobian and the Hessian of the Lagrangian
+    std::vector<double> sens_jg, sens_hl;
+    // For each KKT nonzero, the corresponding nonzero of sens_hl or sens_jg (-1 if none)
+    std::vector<casadi_int> sens_kkt_map;
+    // Early termination check installed by a driver (e.g. multistart), called each
+    // iteration with the objective and the primal infeasibility, true to abort
+    std::function<bool(double, double)> stop_check;
   };
 
   /** \brief NLP solver storage class
@@ -269,6 +291,26 @@ namespace casadi {
     // Get KKT function
     Function kkt() const;
 
+    /** \brief Create the Hessian-vector product function "nlp_hess_vec"
+
+        (x, p, lam:f, lam:g, v) -> (hv) by forward-over-reverse AD, the Hessian is not formed
+
+        \identifier{2ee} */
+    void create_hess_vec();
+
+    // Factorize the KKT system at the last solution, if not already done
+    void sens_factorize(NlpsolMemory* m) const;
+
+    ///@{
+    /** \brief Parametric sensitivities of the last solution
+
+        Reuses the KKT factorization for any number of directions
+
+        \identifier{2dv} */
+    DMDict sens_forward(void* mem, const DMDict& fseed) const;
+    DMDict sens_reverse(void* mem, const DMDict& aseed) const;
+    ///@}
+
     // Make sure primal-dual solution is consistent with bounds
     static void bound_consistency(casadi_int n, double* z, double* lam,
                                   const double* lbz, const double* ubz);
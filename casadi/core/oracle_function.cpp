@@ -30,6 +30,14 @@
 #include <iomanip>
 #include <iostream>
 
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
+
 namespace casadi {
 
 OracleCallback::OracleCallback(const std::string& name,
@@ -275,6 +283,40 @@ Function OracleFunction::create_function(const Function& oracle, const std::stri
   return ret;
 }
 
+Function OracleFunction::fuse_functions(const std::string& fname,
+    const std::vector<std::string>& fcns) {
+  casadi_assert(!fcns.empty(), "No functions to fuse");
+  std::vector<std::string> s_in = get_function(fcns.front()).name_in();
+
+  // Union of all outputs
+  std::vector<std::string> s_out;
+  for (const std::string& fcn : fcns) {
+    const Function& f = get_function(fcn);
+    casadi_assert(f.name_in()==s_in, "Cannot fuse " + fcn + ": Inputs " + str(f.name_in())
+      + " do not match " + str(s_in));
+    for (const std::string& n : f.name_out()) {
+      if (std::find(s_out.begin(), s_out.end(), n)==s_out.end()) s_out.push_back(n);
+    }
+  }
+
+  // Create fused function
+  Function ret = create_function(fname, s_in, s_out);
+
+  // Outputs of the fused function corresponding to each function
+  for (const std::string& fcn : fcns) {
+    const Function& f = get_function(fcn);
+    FusedFun& ff = fused_[fcn];
+    ff.fused = fname;
+    ff.out.resize(f.n_out());
+    for (casadi_int i=0; i<f.n_out(); ++i) {
+      ff.out[i] = ret.index_out(f.name_out(i));
+      casadi_assert(ret.sparsity_out(ff.out[i])==f.sparsity_out(i),
+        "Cannot fuse " + fcn + ": Sparsity mismatch for output " + f.name_out(i));
+    }
+  }
+  return ret;
+}
+
 Function OracleFunction::create_forward(const std::string& fname, casadi_int nfwd) {
   // Create derivative
   Function ret = get_function(fname).forward(nfwd);
@@ -292,6 +334,111 @@ set_function(const Function& fcn, const std::string& fname, bool jit) {
 }
 
 
+  int OracleFunction::calc_functions(OracleMemory* m, const std::vector<std::string>& fcns,
+    const std::vector<std::vector<const double*> >& arg,
+    const std::vector<std::vector<double*> >& res) const {
+  casadi_assert_dev(arg.size()==fcns.size() && res.size()==fcns.size());
+  casadi_int n_thread = std::min(static_cast<casadi_int>(max_num_threads_),
+                                 static_cast<casadi_int>(fcns.size()));
+
+  // Return flag for each function
+  std::vector<int> flag(fcns.size(), 0);
+  // Exception raised in each thread
+  std::vector<std::exception_ptr> ex(n_thread);
+
+  // Evaluate the functions assigned to a thread, using its local memory
+  auto eval_thread = [&](casadi_int t) {
+    auto ml = m->thread_local_mem.at(t);
+    try {
+      for (casadi_int j=t; j<fcns.size(); j+=n_thread) {
+        std::copy(res[j].begin(), res[j].end(), ml->res);
+        flag[j] = calc_function(m, fcns[j], get_ptr(arg[j]), t);
+      }
+    } catch (...) {
+      ex[t] = std::current_exception();
+    }
+  };
+
+#ifdef CASADI_WITH_THREAD
+  std::vector<std::thread> threads;
+  threads.reserve(n_thread-1);
+  for (casadi_int t=1; t<n_thread; ++t) threads.emplace_back(eval_thread, t);
+  eval_thread(0);
+  for (auto&& th : threads) th.join();
+#else // CASADI_WITH_THREAD
+  eval_thread(0);
+#endif // CASADI_WITH_THREAD
+
+  // Propagate errors
+  for (auto&& e : ex) {
+    if (e) std::rethrow_exception(e);
+  }
+  for (int f : flag) {
+    if (f) return f;
+  }
+  return 0;
+}
+
+int OracleFunction::calc_fused(OracleMemory* m, const std::string& fcn, const FusedFun& ff,
+    int thread_id) const {
+  auto ml = m->thread_local_mem.at(thread_id);
+  const Function& f = get_function(fcn);
+  const Function& fused = get_function(ff.fused);
+  LocalOracleMemory::FusedCache& c = ml->fused[ff.fused];
+
+  // Timings are recorded for the requested function, whether or not served from the cache
+  ScopedTiming tic(ml->fstats.at(fcn));
+
+  // Cache hit if inputs unchanged since last evaluation
+  bool hit = c.valid;
+  casadi_int offset = 0;
+  for (casadi_int i=0; i<f.n_in() && hit; ++i) {
+    const double* a = ml->arg[i];
+    for (casadi_int k=0; k<f.nnz_in(i) && hit; ++k) {
+      hit = c.in[offset++] == (a ? a[k] : 0);
+    }
+  }
+
+  // Offsets of the fused outputs in the cache
+  std::vector<casadi_int> out_offset(fused.n_out()+1, 0);
+  for (casadi_int j=0; j<fused.n_out(); ++j) {
+    out_offset[j+1] = out_offset[j] + fused.nnz_out(j);
+  }
+
+  if (!hit) {
+    // Save inputs
+    c.valid = false;
+    c.in.resize(f.nnz_in());
+    offset = 0;
+    for (casadi_int i=0; i<f.n_in(); ++i) {
+      const double* a = ml->arg[i];
+      if (a) {
+        std::copy_n(a, f.nnz_in(i), c.in.begin()+offset);
+      } else {
+        std::fill_n(c.in.begin()+offset, f.nnz_in(i), 0);
+      }
+      offset += f.nnz_in(i);
+    }
+
+    // Evaluate fused function, outputs to cache
+    c.out.resize(out_offset.back());
+    std::vector<double*> res(ml->res, ml->res+fused.n_out());
+    for (casadi_int j=0; j<fused.n_out(); ++j) ml->res[j] = get_ptr(c.out)+out_offset[j];
+    int flag = calc_function(m, ff.fused, nullptr, thread_id);
+    std::copy(res.begin(), res.end(), ml->res);
+    if (flag) return flag;
+    c.valid = true;
+  }
+
+  // Copy requested outputs from the cache
+  for (casadi_int i=0; i<f.n_out(); ++i) {
+    if (ml->res[i]) {
+      std::copy_n(c.out.begin()+out_offset[ff.out[i]], f.nnz_out(i), ml->res[i]);
+    }
+  }
+  return 0;
+}
+
   void OracleFunction::codegen_body_enter(CodeGenerator& g) const {
     g.local("d_oracle", "struct casadi_oracle_data");
   }
@@ -302,6 +449,19 @@ set_function(const Function& fcn, const std::string& fname, bool jit) {
 int OracleFunction::
 calc_function(OracleMemory* m, const std::string& fcn,
               const double* const* arg, int thread_id) const {
+  // Served by a fused function?
+  if (!fused_.empty()) {
+    auto it = fused_.find(fcn);
+    if (it!=fused_.end()) {
+      if (arg) {
+        auto ml = m->thread_local_mem.at(thread_id);
+        casadi_int n_in = get_function(fcn).n_in();
+        for (casadi_int i=0; i<n_in; ++i) ml->arg[i] = *arg++;
+      }
+      return calc_fused(m, fcn, it->second, thread_id);
+    }
+  }
+
   auto ml = m->thread_local_mem.at(thread_id);
   // Is the function monitored?
   bool monitored = this->monitored(fcn);
@@ -517,6 +677,7 @@ void OracleFunction::set_temp(void* mem, const double** arg, double** res,
   for (int i = 0; i < max_num_threads_; ++i) {
     auto* ml = m->thread_local_mem[i];
     for (auto&& s : ml->fstats) s.second.reset();
+    for (auto&& c : ml->fused) c.second.valid = false;
     ml->arg = arg;
     ml->res = res;
     ml->iw = iw;
@@ -561,7 +722,7 @@ bool OracleFunction::has_function(const std::string& fname) const {
 void OracleFunction::serialize_body(SerializingStream &s) const {
   FunctionInternal::serialize_body(s);
 
-  s.version("OracleFunction", 3);
+  s.version("OracleFunction", 4);
   s.pack("OracleFunction::oracle", oracle_);
   s.pack("OracleFunction::common_options", common_options_);
   s.pack("OracleFunction::specific_options", specific_options_);
@@ -591,12 +752,18 @@ void OracleFunction::serialize_body(SerializingStream &s) const {
   s.pack("OracleFunction::stride_res", stride_res_);
   s.pack("OracleFunction::stride_iw", stride_iw_);
   s.pack("OracleFunction::stride_w", stride_w_);
+  s.pack("OracleFunction::fused::size", fused_.size());
+  for (auto &e : fused_) {
+    s.pack("OracleFunction::fused::key", e.first);
+    s.pack("OracleFunction::fused::value::fused", e.second.fused);
+    s.pack("OracleFunction::fused::value::out", e.second.out);
+  }
 
 }
 
 OracleFunction::OracleFunction(DeserializingStream& s) : FunctionInternal(s) {
 
-  int version = s.version("OracleFunction", 1, 3);
+  int version = s.version("OracleFunction", 1, 4);
   s.unpack("OracleFunction::oracle", oracle_);
   s.unpack("OracleFunction::common_options", common_options_);
   s.unpack("OracleFunction::specific_options", specific_options_);
@@ -648,6 +815,16 @@ OracleFunction::OracleFunction(DeserializingStream& s) : FunctionInternal(s) {
     stride_iw_ = 0;
     stride_w_ = 0;
   }
+  if (version>=4) {
+    s.unpack("OracleFunction::fused::size", size);
+    for (casadi_int i=0;i<size;++i) {
+      std::string key;
+      s.unpack("OracleFunction::fused::key", key);
+      FusedFun& ff = fused_[key];
+      s.unpack("OracleFunction::fused::value::fused", ff.fused);
+      s.unpack("OracleFunction::fused::value::out", ff.out);
+    }
+  }
   post_expand_ = false;
 }
 
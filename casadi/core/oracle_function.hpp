@@ -53,6 +53,13 @@ namespace casadi {
     double** res;
     casadi_int* iw;
     double* w;
+
+    // Inputs and outputs of the last evaluation of a fused function
+    struct FusedCache {
+      bool valid = false;
+      std::vector<double> in, out;
+    };
+    std::map<std::string, FusedCache> fused;
   };
 
   /** \brief Function memory
@@ -103,6 +110,15 @@ namespace casadi {
     // All NLP functions
     std::map<std::string, RegFun> all_functions_;
 
+    // Function whose outputs are calculated by a fused function
+    struct FusedFun {
+      std::string fused;
+      std::vector<casadi_int> out;
+    };
+
+    // Functions served from the cached outputs of a fused function
+    std::map<std::string, FusedFun> fused_;
+
     // Active monitors
     std::vector<std::string> monitor_;
 
@@ -173,6 +189,12 @@ namespace casadi {
       const std::vector<std::string>& s_out,
       const Dict& opts=Dict());
 
+    /** Create an oracle function calculating the outputs of several oracle functions
+     * with the same inputs in one pass. Subsequent calls to any of these functions
+     * with unchanged inputs are served from the cached outputs.
+     */
+    Function fuse_functions(const std::string& fname, const std::vector<std::string>& fcns);
+
     /** Create an oracle function as a forward derivative of a different function */
     Function create_forward(const std::string& fname, casadi_int nfwd);
 
@@ -186,6 +208,17 @@ namespace casadi {
     int calc_function(OracleMemory* m, const std::string& fcn,
       const double* const* arg=nullptr, int thread_id=0) const;
 
+    /** Calculate several oracle functions concurrently, each on its own thread-local
+     * memory. Returns the first nonzero return flag, in the order of fcns.
+     */
+    int calc_functions(OracleMemory* m, const std::vector<std::string>& fcns,
+      const std::vector<std::vector<const double*> >& arg,
+      const std::vector<std::vector<double*> >& res) const;
+
+    // Calculate an oracle function using the cache of a fused function
+    int calc_fused(OracleMemory* m, const std::string& fcn, const FusedFun& ff,
+      int thread_id) const;
+
     // Forward sparsity propagation through a function
     int calc_sp_forward(const std::string& fcn, const bvec_t** arg, bvec_t** res,
       casadi_int* iw, bvec_t* w) const;
@@ -47,3 +47,49 @@ void casadi_bfgs_reset(const casadi_int* sp_h, T1* h) {
     }
   }
 }
+
+// SYMBOL "block_bfgs"
+// BFGS update of a block-diagonal matrix with dense blocks, stored block after block
+template<typename T1>
+void casadi_block_bfgs(casadi_int nblock, const casadi_int* offset, T1* h, const T1* dx,
+                       const T1* glag, const T1* glag_old, T1* w) {
+  // Local variables
+  casadi_int b, n, i, j;
+  T1 *yk, *qk, dxBkdx, dxyk, omega, theta, phi;
+  // Work vectors
+  yk = w;
+  for (b=0; b<nblock; ++b) {
+    // Block dimension
+    n = offset[b+1] - offset[b];
+    qk = yk + n;
+    // Skip blocks that are not affected by the step
+    if (casadi_dot(n, dx, dx) > 0) {
+      // yk = glag - glag_old
+      casadi_copy(glag, n, yk);
+      casadi_axpy(n, -1., glag_old, yk);
+      // qk = H*dx
+      casadi_clear(qk, n);
+      for (j=0; j<n; ++j) {
+        for (i=0; i<n; ++i) qk[i] += h[i + j*n] * dx[j];
+      }
+      // Damping
+      dxBkdx = casadi_dot(n, dx, qk);
+      dxyk = casadi_dot(n, dx, yk);
+      omega = if_else(dxyk < 0.2 * dxBkdx, 0.8 * dxBkdx / (dxBkdx - dxyk), 1);
+      // yk = omega * yk + (1 - omega) * qk;
+      casadi_scal(n, omega, yk);
+      casadi_axpy(n, 1 - omega, qk, yk);
+      theta = 1. / casadi_dot(n, dx, yk);
+      phi = 1. / dxBkdx;
+      // Update H
+      for (j=0; j<n; ++j) {
+        for (i=0; i<n; ++i) h[i + j*n] += theta * yk[i] * yk[j] - phi * qk[i] * qk[j];
+      }
+    }
+    // Next block
+    h += n*n;
+    dx += n;
+    glag += n;
+    glag_old += n;
+  }
+}
@@ -516,7 +516,7 @@ FMI3_Export fmi3Status fmi3GetContinuousStates(
   return fmi3GetFloat64(instance, x_vr, N_X, continuousStates, nContinuousStates);
 }
 
-fmi3Status fmi3GetDirectionalDerivative(
+FMI3_Export fmi3Status fmi3GetDirectionalDerivative(
     fmi3Instance instance,
     const fmi3ValueReference unknowns[],
     size_t nUnknowns,
@@ -572,23 +572,22 @@ fmi3Status fmi3GetDirectionalDerivative(
   // Consistency check
   if (val_ind != nSensitivity) return fmi3Fatal;
   // Clear derivative seeds
-  val_ind = 0;
   for (i = 0; i < nKnowns; ++i) {
-    // Get variable
-    vr = knowns[i];
-    // Get offset, size of variable
-    var_off = var_offset[vr];
-    var_sz = var_offset[vr + 1] - var_off;
-    // Clear elements
+    var_off = var_offset[knowns[i]];
+    var_sz = var_offset[knowns[i] + 1] - var_off;
     for (j = 0; j < var_sz; ++j) m->d[var_off + j] = 0;
   }
+  // Clear sensitivities that were calculated but not requested
+  for (i = 0; i < N_X; ++i) m->d[xdot_vr[i]] = 0;
+  for (i = 0; i < N_Y; ++i) m->d[y_vr[i]] = 0;
+  for (i = 0; i < N_ZERO; ++i) m->d[zero_vr[i]] = 0;
   // Check for evaluation error
   if (flag) return fmi3Error;
   // Successful return
   return fmi3OK;
 }
 
-fmi3Status fmi3GetAdjointDerivative(
+FMI3_Export fmi3Status fmi3GetAdjointDerivative(
     fmi3Instance instance,
     const fmi3ValueReference unknowns[],
     size_t nUnknowns,
@@ -644,16 +643,15 @@ fmi3Status fmi3GetAdjointDerivative(
   // Consistency check
   if (val_ind != nSensitivity) return fmi3Fatal;
   // Clear derivative seeds
-  val_ind = 0;
   for (i = 0; i < nUnknowns; ++i) {
-    // Get variable
-    vr = unknowns[i];
-    // Get offset, size of variable
-    var_off = var_offset[vr];
-    var_sz = var_offset[vr + 1] - var_off;
-    // Clear elements
+    var_off = var_offset[unknowns[i]];
+    var_sz = var_offset[unknowns[i] + 1] - var_off;
     for (j = 0; j < var_sz; ++j) m->d[var_off + j] = 0;
   }
+  // Clear sensitivities that were calculated but not requested
+  for (i = 0; i < N_X; ++i) m->d[x_vr[i]] = 0;
+  for (i = 0; i < N_P; ++i) m->d[p_vr[i]] = 0;
+  for (i = 0; i < N_U; ++i) m->d[u_vr[i]] = 0;
   // Check for evaluation error
   if (flag) return fmi3Error;
   // Successful return
@@ -83,6 +83,12 @@ struct casadi_qrqp_data {
   casadi_int *iw, *neverzero, *neverlower, *neverupper, *lincomb;
   // Numeric QR factorization
   T1 *nz_at, *nz_kkt, *beta, *nz_v, *nz_r;
+  // KKT matrix corresponding to the current factorization (null if not kept)
+  T1 *kkt_fact;
+  // Is kkt_fact up-to-date?
+  int fact_valid;
+  // Number of factorizations, number of reused factorizations
+  casadi_int n_fact, n_reuse;
   // Message buffer
   const char *msg;
   // Message index
@@ -177,6 +183,9 @@ void casadi_qrqp_init(casadi_qrqp_data<T1>* d, casadi_int** iw, T1** w) {
   d->iw = *iw;
 
   d->nz_r = d->nz_v + nnz_v;
+  // Factorizations are not kept between calls by default
+  d->kkt_fact = 0;
+  d->fact_valid = 0;
 }
 
 // SYMBOL "qrqp_reset"
@@ -218,6 +227,9 @@ int casadi_qrqp_reset(casadi_qrqp_data<T1>* d) {
   d->r_sign = 0;
   // Reset iteration counter
   d->iter = 0;
+  // Reset factorization counters
+  d->n_fact = 0;
+  d->n_reuse = 0;
   return 0;
 }
 
@@ -697,6 +709,8 @@ int casadi_qrqp_flip_check(casadi_qrqp_data<T1>* d) {
 // SYMBOL "qrqp_factorize"
 template<typename T1>
 void casadi_qrqp_factorize(casadi_qrqp_data<T1>* d) {
+  // Local variables
+  casadi_int k, nnz_kkt;
   const casadi_qrqp_prob<T1>* p = d->prob;
   // Do we already have a search direction due to lost singularity?
   if (d->has_search_dir) {
@@ -705,9 +719,26 @@ void casadi_qrqp_factorize(casadi_qrqp_data<T1>* d) {
   }
   // Construct the KKT matrix
   casadi_qrqp_kkt(d);
-  // QR factorization
-  casadi_qr(p->sp_kkt, d->nz_kkt, d->w, p->sp_v, d->nz_v, p->sp_r,
-            d->nz_r, d->beta, p->prinv, p->pc);
+  nnz_kkt = p->sp_kkt[2+p->qp->nz]; // kkt_colind[nz]
+  // Is the KKT matrix unchanged since the last factorization?
+  k = nnz_kkt;
+  if (d->kkt_fact && d->fact_valid) {
+    for (k=0; k<nnz_kkt; ++k) if (d->nz_kkt[k] != d->kkt_fact[k]) break;
+  }
+  if (k == nnz_kkt && d->kkt_fact && d->fact_valid) {
+    // Reuse the factorization
+    d->n_reuse++;
+  } else {
+    // Keep a copy of the factorized matrix
+    if (d->kkt_fact) {
+      casadi_copy(d->nz_kkt, nnz_kkt, d->kkt_fact);
+      d->fact_valid = 1;
+    }
+    // QR factorization
+    casadi_qr(p->sp_kkt, d->nz_kkt, d->w, p->sp_v, d->nz_v, p->sp_r,
+              d->nz_r, d->beta, p->prinv, p->pc);
+    d->n_fact++;
+  }
   // Check singularity
   d->sing = casadi_qr_singular(&d->mina, &d->imina, d->nz_r, p->sp_r, p->pc, 1e-12);
 }
@@ -827,6 +858,8 @@ int casadi_qrqp_singular_step(casadi_qrqp_data<T1>* d) {
     casadi_copy(d->nz_v, nnz_kkt, d->nz_kkt);
     casadi_qr(p->sp_kkt, d->nz_kkt, d->w, p->sp_v, d->nz_v, p->sp_r, d->nz_r,
               d->beta, p->prinv, p->pc);
+    // The factorization no longer corresponds to kkt_fact
+    d->fact_valid = 0;
     // For all nullspace vectors
     nk = casadi_qr_singular(static_cast<T1*>(0), 0, d->nz_r, p->sp_r, p->pc, 1e-12);
   }
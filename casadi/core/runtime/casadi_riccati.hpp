@@ -0,0 +1,225 @@
+//
+//    MIT No Attribution
+//
+//    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl, KU Leuven.
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//    software and associated documentation files (the "Software"), to deal in the Software
+//    without restriction, including without limitation the rights to use, copy, modify,
+//    merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+//    permit persons to whom the Software is furnished to do so.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//    OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+
+// SYMBOL "riccati_stage"
+struct casadi_riccati_stage {
+  // Number of variables, states of the next stage and non-dynamic constraints
+  casadi_int ny, nx1, ng;
+  // Size of the stage block
+  casadi_int m;
+  // Offset of the stage in the decision variables and in the constraints
+  casadi_int off_z, off_a;
+  // Offsets of the stage block, the x[k+1] diagonal and the right-hand side
+  casadi_int S, e, t;
+  // Offset of the pivots of the stage block
+  casadi_int ipiv;
+};
+// C-REPLACE "casadi_riccati_stage" "struct casadi_riccati_stage"
+
+// SYMBOL "unpack_riccati_stages"
+template<typename T1>
+void casadi_unpack_riccati_stages(casadi_riccati_stage* stages, const casadi_int* packed) {
+  casadi_int k;
+  casadi_int N = *packed++;
+  for (k=0; k<N; ++k) {
+    stages[k].ny = *packed++;
+    stages[k].nx1 = *packed++;
+    stages[k].ng = *packed++;
+    stages[k].m = *packed++;
+    stages[k].off_z = *packed++;
+    stages[k].off_a = *packed++;
+    stages[k].S = *packed++;
+    stages[k].e = *packed++;
+    stages[k].t = *packed++;
+    stages[k].ipiv = *packed++;
+  }
+}
+
+// SYMBOL "riccati_prob"
+template<typename T1>
+struct casadi_riccati_prob {
+  // Sparsity patterns of the Hessian and the constraint Jacobian
+  const casadi_int *sp_h, *sp_a;
+  // Number of stages minus one
+  casadi_int N;
+  // Stage sizes and buffer offsets, length N+1
+  const casadi_riccati_stage* stages;
+  // Destination of the nonzeros of H and A (twice) in the factorization buffer
+  const casadi_int *h_dest, *a_dest;
+  // Size of the factorization buffer
+  casadi_int sz_buf;
+};
+// C-REPLACE "casadi_riccati_prob<T1>" "struct casadi_riccati_prob"
+
+// SYMBOL "riccati_lu"
+template<typename T1>
+int casadi_riccati_lu(casadi_int n, T1* A, casadi_int* ipiv) {
+  casadi_int i, j, c, p;
+  T1 t;
+  for (j=0; j<n; ++j) {
+    // Find pivot
+    p = j;
+    for (i=j+1; i<n; ++i) {
+      if (fabs(A[i + j * n]) > fabs(A[p + j * n])) p = i;
+    }
+    if (!(fabs(A[p + j * n]) > 0)) return 1;
+    ipiv[j] = p;
+    // Swap rows
+    if (p != j) {
+      for (c=0; c<n; ++c) {
+        t = A[j + c * n];
+        A[j + c * n] = A[p + c * n];
+        A[p + c * n] = t;
+      }
+    }
+    // Eliminate below the pivot
+    for (i=j+1; i<n; ++i) A[i + j * n] /= A[j + j * n];
+    for (c=j+1; c<n; ++c) {
+      t = A[j + c * n];
+      if (t == 0) continue;
+      for (i=j+1; i<n; ++i) A[i + c * n] -= A[i + j * n] * t;
+    }
+  }
+  return 0;
+}
+
+// SYMBOL "riccati_lu_solve"
+template<typename T1>
+void casadi_riccati_lu_solve(casadi_int n, const T1* A, const casadi_int* ipiv, T1* b) {
+  casadi_int i, j;
+  T1 t;
+  for (j=0; j<n; ++j) {
+    if (ipiv[j] != j) {
+      t = b[j];
+      b[j] = b[ipiv[j]];
+      b[ipiv[j]] = t;
+    }
+  }
+  for (j=0; j<n; ++j) {
+    for (i=j+1; i<n; ++i) b[i] -= A[i + j * n] * b[j];
+  }
+  for (j=n-1; j>=0; --j) {
+    b[j] /= A[j + j * n];
+    for (i=0; i<j; ++i) b[i] -= A[i + j * n] * b[j];
+  }
+}
+
+// SYMBOL "riccati_factor"
+template<typename T1>
+int casadi_riccati_factor(const casadi_riccati_prob<T1>* p, const T1* h, const T1* a,
+    const T1* S, const T1* D, T1* w, casadi_int* iw) {
+  // Local variables
+  casadi_int i, j, k, c, nx;
+  const casadi_int *h_colind, *h_row, *a_colind, *a_row;
+  const casadi_riccati_stage *s, *s1;
+  T1 t, *buf, *tmp, *Sk;
+  const T1* e;
+  // Extract sparsities
+  nx = p->sp_h[1];
+  h_colind = p->sp_h + 2;
+  h_row = p->sp_h + 2 + nx + 1;
+  a_colind = p->sp_a + 2;
+  a_row = p->sp_a + 2 + nx + 1;
+  // Work vectors
+  buf = w; w += p->sz_buf;
+  tmp = w;
+  // Scatter the scaled KKT matrix to the stage blocks
+  casadi_clear(buf, p->sz_buf);
+  for (c=0; c<nx; ++c) {
+    for (k=h_colind[c]; k<h_colind[c+1]; ++k) {
+      buf[p->h_dest[k]] = h[k] * S[c] * S[h_row[k]];
+    }
+  }
+  for (c=0; c<nx; ++c) {
+    for (k=a_colind[c]; k<a_colind[c+1]; ++k) {
+      t = a[k] * S[c] * S[nx + a_row[k]];
+      buf[p->a_dest[2 * k]] = t;
+      if (p->a_dest[2 * k + 1] >= 0) buf[p->a_dest[2 * k + 1]] = t;
+    }
+  }
+  for (k=0; k<=p->N; ++k) {
+    s = p->stages + k;
+    Sk = buf + s->S;
+    for (i=0; i<s->ny; ++i) Sk[i + i * s->m] += D[s->off_z + i];
+    for (i=s->ny; i<s->m; ++i) Sk[i + i * s->m] = -D[nx + s->off_a + i - s->ny];
+  }
+  // Backward recursion: S_k -= C_k * inv(S_{k+1}) * C_k',
+  // where C_k couples the dynamics multipliers of stage k with x[k+1]
+  for (k=p->N; k>=0; --k) {
+    s = p->stages + k;
+    Sk = buf + s->S;
+    if (k<p->N) {
+      s1 = p->stages + k + 1;
+      e = buf + s->e;
+      for (j=0; j<s->nx1; ++j) {
+        if (e[j] == 0) continue;
+        casadi_clear(tmp, s1->m);
+        tmp[j] = e[j];
+        casadi_riccati_lu_solve(s1->m, buf + s1->S, iw + s1->ipiv, tmp);
+        for (i=0; i<s->nx1; ++i) {
+          Sk[s->ny + i + (s->ny + j) * s->m] -= e[i] * tmp[i];
+        }
+      }
+    }
+    if (casadi_riccati_lu(s->m, Sk, iw + s->ipiv)) return 1;
+  }
+  return 0;
+}
+
+// SYMBOL "riccati_solve"
+template<typename T1>
+void casadi_riccati_solve(const casadi_riccati_prob<T1>* p, T1* r, T1* w, casadi_int* iw) {
+  // Local variables
+  casadi_int j, k, nx;
+  const casadi_riccati_stage *s, *s0, *s1;
+  T1 *buf, *tmp, *t;
+  const T1* e;
+  nx = p->sp_h[1];
+  // Work vectors
+  buf = w; w += p->sz_buf;
+  tmp = w;
+  // Backward recursion for the right-hand side
+  for (k=p->N; k>=0; --k) {
+    s = p->stages + k;
+    t = buf + s->t;
+    casadi_copy(r + s->off_z, s->ny, t);
+    casadi_copy(r + nx + s->off_a, s->nx1 + s->ng, t + s->ny);
+    if (k<p->N) {
+      s1 = p->stages + k + 1;
+      e = buf + s->e;
+      casadi_copy(buf + s1->t, s1->m, tmp);
+      casadi_riccati_lu_solve(s1->m, buf + s1->S, iw + s1->ipiv, tmp);
+      for (j=0; j<s->nx1; ++j) t[s->ny + j] -= e[j] * tmp[j];
+    }
+  }
+  // Forward recursion for the solution
+  for (k=0; k<=p->N; ++k) {
+    s = p->stages + k;
+    t = buf + s->t;
+    if (k>0) {
+      s0 = p->stages + k - 1;
+      e = buf + s0->e;
+      for (j=0; j<s0->nx1; ++j) t[j] -= e[j] * r[nx + s0->off_a + j];
+    }
+    casadi_riccati_lu_solve(s->m, buf + s->S, iw + s->ipiv, t);
+    casadi_copy(t, s->ny, r + s->off_z);
+    casadi_copy(t + s->ny, s->nx1 + s->ng, r + nx + s->off_a);
+  }
+}
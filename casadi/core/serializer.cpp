@@ -32,9 +32,96 @@
 #include "generic_type.hpp"
 #include "filesystem_impl.hpp"
 #include <iomanip>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else // _WIN32
+#include <unistd.h>
+#endif // _WIN32
 
 namespace casadi {
 
+    // Bounded buffer over a file descriptor, flushed and refilled incrementally
+    // Used either for writing or for reading, not both
+    class FdBuffer : public std::streambuf {
+    public:
+      FdBuffer(int fd, size_t size) : fd_(fd), buf_(size) {
+        setp(buf_.data(), buf_.data() + buf_.size());
+        setg(buf_.data(), buf_.data(), buf_.data());
+      }
+    protected:
+      int_type overflow(int_type c) override {
+        if (sync()) return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+          *pptr() = traits_type::to_char_type(c);
+          pbump(1);
+        }
+        return traits_type::not_eof(c);
+      }
+      int sync() override {
+        const char* p = pbase();
+        while (p<pptr()) {
+#ifdef _WIN32
+          auto n = _write(fd_, p, static_cast<unsigned int>(pptr()-p));
+#else // _WIN32
+          auto n = ::write(fd_, p, pptr()-p);
+#endif // _WIN32
+          if (n<0 && errno==EINTR) continue;
+          if (n<=0) return -1;
+          p += n;
+        }
+        setp(buf_.data(), buf_.data() + buf_.size());
+        return 0;
+      }
+      int_type underflow() override {
+        if (gptr()<egptr()) return traits_type::to_int_type(*gptr());
+        for (;;) {
+#ifdef _WIN32
+          auto n = _read(fd_, buf_.data(), static_cast<unsigned int>(buf_.size()));
+#else // _WIN32
+          auto n = ::read(fd_, buf_.data(), buf_.size());
+#endif // _WIN32
+          if (n<0 && errno==EINTR) continue;
+          if (n<=0) return traits_type::eof();
+          setg(buf_.data(), buf_.data(), buf_.data() + n);
+          return traits_type::to_int_type(*gptr());
+        }
+      }
+    private:
+      int fd_;
+      std::vector<char> buf_;
+    };
+
+    // Stream owning its file descriptor buffer
+    class FdStream : public std::iostream {
+    public:
+      FdStream(int fd, size_t size) : std::iostream(nullptr), buf_(fd, size) {
+        rdbuf(&buf_);
+      }
+      ~FdStream() override {
+        buf_.pubsync();
+      }
+    private:
+      FdBuffer buf_;
+    };
+
+    // Stream options without the buffer size
+    static Dict fd_stream_opts(const Dict& opts) {
+      Dict ret = opts;
+      ret.erase("buffer_size");
+      return ret;
+    }
+
+    static FdStream* fd_stream(int fd, const Dict& opts) {
+      casadi_assert(fd>=0, "Invalid file descriptor " + str(fd) + ".");
+      casadi_int size = 1 << 16;
+      auto it = opts.find("buffer_size");
+      if (it!=opts.end()) size = it->second;
+      casadi_assert(size>0, "'buffer_size' must be positive");
+      return new FdStream(fd, size);
+    }
+
     StringSerializer::StringSerializer(const Dict& opts) :
         SerializerBase(std::unique_ptr<std::ostream>(new std::stringstream()), opts) {
     }
@@ -46,6 +133,10 @@ namespace casadi {
           opts) {
     }
 
+    FdSerializer::FdSerializer(int fd, const Dict& opts) :
+        SerializerBase(std::unique_ptr<std::ostream>(fd_stream(fd, opts)), fd_stream_opts(opts)) {
+    }
+
     SerializerBase::SerializerBase(std::unique_ptr<std::ostream> stream, const Dict& opts) :
         sstream_(std::move(stream)),
         serializer_(new SerializingStream(*sstream_, opts)) {
@@ -84,6 +175,23 @@ namespace casadi {
     FileSerializer::~FileSerializer() {
     }
 
+    FdSerializer::~FdSerializer() {
+      // Destructors cannot throw, call flush to catch write errors
+      sstream_->flush();
+      if (!sstream_->good()) {
+        casadi_warning("FdSerializer: Failed to write serialized data, the output is incomplete.");
+      }
+    }
+
+    void FdSerializer::flush() {
+      sstream_->flush();
+      check_stream();
+    }
+
+    void SerializerBase::check_stream() const {
+      casadi_assert(sstream_->good(), "Failed to write serialized data.");
+    }
+
     std::string StringSerializer::encode() {
       std::string ret = static_cast<std::stringstream*>(sstream_.get())->str();
       static_cast<std::stringstream*>(sstream_.get())->str("");
@@ -114,6 +222,11 @@ namespace casadi {
       }
     }
 
+    FdDeserializer::FdDeserializer(int fd, const Dict& opts) :
+        DeserializerBase(std::unique_ptr<std::istream>(fd_stream(fd, opts))) {
+      casadi_assert(fd_stream_opts(opts).empty(), "Only option 'buffer_size' is supported.");
+    }
+
     StringDeserializer::StringDeserializer(const std::string& string) :
         DeserializerBase(std::unique_ptr<std::istream>(
           new std::stringstream(string))) {
@@ -122,6 +235,7 @@ namespace casadi {
     DeserializerBase::~DeserializerBase() { }
     StringDeserializer::~StringDeserializer() { }
     FileDeserializer::~FileDeserializer() { }
+    FdDeserializer::~FdDeserializer() { }
 
     SerializingStream& SerializerBase::serializer() {
       return *serializer_;
@@ -143,21 +257,25 @@ namespace casadi {
       serializer().pack(static_cast<char>(SERIALIZED_MX));
       serializer().pack(Function::order({e}));
       serializer().pack(e);
+      check_stream();
     }
     void SerializerBase::pack(const std::vector<MX>& e) {
       serializer().pack(static_cast<char>(SERIALIZED_MX_VECTOR));
       serializer().pack(Function::order(e));
       serializer().pack(e);
+      check_stream();
     }
     void SerializerBase::pack(const SX& e) {
       serializer().pack(static_cast<char>(SERIALIZED_SX));
       serializer().pack(Function::order({e}));
       serializer().pack(e);
+      check_stream();
     }
     void SerializerBase::pack(const std::vector<SX>& e) {
       serializer().pack(static_cast<char>(SERIALIZED_SX_VECTOR));
       serializer().pack(Function::order(e));
       serializer().pack(e);
+      check_stream();
     }
     MX DeserializerBase::blind_unpack_mx() {
       std::vector<MX> sorted;
@@ -264,6 +382,7 @@ namespace casadi {
     void SerializerBase::pack(const Type& e) { \
       serializer().pack(static_cast<char>(SERIALIZED_ ## TYPE));\
       serializer().pack(e); \
+      check_stream(); \
     } \
     \
     Type DeserializerBase::blind_unpack_ ## type() { \
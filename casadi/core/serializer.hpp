@@ -109,6 +109,8 @@ namespace casadi {
 
   protected:
     SerializingStream& serializer();
+    // Raise an error if a write to the stream failed
+    void check_stream() const;
     std::unique_ptr<std::ostream> sstream_;
     std::unique_ptr<SerializingStream> serializer_;
   };
@@ -230,6 +232,26 @@ namespace casadi {
     ~FileSerializer();
   };
 
+  class CASADI_EXPORT FdSerializer : public SerializerBase {
+  public:
+    /** \brief Serialization of CasADi objects to an open file descriptor
+     *
+     * Writes go through a bounded buffer of "buffer_size" bytes that is flushed
+     * incrementally, so that e.g. a pipe or socket can be fed without holding the
+     * serialized objects in memory. The descriptor is not closed.
+     *
+     * \see FdDeserializer, FileSerializer
+
+        \identifier{2f0} */
+    FdSerializer(int fd, const Dict& opts = Dict());
+    ~FdSerializer();
+
+    /** \brief Write out the buffered data, raises an error if a write failed
+
+        \identifier{2fd} */
+    void flush();
+  };
+
   class CASADI_EXPORT StringDeserializer : public DeserializerBase {
   public:
 
@@ -259,6 +281,20 @@ namespace casadi {
     ~FileDeserializer();
   };
 
+  class CASADI_EXPORT FdDeserializer : public DeserializerBase {
+  public:
+    /** \brief Deserialization of CasADi objects from an open file descriptor
+     *
+     * Reads go through a bounded buffer of "buffer_size" bytes.
+     * The descriptor is not closed.
+     *
+     * \see FdSerializer
+
+        \identifier{2f1} */
+    FdDeserializer(int fd, const Dict& opts = Dict());
+    ~FdDeserializer();
+  };
+
 } // namespace casadi
 
 #endif // CASADI_SERIALIZER_HPP
@@ -42,9 +42,22 @@
 namespace casadi {
 
     static casadi_int serialization_protocol_version = 3;
+    // Same structure, but raw bytes and numeric arrays written as blocks
+    static casadi_int serialization_protocol_version_bulk = 4;
     static casadi_int serialization_check = 123456789012345;
 
-    DeserializingStream::DeserializingStream(std::istream& in_s) : in(in_s), debug_(false) {
+    // FNV-1a checksum of a raw block
+    static uint32_t block_checksum(const char* c, size_t n) {
+      uint32_t h = 2166136261u;
+      for (size_t i=0; i<n; ++i) {
+        h ^= static_cast<unsigned char>(c[i]);
+        h *= 16777619u;
+      }
+      return h;
+    }
+
+    DeserializingStream::DeserializingStream(std::istream& in_s) :
+        in(in_s), debug_(false), bulk_(false) {
 
       casadi_assert(in_s.good(), "Invalid input stream. If you specified an input file, "
         "make sure it exists relative to the current directory.");
@@ -66,10 +79,12 @@ namespace casadi {
       // API version check
       casadi_int v;
       unpack(v);
-      casadi_assert(v==serialization_protocol_version,
+      casadi_assert(v==serialization_protocol_version || v==serialization_protocol_version_bulk,
         "Serialization protocol is not compatible. "
         "Got version " + str(v) + ", while " +
-        str(serialization_protocol_version) + " was expected.");
+        str(serialization_protocol_version) + " or " +
+        str(serialization_protocol_version_bulk) + " was expected.");
+      bulk_ = v==serialization_protocol_version_bulk;
 
       bool debug;
       unpack(debug);
@@ -82,23 +97,27 @@ namespace casadi {
     }
 
     SerializingStream::SerializingStream(std::ostream& out_s, const Dict& opts) :
-        out(out_s), debug_(false) {
-      // Sanity check
-      pack(serialization_check);
-      // API version check
-      pack(casadi_int(serialization_protocol_version));
-
-      bool debug = false;
+        out(out_s), debug_(false), bulk_(false) {
+      bool debug = false, bulk = false;
 
       // Read options
       for (auto&& op : opts) {
         if (op.first=="debug") {
           debug = op.second;
+        } else if (op.first=="bulk") {
+          bulk = op.second;
         } else {
           casadi_error("Unknown option: '" + op.first + "'.");
         }
       }
 
+      // Sanity check
+      pack(serialization_check);
+      // API version check
+      pack(bulk ? serialization_protocol_version_bulk : serialization_protocol_version);
+      // Everything after the version is written raw in bulk mode
+      bulk_ = bulk;
+
       pack(debug);
       debug_ = debug;
     }
@@ -120,7 +139,7 @@ namespace casadi {
       int64_t n;
       char* c = reinterpret_cast<char*>(&n);
 
-      for (int j=0;j<8;++j) unpack(c[j]);
+      unpack_bytes(c, 8);
       e = n;
     }
 
@@ -128,14 +147,14 @@ namespace casadi {
       decorate('J');
       int64_t n = e;
       const char* c = reinterpret_cast<const char*>(&n);
-      for (int j=0;j<8;++j) pack(c[j]);
+      pack_bytes(c, 8);
     }
 
     void SerializingStream::pack(size_t e) {
       decorate('K');
       uint64_t n = e;
       const char* c = reinterpret_cast<const char*>(&n);
-      for (int j=0;j<8;++j) pack(c[j]);
+      pack_bytes(c, 8);
     }
 
     void DeserializingStream::unpack(size_t& e) {
@@ -143,7 +162,7 @@ namespace casadi {
       uint64_t n;
       char* c = reinterpret_cast<char*>(&n);
 
-      for (int j=0;j<8;++j) unpack(c[j]);
+      unpack_bytes(c, 8);
       e = n;
     }
 
@@ -152,7 +171,7 @@ namespace casadi {
       int32_t n;
       char* c = reinterpret_cast<char*>(&n);
 
-      for (int j=0;j<4;++j) unpack(c[j]);
+      unpack_bytes(c, 4);
       e = n;
     }
 
@@ -160,7 +179,7 @@ namespace casadi {
       decorate('i');
       int32_t n = e;
       const char* c = reinterpret_cast<const char*>(&n);
-      for (int j=0;j<4;++j) pack(c[j]);
+      pack_bytes(c, 4);
     }
 
 #if SIZE_MAX != UINT_MAX || defined(__EMSCRIPTEN__) || defined(__POWERPC__)
@@ -169,7 +188,7 @@ namespace casadi {
       uint32_t n;
       char* c = reinterpret_cast<char*>(&n);
 
-      for (int j=0;j<4;++j) unpack(c[j]);
+      unpack_bytes(c, 4);
       e = n;
     }
 
@@ -177,7 +196,7 @@ namespace casadi {
       decorate('u');
       uint32_t n = e;
       const char* c = reinterpret_cast<const char*>(&n);
-      for (int j=0;j<4;++j) pack(c[j]);
+      pack_bytes(c, 4);
     }
 #endif
 
@@ -194,6 +213,10 @@ namespace casadi {
     }
 
     void DeserializingStream::unpack(char& e) {
+      if (bulk_) {
+        in.get(e);
+        return;
+      }
       unsigned char ref = 'a';
       in.get(e);
       char t;
@@ -203,6 +226,10 @@ namespace casadi {
     }
 
     void SerializingStream::pack(char e) {
+      if (bulk_) {
+        out.put(e);
+        return;
+      }
       unsigned char ref = 'a';
       // Note: outputstreams work neatly with std::hex,
       // but inputstreams don't
@@ -210,12 +237,53 @@ namespace casadi {
       out.put(ref + (reinterpret_cast<unsigned char&>(e) >> 4));
     }
 
+    void SerializingStream::pack_bytes(const char* c, size_t n) {
+      if (bulk_) {
+        out.write(c, n);
+      } else {
+        for (size_t j=0; j<n; ++j) pack(c[j]);
+      }
+    }
+
+    void DeserializingStream::unpack_bytes(char* c, size_t n) {
+      if (bulk_) {
+        in.read(c, n);
+      } else {
+        for (size_t j=0; j<n; ++j) unpack(c[j]);
+      }
+    }
+
+    void SerializingStream::pack_block(const char* c, size_t n) {
+      casadi_assert(bulk_, "Raw blocks require a stream in bulk mode");
+      decorate('A');
+      pack(n);
+      out.write(c, n);
+      uint32_t h = block_checksum(c, n);
+      pack_bytes(reinterpret_cast<const char*>(&h), 4);
+    }
+
+    void DeserializingStream::unpack_block(char* c, size_t n) {
+      casadi_assert(bulk_, "Raw blocks require a stream in bulk mode");
+      assert_decoration('A');
+      size_t len;
+      unpack(len);
+      casadi_assert(len==n, "DeserializingStream error: Block of " + str(len) + " bytes, "
+        "expected " + str(n) + ".");
+      in.read(c, n);
+      casadi_assert(static_cast<size_t>(in.gcount())==n,
+        "DeserializingStream error: Unexpected end of stream in block of " + str(n) + " bytes.");
+      uint32_t h;
+      unpack_bytes(reinterpret_cast<char*>(&h), 4);
+      casadi_assert(h==block_checksum(c, n),
+        "DeserializingStream error: Checksum mismatch in block of " + str(n) + " bytes, "
+        "the data is corrupted.");
+    }
+
     void SerializingStream::pack(const std::string& e) {
       decorate('s');
       int s = static_cast<int>(e.size());
       pack(s);
-      const char* c = e.c_str();
-      for (int j = 0; j < s; ++j) pack(c[j]);
+      pack_bytes(e.c_str(), s);
     }
 
     void DeserializingStream::unpack(std::string& e) {
@@ -223,19 +291,19 @@ namespace casadi {
       int s;
       unpack(s);
       e.resize(s);
-      for (int j=0;j<s;++j) unpack(e[j]);
+      if (s) unpack_bytes(&e[0], s);
     }
 
     void DeserializingStream::unpack(double& e) {
       assert_decoration('d');
       char* c = reinterpret_cast<char*>(&e);
-      for (int j=0;j<8;++j) unpack(c[j]);
+      unpack_bytes(c, 8);
     }
 
     void SerializingStream::pack(double e) {
       decorate('d');
       const char* c = reinterpret_cast<const char*>(&e);
-      for (int j=0;j<8;++j) pack(c[j]);
+      pack_bytes(c, 8);
     }
 
     void SerializingStream::pack(const Sparsity& e) {
@@ -260,11 +328,21 @@ namespace casadi {
 
     void SerializingStream::pack(const Function& e) {
       decorate('F');
+      if (archiver_) {
+        pack("Function::archive_entry", e.is_null() ? casadi_int(-1) : archiver_(e));
+        return;
+      }
       shared_pack(e);
     }
 
     void DeserializingStream::unpack(Function& e) {
       assert_decoration('F');
+      if (unarchiver_) {
+        casadi_int k;
+        unpack("Function::archive_entry", k);
+        e = k<0 ? Function() : unarchiver_(k);
+        return;
+      }
       shared_unpack<Function, FunctionInternal>(e);
     }
 
@@ -328,9 +406,7 @@ namespace casadi {
       for (size_t i=0;i<len;++i) {
         s.read(buffer, 1024);
         size_t c = s.gcount();
-        for (size_t j=0;j<c;++j) {
-          pack(buffer[j]);
-        }
+        pack_bytes(buffer, c);
         if (s.rdstate() & std::ifstream::eofbit) break;
       }
     }
@@ -339,10 +415,11 @@ namespace casadi {
       assert_decoration('B');
       size_t len;
       unpack(len);
-      for (size_t i=0;i<len;++i) {
-        char c;
-        unpack(c);
-        s.put(c);
+      char buffer[1024];
+      for (size_t i=0;i<len;i+=1024) {
+        size_t c = std::min(len-i, static_cast<size_t>(1024));
+        unpack_bytes(buffer, c);
+        s.write(buffer, c);
       }
     }
 
@@ -31,6 +31,8 @@
 #include <unordered_map>
 #include <cstdint>
 #include <climits>
+#include <type_traits>
+#include <functional>
 
 namespace casadi {
   class Slice;
@@ -64,6 +66,13 @@ namespace casadi {
   };
   typedef std::map<std::string, GenericType> Dict;
 
+  /// Vector element types written as raw blocks in bulk mode: in-memory size equals wire size
+  template <class T>
+  struct is_bulk_serializable : std::integral_constant<bool,
+    (std::is_same<T, double>::value && sizeof(T)==8) ||
+    (std::is_same<T, casadi_int>::value && sizeof(T)==8) ||
+    (std::is_same<T, int>::value && sizeof(T)==4)> {};
+
   /** \brief Helper class for Serialization
 
       \author Joris Gillis
@@ -118,7 +127,7 @@ namespace casadi {
       casadi_int s;
       unpack(s);
       e.resize(s);
-      for (T& i : e) unpack(i);
+      unpack_elements(e, is_bulk_serializable<T>());
     }
 
     template <class K, class V>
@@ -158,10 +167,51 @@ namespace casadi {
     int version(const std::string& name);
     int version(const std::string& name, int min, int max);
 
+    /** \brief Unpack a contiguous array written with SerializingStream::pack_raw
+
+        \identifier{2ef} */
+    template <class T>
+    void unpack_raw(T* e, size_t n) {
+      static_assert(std::is_trivially_copyable<T>::value, "Raw blocks need POD elements");
+      unpack_block(reinterpret_cast<char*>(e), n*sizeof(T));
+    }
+
+    /// Stream written in bulk mode (raw bytes, numeric arrays as blocks)?
+    bool bulk() const { return bulk_;}
+
+    /** \brief Resolve nested Functions through an archive
+
+        Nested Functions are read as archive entry indices and handed to \a unarchiver
+
+        \identifier{2eh} */
+    void set_unarchiver(const std::function<Function(casadi_int)>& unarchiver) {
+      unarchiver_ = unarchiver;
+    }
+
     void connect(SerializingStream & s);
     void reset();
 
   private:
+    // Unpack vector elements one by one, or as a raw block in bulk mode
+    template <class T>
+    void unpack_elements(std::vector<T>& e, std::false_type) {
+      for (T& i : e) unpack(i);
+    }
+    template <class T>
+    void unpack_elements(std::vector<T>& e, std::true_type) {
+      if (bulk_) {
+        unpack_raw(e.data(), e.size());
+      } else {
+        for (T& i : e) unpack(i);
+      }
+    }
+
+    // Read n bytes, encoded unless in bulk mode
+    void unpack_bytes(char* c, size_t n);
+
+    // Read a raw block of n bytes, checking size and checksum
+    void unpack_block(char* c, size_t n);
+
 
     /** \brief Unpacks a shared object
     *
@@ -205,6 +255,10 @@ namespace casadi {
     std::istream& in;
     /// Debug mode?
     bool debug_;
+    /// Bulk mode?
+    bool bulk_;
+    /// Archive mode: maps entry indices to Functions
+    std::function<Function(casadi_int)> unarchiver_;
     /// Did setup ran?
     bool set_up_ = false;
   };
@@ -256,7 +310,7 @@ namespace casadi {
     void pack(const std::vector<T>& e) {
       decorate('V');
       pack(static_cast<casadi_int>(e.size()));
-      for (auto&& i : e) pack(i);
+      pack_elements(e, is_bulk_serializable<T>());
     }
     template <class K, class V>
     void pack(const std::map<K, V>& e) {
@@ -287,10 +341,55 @@ namespace casadi {
 
     void version(const std::string& name, int v);
 
+    /** \brief Pack a contiguous array of POD elements as one raw block
+
+        Only in bulk mode: a size header, the bytes as in memory (little-endian on
+        all supported platforms) and a checksum
+
+        \identifier{2eg} */
+    template <class T>
+    void pack_raw(const T* e, size_t n) {
+      static_assert(std::is_trivially_copyable<T>::value, "Raw blocks need POD elements");
+      pack_block(reinterpret_cast<const char*>(e), n*sizeof(T));
+    }
+
+    /// Writing in bulk mode (raw bytes, numeric arrays as blocks)?
+    bool bulk() const { return bulk_;}
+
+    /** \brief Write nested Functions as archive entries
+
+        Instead of being written inline, nested Functions are handed to \a archiver,
+        which returns the index of the archive entry to refer to
+
+        \identifier{2ei} */
+    void set_archiver(const std::function<casadi_int(const Function&)>& archiver) {
+      archiver_ = archiver;
+    }
+
     void connect(DeserializingStream & s);
     void reset();
 
   private:
+    // Pack vector elements one by one, or as a raw block in bulk mode
+    template <class T>
+    void pack_elements(const std::vector<T>& e, std::false_type) {
+      for (auto&& i : e) pack(i);
+    }
+    template <class T>
+    void pack_elements(const std::vector<T>& e, std::true_type) {
+      if (bulk_) {
+        pack_raw(e.data(), e.size());
+      } else {
+        for (auto&& i : e) pack(i);
+      }
+    }
+
+    // Write n bytes, encoded unless in bulk mode
+    void pack_bytes(const char* c, size_t n);
+
+    // Write a raw block of n bytes with size header and checksum
+    void pack_block(const char* c, size_t n);
+
     /** \brief Insert information for a primitive typecheck during deserialization
      *
      * No-op unless in debug mode
@@ -326,6 +425,10 @@ namespace casadi {
     std::ostream& out;
     /// Debug mode?
     bool debug_;
+    /// Bulk mode?
+    bool bulk_;
+    /// Archive mode: maps Functions to entry indices
+    std::function<casadi_int(const Function&)> archiver_;
   };
 
   template <>
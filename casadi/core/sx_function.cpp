@@ -1845,12 +1845,17 @@ namespace casadi {
     }
 
     algorithm_.resize(n_instructions);
-    for (casadi_int k=0;k<n_instructions;++k) {
-      AlgEl& e = algorithm_[k];
-      s.unpack("SXFunction::ScalarAtomic::op", e.op);
-      s.unpack("SXFunction::ScalarAtomic::i0", e.i0);
-      s.unpack("SXFunction::ScalarAtomic::i1", e.i1);
-      s.unpack("SXFunction::ScalarAtomic::i2", e.i2);
+    if (s.bulk()) {
+      // Algorithm as one raw block
+      s.unpack_raw(get_ptr(algorithm_), n_instructions);
+    } else {
+      for (casadi_int k=0;k<n_instructions;++k) {
+        AlgEl& e = algorithm_[k];
+        s.unpack("SXFunction::ScalarAtomic::op", e.op);
+        s.unpack("SXFunction::ScalarAtomic::i0", e.i0);
+        s.unpack("SXFunction::ScalarAtomic::i1", e.i1);
+        s.unpack("SXFunction::ScalarAtomic::i2", e.i2);
+      }
     }
 
     // Default (persistent) options
@@ -1897,12 +1902,16 @@ namespace casadi {
 
     s.pack("SXFunction::copy_elision", copy_elision_);
 
-    // Loop over algorithm
-    for (const auto& e : algorithm_) {
-      s.pack("SXFunction::ScalarAtomic::op", e.op);
-      s.pack("SXFunction::ScalarAtomic::i0", e.i0);
-      s.pack("SXFunction::ScalarAtomic::i1", e.i1);
-      s.pack("SXFunction::ScalarAtomic::i2", e.i2);
+    // Loop over algorithm, or write it as one raw block
+    if (s.bulk()) {
+      s.pack_raw(get_ptr(algorithm_), algorithm_.size());
+    } else {
+      for (const auto& e : algorithm_) {
+        s.pack("SXFunction::ScalarAtomic::op", e.op);
+        s.pack("SXFunction::ScalarAtomic::i0", e.i0);
+        s.pack("SXFunction::ScalarAtomic::i1", e.i1);
+        s.pack("SXFunction::ScalarAtomic::i2", e.i2);
+      }
     }
 
     s.pack("SXFunction::live_variables", live_variables_);
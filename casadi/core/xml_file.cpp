@@ -49,6 +49,10 @@ XmlNode XmlFile::parse(const std::string& filename) {
   return (*this)->parse(filename);
 }
 
+XmlNode XmlFile::parse_root(const std::string& filename) {
+  return (*this)->parse_root(filename);
+}
+
 void XmlFile::dump(const std::string& filename, const XmlNode& node) {
   return (*this)->dump(filename, node);
 }
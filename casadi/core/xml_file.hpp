@@ -82,6 +82,9 @@ namespace casadi {
     // Parse an XML file
     XmlNode parse(const std::string& filename);
 
+    // Parse the root element of an XML file, without its children
+    XmlNode parse_root(const std::string& filename);
+
     // Save an XML file to disk
     void dump(const std::string& filename, const XmlNode& node);
 
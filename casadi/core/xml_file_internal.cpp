@@ -49,6 +49,11 @@ XmlNode XmlFileInternal::parse(const std::string& filename) {
   return XmlNode();
 }
 
+XmlNode XmlFileInternal::parse_root(const std::string& filename) {
+  casadi_error("parse_root not defined for " + class_name());
+  return XmlNode();
+}
+
 void XmlFileInternal::dump(const std::string& filename, const XmlNode& node) {
   casadi_error("dump not defined for " + class_name());
 }
@@ -50,6 +50,9 @@ namespace casadi {
     // Parse an XML file
     virtual XmlNode parse(const std::string& filename);
 
+    // Parse the root element of an XML file, without its children
+    virtual XmlNode parse_root(const std::string& filename);
+
     // Save a parsed XML file to disk
     virtual void dump(const std::string& filename, const XmlNode& node);
 
@@ -25,6 +25,9 @@
 
 #include "xml_node.hpp"
 #include "casadi_misc.hpp"
+#include "serializing_stream.hpp"
+
+#include <cstdlib>
 
 namespace casadi {
 
@@ -123,13 +126,11 @@ void XmlNode::read(const std::string& str, bool* val) {
 }
 
 void XmlNode::read(const std::string& str, size_t* val) {
-  std::istringstream buffer(str);
-  buffer >> *val;
+  *val = static_cast<size_t>(std::strtoull(str.c_str(), nullptr, 10));
 }
 
 void XmlNode::read(const std::string& str, casadi_int* val) {
-  std::istringstream buffer(str);
-  buffer >> *val;
+  *val = static_cast<casadi_int>(std::strtoll(str.c_str(), nullptr, 10));
 }
 
 void XmlNode::read(const std::string& str, double* val) {
@@ -138,13 +139,15 @@ void XmlNode::read(const std::string& str, double* val) {
 }
 
 void XmlNode::read(const std::string& str, std::vector<casadi_int>* val) {
+  // Dependency lists can be very long, avoid stream overhead
   val->clear();
-  std::istringstream buffer(str);
+  const char* p = str.c_str();
   while (true) {
-    casadi_int v;
-    buffer >> v;
-    if (buffer.fail()) break;
+    char* end;
+    casadi_int v = static_cast<casadi_int>(std::strtoll(p, &end, 10));
+    if (end == p) break;
     val->push_back(v);
+    p = end;
   }
 }
 
@@ -173,4 +176,30 @@ std::vector<std::string> XmlNode::attribute_names() const {
   return ret;
 }
 
+void XmlNode::serialize(SerializingStream& s) const {
+  s.version("XmlNode", 1);
+  s.pack("XmlNode::name", this->name);
+  s.pack("XmlNode::attributes", this->attributes);
+  s.pack("XmlNode::comment", this->comment);
+  s.pack("XmlNode::line", this->line);
+  s.pack("XmlNode::text", this->text);
+  s.pack("XmlNode::n_children", this->children.size());
+  for (auto& c : this->children) c.serialize(s);
+}
+
+XmlNode XmlNode::deserialize(DeserializingStream& s) {
+  XmlNode ret;
+  s.version("XmlNode", 1);
+  s.unpack("XmlNode::name", ret.name);
+  s.unpack("XmlNode::attributes", ret.attributes);
+  s.unpack("XmlNode::comment", ret.comment);
+  s.unpack("XmlNode::line", ret.line);
+  s.unpack("XmlNode::text", ret.text);
+  size_t n_children;
+  s.unpack("XmlNode::n_children", n_children);
+  ret.children.reserve(n_children);
+  for (size_t i = 0; i < n_children; ++i) ret.children.push_back(deserialize(s));
+  return ret;
+}
+
 } // namespace casadi
@@ -36,6 +36,9 @@
 
 namespace casadi {
 
+class SerializingStream;
+class DeserializingStream;
+
 struct CASADI_EXPORT XmlNode {
   // All attributes
   std::map<std::string, std::string> attributes;
@@ -204,6 +207,16 @@ struct CASADI_EXPORT XmlNode {
 
       \identifier{vw} */
   void dump(std::ostream &stream, casadi_int indent = 0) const;
+
+  /** \brief Serialize the tree, e.g. to cache a parsed file
+
+      \identifier{2f4} */
+  void serialize(SerializingStream& s) const;
+
+  /** \brief Deserialize a tree
+
+      \identifier{2f5} */
+  static XmlNode deserialize(DeserializingStream& s);
 };
 
 } // namespace casadi
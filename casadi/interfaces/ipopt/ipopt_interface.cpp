@@ -132,7 +132,12 @@ namespace casadi {
         "abstol: use inactive_lam_value"}},
       {"inactive_lam_value",
        {OT_DOUBLE,
-        "Value used in inactive_lam_strategy (default: 10)."}}
+        "Value used in inactive_lam_strategy (default: 10)."}},
+      {"fuse_oracle",
+       {OT_STRING,
+        "Evaluate NLP functions in one pass and serve callbacks at the same point "
+        "from a cache. NONE|zeroth: f and g|first: f and g, and separately their first "
+        "derivatives"}}
      }
   };
 
@@ -151,6 +156,9 @@ namespace casadi {
     inactive_lam_strategy_ = "reltol";
     inactive_lam_value_ = 10;
 
+    std::string fuse_oracle = "none";
+    bool user_grad_f = false, user_jac_g = false;
+
     // Read user options
     for (auto&& op : opts) {
       if (op.first=="ipopt") {
@@ -179,11 +187,13 @@ namespace casadi {
         casadi_assert_dev(f.n_in()==2);
         casadi_assert_dev(f.n_out()==2);
         set_function(f, "nlp_jac_g");
+        user_jac_g = true;
       } else if (op.first=="grad_f") {
         Function f = op.second;
         casadi_assert_dev(f.n_in()==2);
         casadi_assert_dev(f.n_out()==2);
         set_function(f, "nlp_grad_f");
+        user_grad_f = true;
       } else if (op.first=="convexify_strategy") {
         convexify_strategy = op.second.to_string();
       } else if (op.first=="convexify_margin") {
@@ -196,6 +206,8 @@ namespace casadi {
         inactive_lam_strategy_ = op.second.to_string();
       } else if (op.first=="inactive_lam_value") {
         inactive_lam_value_ = op.second;
+      } else if (op.first=="fuse_oracle") {
+        fuse_oracle = op.second.to_string();
       }
     }
 
@@ -217,6 +229,20 @@ namespace casadi {
     }
     jacg_sp_ = get_function("nlp_jac_g").sparsity_out(1);
 
+    // Evaluate shared subexpressions only once per iterate
+    if (fuse_oracle=="zeroth") {
+      fuse_functions("nlp_fg", {"nlp_f", "nlp_g"});
+    } else if (fuse_oracle=="first") {
+      // Trial points of the line search only need f and g, derivatives are fused
+      // separately so that they are only calculated at accepted iterates
+      fuse_functions("nlp_fg", {"nlp_f", "nlp_g"});
+      if (!user_grad_f && !user_jac_g) {
+        fuse_functions("nlp_fg1", {"nlp_grad_f", "nlp_jac_g"});
+      }
+    } else {
+      casadi_assert(fuse_oracle=="none", "Unknown option value 'fuse_oracle': " + fuse_oracle);
+    }
+
     convexify_ = false;
 
     // Allocate temporary work vectors
@@ -503,6 +529,8 @@ namespace casadi {
       m->alpha_du.push_back(alpha_du);
       m->ls_trials.push_back(ls_trials);
       m->obj.push_back(obj_value);
+      // Termination requested by a driver
+      if (m->stop_check && m->stop_check(obj_value, inf_pr)) return 0;
       if (!fcallback_.is_null()) {
         ScopedTiming tic(m->fstats.at("callback_fun"));
         if (full_callback) {
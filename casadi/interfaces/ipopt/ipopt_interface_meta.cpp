@@ -89,6 +89,13 @@
 "|                          |             | before passing it to the        |\n"
 "|                          |             | solver.                         |\n"
 "+--------------------------+-------------+---------------------------------+\n"
+"| fuse_oracle              | OT_STRING   | Evaluate NLP functions in one   |\n"
+"|                          |             | pass and serve callbacks at the |\n"
+"|                          |             | same point from a cache.        |\n"
+"|                          |             | NONE|zeroth: f and g|first: f   |\n"
+"|                          |             | and g, and separately their     |\n"
+"|                          |             | first derivatives               |\n"
+"+--------------------------+-------------+---------------------------------+\n"
 "| grad_f                   | OT_FUNCTION | Function for calculating the    |\n"
 "|                          |             | gradient of the objective       |\n"
 "|                          |             | (column, autogenerated by       |\n"
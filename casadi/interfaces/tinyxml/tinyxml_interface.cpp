@@ -24,6 +24,7 @@
 
 
 #include "tinyxml_interface.hpp"
+#include <fstream>
 
 namespace casadi {
 
@@ -62,6 +63,58 @@ XmlNode TinyXmlInterface::parse(const std::string& filename) {
   return n;
 }
 
+XmlNode TinyXmlInterface::parse_root(const std::string& filename) {
+  std::ifstream in(filename);
+  casadi_assert(in.good(), "Cannot load " + filename);
+  // Prolog and start tag of the root element
+  std::string head;
+  // Read until head ends with a given string
+  auto read_until = [&](const std::string& end) {
+    char c;
+    while (in.get(c)) {
+      head.push_back(c);
+      if (head.size() >= end.size()
+          && head.compare(head.size() - end.size(), end.size(), end) == 0) return true;
+    }
+    return false;
+  };
+  char c = 0;
+  while (in.get(c)) {
+    head.push_back(c);
+    if (c != '<') continue;
+    if (in.peek() == '?') {
+      // XML declaration or processing instruction
+      casadi_assert(read_until("?>"), "Cannot import " + filename);
+    } else if (in.peek() == '!') {
+      // Comment or document type declaration
+      head.push_back(static_cast<char>(in.get()));
+      casadi_assert(read_until(in.peek() == '-' ? "-->" : ">"), "Cannot import " + filename);
+    } else {
+      // Start tag of the root element, quoted attribute values may contain '>'
+      char quote = 0;
+      while (in.get(c)) {
+        if (quote) {
+          if (c == quote) quote = 0;
+        } else if (c == '"' || c == '\'') {
+          quote = c;
+        } else if (c == '>') {
+          break;
+        }
+        head.push_back(c);
+      }
+      casadi_assert(c == '>' && !quote, "Cannot import " + filename);
+      // Close the element, so that it can be parsed without its children
+      if (head.back() != '/') head.push_back('/');
+      head.push_back('>');
+      XMLError err = doc_.Parse(head.c_str(), head.size());
+      casadi_assert(!err, "Cannot import " + filename);
+      return import_node(&doc_);
+    }
+  }
+  casadi_error("No root element in " + filename);
+  return XmlNode();
+}
+
 void TinyXmlInterface::dump(const std::string& filename, const XmlNode& node) {
   // Add encoding declaration
   doc_.InsertEndChild(doc_.NewDeclaration());
@@ -108,6 +108,9 @@ namespace casadi {
     // Coefficients of the quadratures
     std::vector<double> B(deg_ + 1, 0);
 
+    // Lagrange polynomials, for interpolation
+    std::vector<Polynomial> L(deg_ + 1);
+
     // For all collocation points
     for (casadi_int j = 0; j < deg_ + 1; ++j) {
 
@@ -137,6 +140,9 @@ namespace casadi {
       // Integrate polynomial to get the coefficients of the quadratures
       Polynomial ip = p.anti_derivative();
       B[j] = ip(1.0);
+
+      // Save for interpolation
+      L[j] = p;
     }
 
     // Symbolic inputs
@@ -225,6 +231,43 @@ namespace casadi {
     Function F("implicit_step", F_in, F_out,
       {"t", "h", "x0", "v0", "p", "u"}, {"xf", "vf", "qf"});
     set_function(F, F.name(), true);
+
+    // Interpolation using the collocation polynomials
+    if (dense_output_) {
+      MX theta = MX::sym("theta");
+      MX x_theta = L[0](theta) * x0;
+      MX z_theta = MX::zeros(nz1_);
+      MX q_theta = MX::zeros(nq1_);
+      for (casadi_int j = 1; j < deg_ + 1; ++j) {
+        // Differential states from the collocation polynomial
+        x_theta += L[j](theta) * x[j];
+
+        // Algebraic variables and the quadrature integrand are only defined at
+        // the collocation points
+        Polynomial pz = 1;
+        for (casadi_int r = 1; r < deg_ + 1; ++r) {
+          if (r != j) {
+            pz *= Polynomial(-tau_root[r], 1) / (tau_root[j] - tau_root[r]);
+          }
+        }
+        z_theta += pz(theta) * z[j];
+
+        // Quadratures from the integrated interpolant of the integrand,
+        // consistent with qf for theta = 1
+        if (nq1_ > 0) {
+          std::vector<MX> f_arg(DYN_NUM_IN);
+          f_arg[DYN_T] = tt[j];
+          f_arg[DYN_P] = p;
+          f_arg[DYN_U] = u;
+          f_arg[DYN_X] = x[j];
+          f_arg[DYN_Z] = z[j];
+          q_theta += (pz.anti_derivative()(theta) * h) * f(f_arg).at(DYN_QUAD);
+        }
+      }
+      Function D("dense", {t0, h, x0, v, p, u, theta}, {x_theta, z_theta, q_theta},
+        {"t", "h", "x0", "v", "p", "u", "theta"}, {"x", "z", "q"});
+      set_function(D, D.name(), true);
+    }
   }
 
   void Collocation::reset(IntegratorMemory* mem, bool first_call) const {
@@ -46,6 +46,16 @@
 "| collocation_scheme        | OT_STRING | Collocation scheme:              |\n"
 "|                           |           | radau|legendre                   |\n"
 "+---------------------------+-----------+----------------------------------+\n"
+"| dense_output              | OT_BOOL   | Take finite elements             |\n"
+"|                           |           | independently of the output      |\n"
+"|                           |           | times and obtain the outputs by  |\n"
+"|                           |           | interpolation within the finite  |\n"
+"|                           |           | elements. Finite elements still  |\n"
+"|                           |           | end at step changes in the       |\n"
+"|                           |           | controls. Not used for the       |\n"
+"|                           |           | backward problem or with events. |\n"
+"|                           |           | default: false                   |\n"
+"+---------------------------+-----------+----------------------------------+\n"
 "| interpolation_order       | OT_INT    | Order of the interpolating       |\n"
 "|                           |           | polynomials                      |\n"
 "+---------------------------+-----------+----------------------------------+\n"
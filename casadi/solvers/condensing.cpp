@@ -0,0 +1,563 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "condensing.hpp"
+
+namespace casadi {
+
+  extern "C"
+  int CASADI_CONIC_CONDENSING_EXPORT
+  casadi_register_conic_condensing(Conic::Plugin* plugin) {
+    plugin->creator = Condensing::creator;
+    plugin->name = "condensing";
+    plugin->doc = Condensing::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &Condensing::options_;
+    plugin->deserialize = &Condensing::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_CONIC_CONDENSING_EXPORT casadi_load_conic_condensing() {
+    Conic::registerPlugin(casadi_register_conic_condensing);
+  }
+
+  Condensing::Condensing(const std::string& name, const std::map<std::string, Sparsity> &st)
+    : Conic(name, st) {
+  }
+
+  Condensing::~Condensing() {
+    clear_mem();
+  }
+
+  void* Condensing::alloc_mem() const {
+    CondensingMemory *m = new CondensingMemory();
+    m->mem_qp = qpsol_.checkout();
+    return m;
+  }
+
+  void Condensing::free_mem(void *mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    qpsol_.release(m->mem_qp);
+    delete m;
+  }
+
+  const Options Condensing::options_
+  = {{&Conic::options_},
+     {{"conic",
+       {OT_STRING,
+        "Name of the QP solver for the condensed problem."}},
+      {"conic_options",
+       {OT_DICT,
+        "Options to be passed to the QP solver."}},
+      {"block_size",
+       {OT_INT,
+        "Number of stages condensed into one block, 0 for full condensing [0]."}},
+      {"state_bounds",
+       {OT_BOOL,
+        "Impose the bounds of eliminated states as constraints of the condensed QP [true]. "
+        "Set to false if the states are unbounded."}},
+      {"N",
+       {OT_INT,
+        "OCP horizon"}},
+      {"nx",
+       {OT_INTVECTOR,
+        "Number of states, length N+1"}},
+      {"nu",
+       {OT_INTVECTOR,
+        "Number of controls, length N or N+1"}},
+      {"ng",
+       {OT_INTVECTOR,
+        "Number of non-dynamic constraints, length N+1"}},
+      {"structure_detection",
+       {OT_STRING,
+        "AUTO | manual"}}
+     }
+  };
+
+  void Condensing::init(const Dict& opts) {
+    // Initialize the base classes
+    Conic::init(opts);
+    // Default options
+    std::string conic_plugin;
+    Dict conic_options;
+    block_size_ = 0;
+    state_bounds_ = true;
+    bool manual = false;
+    casadi_int struct_cnt = 0;
+    N_ = 0;
+    // Read user options
+    for (auto&& op : opts) {
+      if (op.first=="conic") {
+        conic_plugin = op.second.to_string();
+      } else if (op.first=="conic_options") {
+        conic_options = op.second;
+      } else if (op.first=="block_size") {
+        block_size_ = op.second;
+      } else if (op.first=="state_bounds") {
+        state_bounds_ = op.second;
+      } else if (op.first=="N") {
+        N_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="nx") {
+        nxs_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="nu") {
+        nus_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="ng") {
+        ngs_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="structure_detection") {
+        std::string v = op.second;
+        if (v=="auto") {
+          manual = false;
+        } else if (v=="manual") {
+          manual = true;
+        } else {
+          casadi_error("Unknown option for structure_detection: '" + v + "'.");
+        }
+      }
+    }
+    casadi_assert(!conic_plugin.empty(), "'conic' option has not been set");
+    casadi_assert(block_size_>=0, "block_size must be nonnegative.");
+    if (manual) {
+      casadi_assert(struct_cnt==4, "You must set all of N, nx, nu, ng.");
+      if (nus_.size()==N_) nus_.push_back(0);
+      casadi_assert(nxs_.size()==N_+1, "nx must have length N+1.");
+      casadi_assert(nus_.size()==N_+1, "nu must have length N or N+1.");
+      casadi_assert(ngs_.size()==N_+1, "ng must have length N+1.");
+    } else {
+      casadi_assert(struct_cnt==0,
+        "You must set structure_detection to 'manual' if you set N, nx, nu, ng.");
+      detect_ocp_structure(N_, nxs_, nus_, ngs_);
+    }
+    if (verbose_) {
+      casadi_message("Using structure: N " + str(N_) + ", nx " + str(nxs_) + ", "
+            "nu " + str(nus_) + ", ng " + str(ngs_) + ".");
+    }
+    // Eliminate the states and form the condensed sparsity patterns
+    set_structure();
+    if (verbose_) {
+      casadi_message("Condensed QP: " + str(nv_) + " variables, " + str(nac_) + " constraints.");
+    }
+    // QP solver for the condensed problem
+    qpsol_ = conic("qpsol", conic_plugin, {{"h", Hc_}, {"a", Ac_}}, conic_options);
+    alloc(qpsol_);
+    // Condensed QP data and work vectors
+    alloc_w(Hc_.nnz() + Ac_.nnz() + 9*nv_ + 5*nac_ + 6*nx_ + 2*na_, true);
+  }
+
+  void Condensing::set_structure() {
+    std::string hint = " Consider setting structure_detection to 'manual'.";
+    // Consistency checks
+    casadi_int nz_tot = 0, na_tot = 0;
+    for (casadi_int k=0; k<=N_; ++k) {
+      casadi_assert(nxs_[k]>=0 && nus_[k]>=0 && ngs_[k]>=0,
+        "Stage dimensions must be nonnegative.");
+      nz_tot += nxs_[k] + nus_[k];
+      na_tot += ngs_[k] + (k<N_ ? nxs_[k+1] : 0);
+    }
+    casadi_assert(nz_tot==nx_, "Stage structure has " + str(nz_tot) + " variables, "
+      "but the QP has " + str(nx_) + "." + hint);
+    casadi_assert(na_tot==na_, "Stage structure has " + str(na_tot) + " constraints, "
+      "but the QP has " + str(na_) + "." + hint);
+    // Offsets of the stages in the variables and constraints
+    std::vector<casadi_int> off_z(N_+2, 0), off_a(N_+2, 0);
+    for (casadi_int k=0; k<=N_; ++k) {
+      off_z[k+1] = off_z[k] + nxs_[k] + nus_[k];
+      off_a[k+1] = off_a[k] + (k<N_ ? nxs_[k+1] : 0) + ngs_[k];
+    }
+    // Partition the stages into blocks, keep the first state and the controls of each block
+    casadi_int M = block_size_==0 ? N_+1 : block_size_;
+    bz_.clear();
+    bv_.clear();
+    vind_.assign(nx_, -1);
+    def_.assign(nx_, -1);
+    std::vector<casadi_int> zblk(nx_);
+    nv_ = 0;
+    for (casadi_int k=0; k<=N_; ++k) {
+      bool start = k % M == 0;
+      if (start) {
+        bz_.push_back(off_z[k]);
+        bv_.push_back(nv_);
+      }
+      for (casadi_int i=off_z[k]; i<off_z[k+1]; ++i) {
+        zblk[i] = bz_.size() - 1;
+        if (!start && i<off_z[k]+nxs_[k]) {
+          // Eliminated with the dynamics of the previous stage
+          def_[i] = off_a[k-1] + i - off_z[k];
+        } else {
+          vind_[i] = nv_++;
+        }
+      }
+    }
+    bz_.push_back(nx_);
+    bv_.push_back(nv_);
+    casadi_int nb = bz_.size() - 1;
+    // Eliminated variables must be given explicitly by their dynamics constraint
+    AT_ = A_.transpose(at_map_);
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+    piv_.assign(nx_, -1);
+    for (casadi_int i=0; i<nx_; ++i) {
+      casadi_int r = def_[i];
+      if (r<0) continue;
+      for (casadi_int k=at_colind[r]; k<at_colind[r+1]; ++k) {
+        casadi_int c = at_row[k];
+        if (c==i) {
+          piv_[i] = at_map_[k];
+        } else {
+          casadi_assert(c<i && zblk[c]==zblk[i],
+            "A does not have the expected stage structure: dynamics constraint " + str(r)
+            + " of variable " + str(i) + " depends on variable " + str(c) + "." + hint);
+        }
+      }
+      casadi_assert(piv_[i]>=0, "A does not have the expected stage structure: "
+        "dynamics constraint " + str(r) + " does not depend on variable " + str(i) + "." + hint);
+    }
+    // Remaining constraints, followed by the bounds of the eliminated states
+    std::vector<bool> is_def(na_, false);
+    for (casadi_int i=0; i<nx_; ++i) if (def_[i]>=0) is_def[def_[i]] = true;
+    aind_.assign(na_, -1);
+    nac_ = 0;
+    for (casadi_int r=0; r<na_; ++r) if (!is_def[r]) aind_[r] = nac_++;
+    bnd_.assign(nx_, -1);
+    if (state_bounds_) {
+      for (casadi_int i=0; i<nx_; ++i) if (def_[i]>=0) bnd_[i] = nac_++;
+    }
+    // Hessian must not couple different blocks
+    const casadi_int *h_colind = H_.colind(), *h_row = H_.row();
+    for (casadi_int c=0; c<nx_; ++c) {
+      for (casadi_int k=h_colind[c]; k<h_colind[c+1]; ++k) {
+        casadi_int r = h_row[k];
+        casadi_assert(zblk[r]==zblk[c],
+          "H couples the condensing blocks " + str(zblk[r]) + " and " + str(zblk[c])
+          + " through entry (" + str(r) + ", " + str(c) + ").");
+      }
+    }
+    // Condensed Hessian: dense block per block
+    std::vector<Sparsity> hblocks;
+    bh_.resize(nb + 1);
+    bh_[0] = 0;
+    for (casadi_int b=0; b<nb; ++b) {
+      casadi_int nvb = bv_[b+1] - bv_[b];
+      hblocks.push_back(Sparsity::dense(nvb, nvb));
+      bh_[b+1] = bh_[b] + nvb * nvb;
+    }
+    Hc_ = diagcat(hblocks);
+    // Condensed constraint matrix: propagate the sparsity of each condensed variable
+    const casadi_int *a_colind = A_.colind(), *a_row = A_.row();
+    std::vector<bool> y(nx_, false);
+    std::vector<casadi_int> mark(nac_, -1), ac_colind(1, 0), ac_row, col;
+    for (casadi_int b=0; b<nb; ++b) {
+      for (casadi_int i0=bz_[b]; i0<bz_[b+1]; ++i0) {
+        casadi_int j = vind_[i0];
+        if (j<0) continue;
+        col.clear();
+        for (casadi_int i=i0; i<bz_[b+1]; ++i) {
+          if (i==i0) {
+            y[i] = true;
+          } else if (def_[i]>=0) {
+            casadi_int r = def_[i];
+            for (casadi_int k=at_colind[r]; k<at_colind[r+1] && !y[i]; ++k) {
+              if (at_row[k]!=i) y[i] = y[at_row[k]];
+            }
+          }
+          if (!y[i]) continue;
+          for (casadi_int k=a_colind[i]; k<a_colind[i+1]; ++k) {
+            casadi_int r = aind_[a_row[k]];
+            if (r>=0 && mark[r]!=j) {
+              mark[r] = j;
+              col.push_back(r);
+            }
+          }
+          if (bnd_[i]>=0) col.push_back(bnd_[i]);
+        }
+        std::fill(y.begin()+i0, y.begin()+bz_[b+1], false);
+        std::sort(col.begin(), col.end());
+        ac_row.insert(ac_row.end(), col.begin(), col.end());
+        ac_colind.push_back(ac_row.size());
+      }
+    }
+    Ac_ = Sparsity(nac_, nv_, ac_colind, ac_row);
+  }
+
+  void Condensing::fwd(casadi_int blk, casadi_int i0, const double* v, const double* a,
+      const double* b, double* z) const {
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+    for (casadi_int i=i0; i<bz_[blk+1]; ++i) {
+      casadi_int r = def_[i];
+      if (r<0) {
+        z[i] = v ? v[vind_[i]] : 0;
+        continue;
+      }
+      double t = b ? b[r] : 0;
+      for (casadi_int k=at_colind[r]; k<at_colind[r+1]; ++k) {
+        casadi_int c = at_row[k];
+        if (c!=i) t -= a[at_map_[k]] * z[c];
+      }
+      z[i] = t / a[piv_[i]];
+    }
+  }
+
+  void Condensing::adj(casadi_int blk, const double* a, double* w, double* v) const {
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+    for (casadi_int i=bz_[blk+1]-1; i>=bz_[blk]; --i) {
+      casadi_int r = def_[i];
+      if (r<0) {
+        v[vind_[i]] += w[i];
+        w[i] = 0;
+        continue;
+      }
+      double t = w[i] / a[piv_[i]];
+      w[i] = 0;
+      if (t==0) continue;
+      for (casadi_int k=at_colind[r]; k<at_colind[r+1]; ++k) {
+        casadi_int c = at_row[k];
+        if (c!=i) w[c] -= a[at_map_[k]] * t;
+      }
+    }
+  }
+
+  int Condensing::
+  solve(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    casadi_int nb = bz_.size() - 1;
+    // Inputs
+    const double *h, *g, *a, *lba, *uba, *lbx, *ubx, *x0, *lam_x0, *lam_a0;
+    h = arg[CONIC_H];
+    g = arg[CONIC_G];
+    a = arg[CONIC_A];
+    lba = arg[CONIC_LBA];
+    uba = arg[CONIC_UBA];
+    lbx = arg[CONIC_LBX];
+    ubx = arg[CONIC_UBX];
+    x0 = arg[CONIC_X0];
+    lam_x0 = arg[CONIC_LAM_X0];
+    lam_a0 = arg[CONIC_LAM_A0];
+    casadi_assert(a!=nullptr || nx_==nv_, "Cannot condense without constraint matrix.");
+    // Condensed QP data
+    double *hc = w; w += Hc_.nnz();
+    double *ac = w; w += Ac_.nnz();
+    double *gc = w; w += nv_;
+    double *lbv = w; w += nv_;
+    double *ubv = w; w += nv_;
+    double *v0 = w; w += nv_;
+    double *lam_v0 = w; w += nv_;
+    double *v = w; w += nv_;
+    double *lam_v = w; w += nv_;
+    double *lbac = w; w += nac_;
+    double *ubac = w; w += nac_;
+    double *lam_ac0 = w; w += nac_;
+    double *lam_ac = w; w += nac_;
+    // Work vectors
+    double *vadj = w; w += nv_;
+    double *e = w; w += nv_;
+    double *colbuf = w; w += nac_;
+    double *phi = w; w += nx_;
+    double *grad = w; w += nx_;
+    double *y = w; w += nx_;
+    double *hy = w; w += nx_;
+    double *z = w; w += nx_;
+    double *lam_z = w; w += nx_;
+    double *aphi = w; w += na_;
+    double *lam_az = w; w += na_;
+    // Eliminated states are given by equality constraints
+    for (casadi_int i=0; i<nx_; ++i) {
+      casadi_int r = def_[i];
+      if (r<0) continue;
+      casadi_assert((lba ? lba[r] : 0)==(uba ? uba[r] : 0),
+        "Dynamics constraint " + str(r) + " must be an equality constraint for condensing.");
+      casadi_assert(a[piv_[i]]!=0, "Dynamics constraint " + str(r)
+        + " has a zero entry for the eliminated variable " + str(i) + ".");
+    }
+    // Affine part of the elimination
+    for (casadi_int b=0; b<nb; ++b) fwd(b, bz_[b], nullptr, a, lba, phi);
+    // Gradient of the objective and constraint values at the affine part
+    casadi_copy(g, nx_, grad);
+    casadi_mv(h, H_, phi, grad, 0);
+    double cost_phi = g ? casadi_dot(nx_, g, phi) : 0;
+    if (h) cost_phi += 0.5 * casadi_bilin(h, H_, phi, phi);
+    casadi_clear(aphi, na_);
+    if (a) casadi_mv(a, A_, phi, aphi, 0);
+    // Condensed gradient
+    casadi_clear(gc, nv_);
+    casadi_clear(y, nx_);
+    for (casadi_int b=0; b<nb; ++b) {
+      casadi_copy(grad + bz_[b], bz_[b+1] - bz_[b], y + bz_[b]);
+      adj(b, a, y, gc);
+    }
+    // Condensed bounds and initial guess
+    for (casadi_int i=0; i<nx_; ++i) {
+      double lb = lbx ? lbx[i] : 0, ub = ubx ? ubx[i] : 0;
+      if (vind_[i]>=0) {
+        lbv[vind_[i]] = lb;
+        ubv[vind_[i]] = ub;
+        v0[vind_[i]] = x0 ? x0[i] : 0;
+        lam_v0[vind_[i]] = lam_x0 ? lam_x0[i] : 0;
+      } else if (bnd_[i]>=0) {
+        lbac[bnd_[i]] = lb - phi[i];
+        ubac[bnd_[i]] = ub - phi[i];
+        lam_ac0[bnd_[i]] = lam_x0 ? lam_x0[i] : 0;
+      } else {
+        casadi_assert(lb==-inf && ub==inf, "Variable " + str(i) + " is eliminated and "
+          "must be unbounded. Set state_bounds to true to impose its bounds.");
+      }
+    }
+    for (casadi_int r=0; r<na_; ++r) {
+      if (aind_[r]<0) continue;
+      lbac[aind_[r]] = (lba ? lba[r] : 0) - aphi[r];
+      ubac[aind_[r]] = (uba ? uba[r] : 0) - aphi[r];
+      lam_ac0[aind_[r]] = lam_a0 ? lam_a0[r] : 0;
+    }
+    // Condensed Hessian and constraint matrix, one condensed variable at a time
+    const casadi_int *h_colind = H_.colind(), *h_row = H_.row();
+    const casadi_int *a_colind = A_.colind(), *a_row = A_.row();
+    const casadi_int *ac_colind = Ac_.colind(), *ac_row = Ac_.row();
+    casadi_clear(vadj, nv_);
+    casadi_clear(e, nv_);
+    casadi_clear(colbuf, nac_);
+    casadi_clear(hy, nx_);
+    for (casadi_int b=0; b<nb; ++b) {
+      casadi_int nvb = bv_[b+1] - bv_[b];
+      for (casadi_int i0=bz_[b]; i0<bz_[b+1]; ++i0) {
+        casadi_int j = vind_[i0];
+        if (j<0) continue;
+        // Sensitivity of the variables in the block
+        e[j] = 1;
+        fwd(b, i0, e, a, nullptr, y);
+        e[j] = 0;
+        // Hessian column: Y'*H*y
+        for (casadi_int c=i0; c<bz_[b+1]; ++c) {
+          if (y[c]==0 || !h) continue;
+          for (casadi_int k=h_colind[c]; k<h_colind[c+1]; ++k) hy[h_row[k]] += h[k] * y[c];
+        }
+        adj(b, a, hy, vadj);
+        casadi_copy(vadj + bv_[b], nvb, hc + bh_[b] + (j - bv_[b]) * nvb);
+        casadi_clear(vadj + bv_[b], nvb);
+        // Constraint column
+        for (casadi_int c=i0; c<bz_[b+1]; ++c) {
+          if (y[c]==0) continue;
+          for (casadi_int k=a_colind[c]; k<a_colind[c+1] && a; ++k) {
+            casadi_int r = aind_[a_row[k]];
+            if (r>=0) colbuf[r] += a[k] * y[c];
+          }
+          if (bnd_[c]>=0) colbuf[bnd_[c]] = y[c];
+        }
+        for (casadi_int k=ac_colind[j]; k<ac_colind[j+1]; ++k) {
+          ac[k] = colbuf[ac_row[k]];
+          colbuf[ac_row[k]] = 0;
+        }
+        casadi_clear(y + i0, bz_[b+1] - i0);
+      }
+    }
+    // Solve the condensed QP
+    const double** arg1 = arg + n_in_;
+    double** res1 = res + n_out_;
+    std::fill_n(arg1, static_cast<casadi_int>(CONIC_NUM_IN), nullptr);
+    std::fill_n(res1, static_cast<casadi_int>(CONIC_NUM_OUT), nullptr);
+    arg1[CONIC_H] = hc;
+    arg1[CONIC_G] = gc;
+    arg1[CONIC_A] = ac;
+    arg1[CONIC_LBA] = lbac;
+    arg1[CONIC_UBA] = ubac;
+    arg1[CONIC_LBX] = lbv;
+    arg1[CONIC_UBX] = ubv;
+    arg1[CONIC_X0] = v0;
+    arg1[CONIC_LAM_X0] = lam_v0;
+    arg1[CONIC_LAM_A0] = lam_ac0;
+    double cost_v = 0;
+    res1[CONIC_X] = v;
+    res1[CONIC_COST] = &cost_v;
+    res1[CONIC_LAM_X] = lam_v;
+    res1[CONIC_LAM_A] = lam_ac;
+    int flag = qpsol_(arg1, res1, iw, w, m->mem_qp);
+    auto m_qp = static_cast<ConicMemory*>(qpsol_->memory(m->mem_qp));
+    m->d_qp.success = m_qp->d_qp.success;
+    m->d_qp.unified_return_status = m_qp->d_qp.unified_return_status;
+    m->d_qp.iter_count = m_qp->d_qp.iter_count;
+    // Expand the primal solution
+    for (casadi_int b=0; b<nb; ++b) fwd(b, bz_[b], v, a, lba, z);
+    // Multipliers of the kept variables and constraints and of the state bounds
+    for (casadi_int i=0; i<nx_; ++i) {
+      lam_z[i] = vind_[i]>=0 ? lam_v[vind_[i]] : bnd_[i]>=0 ? lam_ac[bnd_[i]] : 0;
+    }
+    for (casadi_int r=0; r<na_; ++r) lam_az[r] = aind_[r]>=0 ? lam_ac[aind_[r]] : 0;
+    // Multipliers of the dynamics from stationarity, backwards over the eliminated states
+    casadi_copy(g, nx_, grad);
+    casadi_mv(h, H_, z, grad, 0);
+    if (a) casadi_mv(a, A_, lam_az, grad, 1);
+    casadi_axpy(nx_, 1., lam_z, grad);
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+    for (casadi_int i=nx_-1; i>=0; --i) {
+      casadi_int r = def_[i];
+      if (r<0) continue;
+      lam_az[r] = -grad[i] / a[piv_[i]];
+      for (casadi_int k=at_colind[r]; k<at_colind[r+1]; ++k) {
+        casadi_int c = at_row[k];
+        if (c!=i) grad[c] += a[at_map_[k]] * lam_az[r];
+      }
+    }
+    // Outputs
+    casadi_copy(z, nx_, res[CONIC_X]);
+    casadi_copy(lam_z, nx_, res[CONIC_LAM_X]);
+    casadi_copy(lam_az, na_, res[CONIC_LAM_A]);
+    if (res[CONIC_COST]) *res[CONIC_COST] = cost_v + cost_phi;
+    return flag;
+  }
+
+  Dict Condensing::get_stats(void* mem) const {
+    Dict stats = Conic::get_stats(mem);
+    auto m = static_cast<CondensingMemory*>(mem);
+    stats["solver_stats"] = qpsol_->get_stats(qpsol_->memory(m->mem_qp));
+    return stats;
+  }
+
+  Condensing::Condensing(DeserializingStream& s) : Conic(s) {
+    s.version("Condensing", 1);
+    s.unpack("Condensing::qpsol", qpsol_);
+    s.unpack("Condensing::N", N_);
+    s.unpack("Condensing::nxs", nxs_);
+    s.unpack("Condensing::nus", nus_);
+    s.unpack("Condensing::ngs", ngs_);
+    s.unpack("Condensing::block_size", block_size_);
+    s.unpack("Condensing::state_bounds", state_bounds_);
+    set_structure();
+  }
+
+  void Condensing::serialize_body(SerializingStream &s) const {
+    Conic::serialize_body(s);
+
+    s.version("Condensing", 1);
+    s.pack("Condensing::qpsol", qpsol_);
+    s.pack("Condensing::N", N_);
+    s.pack("Condensing::nxs", nxs_);
+    s.pack("Condensing::nus", nus_);
+    s.pack("Condensing::ngs", ngs_);
+    s.pack("Condensing::block_size", block_size_);
+    s.pack("Condensing::state_bounds", state_bounds_);
+  }
+
+} // namespace casadi
@@ -0,0 +1,171 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef CASADI_CONDENSING_HPP
+#define CASADI_CONDENSING_HPP
+
+#include "casadi/core/conic_impl.hpp"
+#include <casadi/solvers/casadi_conic_condensing_export.h>
+
+/** \defgroup plugin_Conic_condensing Title
+    \par
+
+ Eliminates the states of an OCP-structured QP using the dynamics and solves
+ the resulting smaller QP with another conic plugin, set with the 'conic' option.
+ The stages are grouped into blocks of 'block_size' stages: within a block only
+ the first state and the controls are kept (partial condensing), by default all
+ stages form one block (full condensing). The condensed Hessian is built with a
+ forward and an adjoint sweep over the dynamics per condensed variable, at a cost
+ that is quadratic in the block length.
+
+ The constraint matrix must have the block structure also used by fatrop and
+ riccati, the Hessian must not couple different blocks, and the dynamics
+ constraints of eliminated states must be equalities.
+
+    \identifier{2du} */
+
+/** \pluginsection{Conic,condensing} */
+
+/// \cond INTERNAL
+namespace casadi {
+  struct CASADI_CONIC_CONDENSING_EXPORT CondensingMemory : public ConicMemory {
+    // Memory of the QP solver for the condensed problem
+    int mem_qp;
+  };
+
+  /** \brief \pluginbrief{Conic,condensing}
+
+      @copydoc Conic_doc
+      @copydoc plugin_Conic_condensing
+  */
+  class CASADI_CONIC_CONDENSING_EXPORT Condensing : public Conic {
+  public:
+    /** \brief  Create a new Solver */
+    explicit Condensing(const std::string& name,
+                        const std::map<std::string, Sparsity> &st);
+
+    /** \brief  Create a new QP Solver */
+    static Conic* creator(const std::string& name,
+                          const std::map<std::string, Sparsity>& st) {
+      return new Condensing(name, st);
+    }
+
+    /** \brief  Destructor */
+    ~Condensing() override;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "condensing";}
+
+    // Get name of the class
+    std::string class_name() const override { return "Condensing";}
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override;
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    /** \brief Initialize */
+    void init(const Dict& opts) override;
+
+    /** \brief Solve the QP */
+    int solve(const double** arg, double** res,
+             casadi_int* iw, double* w, void* mem) const override;
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    /// QP solver for the condensed problem
+    Function qpsol_;
+
+    // Stage structure
+    casadi_int N_;
+    std::vector<casadi_int> nxs_, nus_, ngs_;
+
+    /// Number of stages per block, 0 for full condensing
+    casadi_int block_size_;
+
+    /// Keep the bounds of eliminated states as constraints
+    bool state_bounds_;
+
+    // Sparsity of the condensed Hessian and constraint matrix
+    Sparsity Hc_, Ac_;
+
+    // Number of condensed variables and constraints
+    casadi_int nv_, nac_;
+
+    // Condensed variable (or -1) of each variable
+    std::vector<casadi_int> vind_;
+
+    // Condensed constraint (or -1) of each constraint
+    std::vector<casadi_int> aind_;
+
+    // For each variable: the dynamics constraint eliminating it, the nonzero of
+    // the variable in that constraint and its state bound constraint (all -1 if kept)
+    std::vector<casadi_int> def_, piv_, bnd_;
+
+    // Variable and condensed variable range of each block, offset into Hc
+    std::vector<casadi_int> bz_, bv_, bh_;
+
+    // Transpose of A with the nonzero mapping
+    Sparsity AT_;
+    std::vector<casadi_int> at_map_;
+
+    /** \brief Map condensed variables to variables in one block
+
+        Variables from i0 on are set, the ones before are assumed computed.
+        With b (the constraint bounds) the affine map is applied, otherwise the linear part.
+    */
+    void fwd(casadi_int blk, casadi_int i0, const double* v, const double* a, const double* b,
+      double* z) const;
+
+    /// Adjoint of fwd in one block, consumes w and adds the result to v
+    void adj(casadi_int blk, const double* a, double* w, double* v) const;
+
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new Condensing(s); }
+
+  protected:
+     /** \brief Deserializing constructor */
+    explicit Condensing(DeserializingStream& s);
+
+  private:
+    // Partition the stages into blocks and form the condensed sparsity patterns
+    void set_structure();
+  };
+
+} // namespace casadi
+/// \endcond
+#endif // CASADI_CONDENSING_HPP
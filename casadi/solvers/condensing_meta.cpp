@@ -0,0 +1,84 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+      #include "condensing.hpp"
+      #include <string>
+
+      const std::string casadi::Condensing::meta_doc=
+      "\n"
+"\n"
+"\n"
+"Eliminates the states of an OCP-structured QP using the dynamics and \n"
+"solves the resulting smaller QP with another conic plugin, set with the \n"
+"'conic' option. The stages are grouped into blocks of 'block_size' stages: \n"
+"within a block only the first state and the controls are kept (partial \n"
+"condensing), by default all stages form one block (full condensing). The \n"
+"condensed Hessian is built with a forward and an adjoint sweep over the \n"
+"dynamics per condensed variable, at a cost that is quadratic in the block \n"
+"length.\n"
+"\n"
+"The constraint matrix must have the block structure also used by fatrop \n"
+"and riccati, the Hessian must not couple different blocks, and the \n"
+"dynamics constraints of eliminated states must be equalities.\n"
+"\n"
+"Extra doc: https://github.com/casadi/casadi/wiki/L_2du \n"
+"\n"
+"\n"
+">List of available options\n"
+"\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"|         Id          |     Type     |             Description             |\n"
+"+=====================+==============+=====================================+\n"
+"| N                   | OT_INT       | OCP horizon                         |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| block_size          | OT_INT       | Number of stages condensed into one |\n"
+"|                     |              | block, 0 for full condensing [0].   |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| conic               | OT_STRING    | Name of the QP solver for the       |\n"
+"|                     |              | condensed problem.                  |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| conic_options       | OT_DICT      | Options to be passed to the QP      |\n"
+"|                     |              | solver.                             |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| ng                  | OT_INTVECTOR | Number of non-dynamic constraints,  |\n"
+"|                     |              | length N+1                          |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| nu                  | OT_INTVECTOR | Number of controls, length N or N+1 |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| nx                  | OT_INTVECTOR | Number of states, length N+1        |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| state_bounds        | OT_BOOL      | Impose the bounds of eliminated     |\n"
+"|                     |              | states as constraints of the        |\n"
+"|                     |              | condensed QP [true]. Set to false   |\n"
+"|                     |              | if the states are unbounded.        |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| structure_detection | OT_STRING    | AUTO | manual                       |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"\n"
+"\n"
+"\n"
+"\n"
+;
@@ -218,6 +218,7 @@ namespace casadi {
     linsol_.release(linsol_mem);
     // Read return status
     m->return_status = casadi_ipqp_return_status(d.status);
+    m->d_qp.iter_count = d.iter;
     if (d.status == IPQP_MAX_ITER)
       m->d_qp.unified_return_status = SOLVER_RET_LIMITED;
     // Get solution
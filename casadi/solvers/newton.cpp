@@ -69,7 +69,18 @@ namespace casadi {
         "Print information about each iteration"}},
       {"line_search",
        {OT_BOOL,
-        "Enable line-search (default: true)"}}
+        "Enable line-search (default: true)"}},
+      {"jacobian_update",
+       {OT_STRING,
+        "How to obtain the Jacobian in each iteration: "
+        "'exact' evaluates and factorizes it in every iteration (default), "
+        "'simplified' reuses the last evaluated Jacobian and its factorization, "
+        "'broyden' reuses the last evaluated Jacobian with rank-one Broyden updates, "
+        "restricted to its sparsity pattern"}},
+      {"contraction_tol",
+       {OT_DOUBLE,
+        "Reevaluate a reused Jacobian when max(|F|) decreases by less than this "
+        "factor in an iteration (default: 0.5)"}}
      }
   };
 
@@ -84,6 +95,8 @@ namespace casadi {
     abstolStep_ = 1e-12;
     print_iteration_ = false;
     line_search_ = true;
+    std::string jacobian_update = "exact";
+    contraction_tol_ = 0.5;
 
     // Read options
     for (auto&& op : opts) {
@@ -97,9 +110,26 @@ namespace casadi {
         print_iteration_ = op.second;
       } else if (op.first=="line_search") {
         line_search_ = op.second;
+      } else if (op.first=="jacobian_update") {
+        jacobian_update = op.second.to_string();
+      } else if (op.first=="contraction_tol") {
+        contraction_tol_ = op.second;
       }
     }
 
+    // Jacobian update strategy
+    if (jacobian_update=="exact") {
+      reuse_jacobian_ = broyden_ = false;
+    } else if (jacobian_update=="simplified") {
+      reuse_jacobian_ = true;
+      broyden_ = false;
+    } else if (jacobian_update=="broyden") {
+      reuse_jacobian_ = broyden_ = true;
+    } else {
+      casadi_error("Unknown Jacobian update '" + jacobian_update + "', "
+        "expected exact|simplified|broyden");
+    }
+
     casadi_assert(oracle_.n_in()>0,
                           "Newton: the supplied f must have at least one input.");
     casadi_assert(!linsol_.is_null(),
@@ -114,6 +144,8 @@ namespace casadi {
     alloc_w(n_, true); // dx trial
     alloc_w(n_, true); // F trial
     alloc_w(sp_jac_.nnz(), true); // J
+    alloc_w(n_, true); // F at previous iterate
+    alloc_w(n_, true); // step
   }
 
  void Newton::set_work(void* mem, const double**& arg, double**& res,
@@ -125,6 +157,8 @@ namespace casadi {
      m->x_trial = w; w += n_;
      m->f_trial = w; w += n_;
      m->jac = w; w += sp_jac_.nnz();
+     m->f_prev = w; w += n_;
+     m->dx = w; w += n_;
   }
 
   int Newton::solve(void* mem) const {
@@ -135,6 +169,18 @@ namespace casadi {
     // Get the initial guess
     casadi_copy(m->iarg[iin_], n_, m->x);
 
+    // Reset statistics
+    m->n_jac_eval = m->n_jac_saved = m->n_fact = m->n_fact_saved = 0;
+
+    // Residual at the current iterate already available?
+    bool have_f = false;
+    // Jacobian needs to be (re)evaluated?
+    bool new_jac = true;
+    // Jacobian needs to be (re)factorized?
+    bool refactor = true;
+    // Residual at the previous iterate, for the contraction test
+    double abstol_prev = std::numeric_limits<double>::infinity();
+
     // Perform the Newton iterations
     m->iter=0;
     bool success = true;
@@ -151,28 +197,57 @@ namespace casadi {
       // Start a new iteration
       m->iter++;
 
-      // Use x to evaluate g and J
-      std::copy_n(m->iarg, n_in_, m->arg);
-      m->arg[iin_] = m->x;
-      m->res[0] = m->jac;
-      std::copy_n(m->ires, n_out_, m->res+1);
-      m->res[1+iout_] = m->f;
-      calc_function(m, "jac_g_x");
+      // Reuse the Jacobian if the residual has contracted sufficiently
+      if (!new_jac) {
+        if (!have_f) {
+          // Use x to evaluate g
+          std::copy_n(m->iarg, n_in_, m->arg);
+          m->arg[iin_] = m->x;
+          std::copy_n(m->ires, n_out_, m->res);
+          m->res[iout_] = m->f;
+          calc_function(m, "g");
+        }
+        if (casadi_norm_inf(n_, m->f) > contraction_tol_ * abstol_prev) {
+          if (verbose_) casadi_message("Insufficient contraction, reevaluating Jacobian");
+          new_jac = true;
+        }
+      }
+
+      if (new_jac) {
+        // Use x to evaluate g and J
+        std::copy_n(m->iarg, n_in_, m->arg);
+        m->arg[iin_] = m->x;
+        m->res[0] = m->jac;
+        std::copy_n(m->ires, n_out_, m->res+1);
+        m->res[1+iout_] = m->f;
+        calc_function(m, "jac_g_x");
+        m->n_jac_eval++;
+        refactor = true;
+      } else {
+        m->n_jac_saved++;
+      }
 
       // Check convergence
       double abstol = 0;
-      if (abstol_ != std::numeric_limits<double>::infinity()) {
-        for (casadi_int i=0; i<n_; ++i) {
-          abstol = std::max(abstol, fabs(m->f[i]));
-        }
-        if (abstol <= abstol_) {
-          if (verbose_) casadi_message("Converged to acceptable tolerance: " + str(abstol_));
-          break;
-        }
+      if (abstol_ != std::numeric_limits<double>::infinity() || reuse_jacobian_) {
+        abstol = casadi_norm_inf(n_, m->f);
+      }
+      if (abstol_ != std::numeric_limits<double>::infinity() && abstol <= abstol_) {
+        if (verbose_) casadi_message("Converged to acceptable tolerance: " + str(abstol_));
+        break;
       }
 
       // Factorize the linear solver with J
-      linsol_.nfact(m->jac, mem_linsol);
+      if (refactor) {
+        linsol_.nfact(m->jac, mem_linsol);
+        m->n_fact++;
+        refactor = false;
+      } else {
+        m->n_fact_saved++;
+      }
+
+      // Residual before the step, for the Broyden update
+      if (broyden_) casadi_copy(m->f, n_, m->f_prev);
       linsol_.solve(m->jac, m->f, 1, false, mem_linsol);
 
       // Check convergence again
@@ -212,7 +287,17 @@ namespace casadi {
           }
           alpha*= 0.5;
         }
-        if (!success) break;
+        if (!success) {
+          // A reused Jacobian may be too inaccurate, retry with a new one
+          if (!new_jac) {
+            if (verbose_) casadi_message("Retrying line-search with a new Jacobian");
+            success = true;
+            new_jac = true;
+            have_f = false;
+            continue;
+          }
+          break;
+        }
       } else {
         // X = Xk - J^(-1) F
         casadi_axpy(n_, -alpha, m->f, m->x);
@@ -228,6 +313,39 @@ namespace casadi {
         printIteration(uout(), m->iter, abstol, abstolStep, alpha);
       }
 
+      // Prepare the Jacobian for the next iteration
+      if (reuse_jacobian_) {
+        // Step taken
+        casadi_copy(m->f, n_, m->dx);
+        casadi_scal(n_, -alpha, m->dx);
+
+        // Residual at the new iterate, if calculated by the line-search
+        have_f = line_search_;
+        if (have_f) casadi_copy(m->f_trial, n_, m->f);
+
+        // Rank-one Broyden update: J += (df - J*dx) * dx' / (dx'*dx)
+        if (broyden_) {
+          if (!have_f) {
+            // Use x to evaluate g
+            std::copy_n(m->iarg, n_in_, m->arg);
+            m->arg[iin_] = m->x;
+            std::copy_n(m->ires, n_out_, m->res);
+            m->res[iout_] = m->f;
+            calc_function(m, "g");
+            have_f = true;
+          }
+          casadi_clear(m->x_trial, n_);
+          casadi_mv(m->jac, sp_jac_, m->dx, m->x_trial, false);
+          for (casadi_int i=0; i<n_; ++i) m->f_prev[i] = m->f[i] - m->f_prev[i] - m->x_trial[i];
+          double dx2 = casadi_dot(n_, m->dx, m->dx);
+          if (dx2 > 0) {
+            casadi_rank1(m->jac, sp_jac_, 1/dx2, m->f_prev, m->dx);
+            refactor = true;
+          }
+        }
+        new_jac = false;
+        abstol_prev = abstol;
+      }
     }
 
     // Get the solution
@@ -235,7 +353,8 @@ namespace casadi {
 
     // Store the iteration count
     if (success) m->return_status = "success";
-    if (verbose_) casadi_message("Newton algorithm took " + str(m->iter) + " steps");
+    if (verbose_) casadi_message("Newton algorithm took " + str(m->iter) + " steps, "
+      + str(m->n_jac_eval) + " Jacobian evaluations (" + str(m->n_jac_saved) + " avoided)");
 
     m->success = success;
 
@@ -270,6 +389,7 @@ namespace casadi {
     auto m = static_cast<NewtonMemory*>(mem);
     m->return_status = "";
     m->iter = 0;
+    m->n_jac_eval = m->n_jac_saved = m->n_fact = m->n_fact_saved = 0;
     return 0;
   }
 
@@ -278,27 +398,42 @@ namespace casadi {
     auto m = static_cast<NewtonMemory*>(mem);
     stats["return_status"] = m->return_status;
     stats["iter_count"] = m->iter;
+    stats["n_jac_eval"] = m->n_jac_eval;
+    stats["n_jac_saved"] = m->n_jac_saved;
+    stats["n_fact"] = m->n_fact;
+    stats["n_fact_saved"] = m->n_fact_saved;
     return stats;
   }
 
 
   Newton::Newton(DeserializingStream& s) : Rootfinder(s) {
-    s.version("Newton", 1);
+    int version = s.version("Newton", 1, 2);
     s.unpack("Newton::max_iter", max_iter_);
     s.unpack("Newton::abstol", abstol_);
     s.unpack("Newton::abstolStep", abstolStep_);
     s.unpack("Newton::print_iteration", print_iteration_);
     s.unpack("Newton::line_search", line_search_);
+    if (version >= 2) {
+      s.unpack("Newton::reuse_jacobian", reuse_jacobian_);
+      s.unpack("Newton::broyden", broyden_);
+      s.unpack("Newton::contraction_tol", contraction_tol_);
+    } else {
+      reuse_jacobian_ = broyden_ = false;
+      contraction_tol_ = 0.5;
+    }
   }
 
   void Newton::serialize_body(SerializingStream &s) const {
     Rootfinder::serialize_body(s);
-    s.version("Newton", 1);
+    s.version("Newton", 2);
     s.pack("Newton::max_iter", max_iter_);
     s.pack("Newton::abstol", abstol_);
     s.pack("Newton::abstolStep", abstolStep_);
     s.pack("Newton::print_iteration", print_iteration_);
     s.pack("Newton::line_search", line_search_);
+    s.pack("Newton::reuse_jacobian", reuse_jacobian_);
+    s.pack("Newton::broyden", broyden_);
+    s.pack("Newton::contraction_tol", contraction_tol_);
   }
 
 } // namespace casadi
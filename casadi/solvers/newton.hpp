@@ -54,10 +54,18 @@ namespace casadi {
     double* f_trial;
     // Current Jacobian
     double* jac;
+    // Residual at the previous iterate
+    double* f_prev;
+    // Last step taken
+    double* dx;
     // Return status
     const char* return_status;
     // Number of iterations
     casadi_int iter;
+    // Number of Jacobian evaluations, performed and avoided
+    casadi_int n_jac_eval, n_jac_saved;
+    // Number of factorizations, performed and avoided
+    casadi_int n_fact, n_fact_saved;
   };
 
   /** \brief \pluginbrief{Rootfinder,newton}
@@ -145,6 +153,15 @@ namespace casadi {
 
     bool line_search_;
 
+    /// Reuse the Jacobian between iterations (simplified Newton)
+    bool reuse_jacobian_;
+
+    /// Apply rank-one Broyden updates to a reused Jacobian
+    bool broyden_;
+
+    /// Maximum residual contraction rate before the Jacobian is reevaluated
+    double contraction_tol_;
+
     /// Print iteration header
     void printIteration(std::ostream &stream) const;
 
@@ -44,6 +44,19 @@
 "+-----------------+-----------+--------------------------------------------+\n"
 "| abstolStep      | OT_DOUBLE | Stopping criterion tolerance on step size  |\n"
 "+-----------------+-----------+--------------------------------------------+\n"
+"| contraction_tol | OT_DOUBLE | Reevaluate a reused Jacobian when max(|F|) |\n"
+"|                 |           | decreases by less than this factor in an   |\n"
+"|                 |           | iteration (default: 0.5)                   |\n"
+"+-----------------+-----------+--------------------------------------------+\n"
+"| jacobian_update | OT_STRING | How to obtain the Jacobian in each         |\n"
+"|                 |           | iteration: 'exact' evaluates and           |\n"
+"|                 |           | factorizes it in every iteration           |\n"
+"|                 |           | (default), 'simplified' reuses the last    |\n"
+"|                 |           | evaluated Jacobian and its factorization,  |\n"
+"|                 |           | 'broyden' reuses the last evaluated        |\n"
+"|                 |           | Jacobian with rank-one Broyden updates,    |\n"
+"|                 |           | restricted to its sparsity pattern         |\n"
+"+-----------------+-----------+--------------------------------------------+\n"
 "| line_search     | OT_BOOL   | Enable line-search (default: true)         |\n"
 "+-----------------+-----------+--------------------------------------------+\n"
 "| max_iter        | OT_INT    | Maximum number of Newton iterations to     |\n"
@@ -79,7 +79,11 @@ namespace casadi {
         "Printed numbers are 0-based indices into the vector of [simple bounds;linear bounds]"}},
       {"min_lam",
        {OT_DOUBLE,
-        "Smallest multiplier treated as inactive for the initial active set [0]."}}
+        "Smallest multiplier treated as inactive for the initial active set [0]."}},
+      {"reuse_factorization",
+       {OT_BOOL,
+        "Keep the last factorization of the KKT system between calls and reuse it "
+        "if the active set, H and A are unchanged [true]."}}
      }
   };
 
@@ -104,6 +108,7 @@ namespace casadi {
     print_header_ = true;
     print_info_ = true;
     print_lincomb_ = false;
+    reuse_factorization_ = true;
 
     // Read user options
     for (auto&& op : opts) {
@@ -123,6 +128,8 @@ namespace casadi {
         print_info_ = op.second;
       } else if (op.first=="print_lincomb") {
         print_lincomb_ = op.second;
+      } else if (op.first=="reuse_factorization") {
+        reuse_factorization_ = op.second;
       }
     }
 
@@ -160,6 +167,15 @@ namespace casadi {
     m->d.qp = &m->d_qp;
 
     casadi_qrqp_init(&m->d, &iw, &w);
+
+    // Factorization in persistent memory
+    if (reuse_factorization_) {
+      m->d.nz_v = get_ptr(m->nz_vr);
+      m->d.nz_r = m->d.nz_v + sp_v_.nnz();
+      m->d.beta = get_ptr(m->beta);
+      m->d.kkt_fact = get_ptr(m->kkt_fact);
+      m->d.fact_valid = m->fact_valid;
+    }
   }
 
   void Qrqp::set_qrqp_prob() {
@@ -177,6 +193,12 @@ namespace casadi {
     if (Conic::init_mem(mem)) return 1;
     auto m = static_cast<QrqpMemory*>(mem);
     m->return_status = "";
+    m->fact_valid = 0;
+    if (reuse_factorization_) {
+      m->kkt_fact.resize(kkt_.nnz());
+      m->nz_vr.resize(std::max(sp_v_.nnz() + sp_r_.nnz(), kkt_.nnz()));
+      m->beta.resize(nx_ + na_);
+    }
     return 0;
   }
 
@@ -248,6 +270,9 @@ namespace casadi {
         m->return_status = "Printing error";
         break;
     }
+    // Factorization available for the next call
+    m->fact_valid = d.fact_valid;
+    d_qp.iter_count = d.iter;
     // Get solution
     casadi_copy(&d.f, 1, d_qp.f);
     casadi_copy(d.z, nx_, d_qp.x);
@@ -348,11 +373,13 @@ namespace casadi {
     Dict stats = Conic::get_stats(mem);
     auto m = static_cast<QrqpMemory*>(mem);
     stats["return_status"] = m->return_status;
+    stats["n_fact"] = m->d.n_fact;
+    stats["n_fact_reused"] = m->d.n_reuse;
     return stats;
   }
 
   Qrqp::Qrqp(DeserializingStream& s) : Conic(s) {
-    s.version("Qrqp", 1);
+    int version = s.version("Qrqp", 1, 2);
     s.unpack("Qrqp::AT", AT_);
     s.unpack("Qrqp::kkt", kkt_);
     s.unpack("Qrqp::sp_v", sp_v_);
@@ -368,12 +395,17 @@ namespace casadi {
     s.unpack("Qrqp::min_lam", p_.min_lam);
     s.unpack("Qrqp::constr_viol_tol", p_.constr_viol_tol);
     s.unpack("Qrqp::dual_inf_tol", p_.dual_inf_tol);
+    if (version >= 2) {
+      s.unpack("Qrqp::reuse_factorization", reuse_factorization_);
+    } else {
+      reuse_factorization_ = false;
+    }
   }
 
   void Qrqp::serialize_body(SerializingStream &s) const {
     Conic::serialize_body(s);
 
-    s.version("Qrqp", 1);
+    s.version("Qrqp", 2);
     s.pack("Qrqp::AT", AT_);
     s.pack("Qrqp::kkt", kkt_);
     s.pack("Qrqp::sp_v", sp_v_);
@@ -388,6 +420,7 @@ namespace casadi {
     s.pack("Qrqp::min_lam", p_.min_lam);
     s.pack("Qrqp::constr_viol_tol", p_.constr_viol_tol);
     s.pack("Qrqp::dual_inf_tol", p_.dual_inf_tol);
+    s.pack("Qrqp::reuse_factorization", reuse_factorization_);
   }
 
 } // namespace casadi
@@ -45,6 +45,9 @@ namespace casadi {
     // Problem data structure
     casadi_qrqp_data<double> d;
     const char* return_status;
+    // Factorization kept between calls
+    std::vector<double> kkt_fact, nz_vr, beta;
+    int fact_valid;
   };
 
   /** \brief \pluginbrief{Conic,qrqp}
@@ -119,6 +122,7 @@ namespace casadi {
     ///@{
     // Options
     bool print_iter_, print_header_, print_info_, print_lincomb_;
+    bool reuse_factorization_;
     ///@}
 
     void serialize_body(SerializingStream &s) const override;
@@ -37,30 +37,36 @@
 "\n"
 ">List of available options\n"
 "\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"|       Id        |   Type    |                Description                 |\n"
-"+=================+===========+============================================+\n"
-"| constr_viol_tol | OT_DOUBLE | Constraint violation tolerance [1e-8].     |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| dual_inf_tol    | OT_DOUBLE | Dual feasibility violation tolerance       |\n"
-"|                 |           | [1e-8]                                     |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| max_iter        | OT_INT    | Maximum number of iterations [1000].       |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| min_lam         | OT_DOUBLE | Smallest multiplier treated as inactive    |\n"
-"|                 |           | for the initial active set [0].            |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| print_header    | OT_BOOL   | Print header [true].                       |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| print_info      | OT_BOOL   | Print info [true].                         |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| print_iter      | OT_BOOL   | Print iterations [true].                   |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
-"| print_lincomb   | OT_BOOL   | Print dependant linear combinations of     |\n"
-"|                 |           | constraints [false]. Printed numbers are   |\n"
-"|                 |           | 0-based indices into the vector of [simple |\n"
-"|                 |           | bounds;linear bounds]                      |\n"
-"+-----------------+-----------+--------------------------------------------+\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"|         Id          |   Type    |              Description               |\n"
+"+=====================+===========+========================================+\n"
+"| constr_viol_tol     | OT_DOUBLE | Constraint violation tolerance [1e-8]. |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| dual_inf_tol        | OT_DOUBLE | Dual feasibility violation tolerance   |\n"
+"|                     |           | [1e-8]                                 |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| max_iter            | OT_INT    | Maximum number of iterations [1000].   |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| min_lam             | OT_DOUBLE | Smallest multiplier treated as         |\n"
+"|                     |           | inactive for the initial active set    |\n"
+"|                     |           | [0].                                   |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| print_header        | OT_BOOL   | Print header [true].                   |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| print_info          | OT_BOOL   | Print info [true].                     |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| print_iter          | OT_BOOL   | Print iterations [true].               |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| print_lincomb       | OT_BOOL   | Print dependant linear combinations of |\n"
+"|                     |           | constraints [false]. Printed numbers   |\n"
+"|                     |           | are 0-based indices into the vector of |\n"
+"|                     |           | [simple bounds;linear bounds]          |\n"
+"+---------------------+-----------+----------------------------------------+\n"
+"| reuse_factorization | OT_BOOL   | Keep the last factorization of the KKT |\n"
+"|                     |           | system between calls and reuse it if   |\n"
+"|                     |           | the active set, H and A are unchanged  |\n"
+"|                     |           | [true].                                |\n"
+"+---------------------+-----------+----------------------------------------+\n"
 "\n"
 "\n"
 "\n"
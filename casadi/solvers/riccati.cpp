@@ -0,0 +1,509 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "riccati.hpp"
+
+namespace casadi {
+
+  extern "C"
+  int CASADI_CONIC_RICCATI_EXPORT
+  casadi_register_conic_riccati(Conic::Plugin* plugin) {
+    plugin->creator = Riccati::creator;
+    plugin->name = "riccati";
+    plugin->doc = Riccati::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &Riccati::options_;
+    plugin->deserialize = &Riccati::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_CONIC_RICCATI_EXPORT casadi_load_conic_riccati() {
+    Conic::registerPlugin(casadi_register_conic_riccati);
+  }
+
+  Riccati::Riccati(const std::string& name, const std::map<std::string, Sparsity> &st)
+    : Conic(name, st) {
+  }
+
+  Riccati::~Riccati() {
+    clear_mem();
+  }
+
+  const Options Riccati::options_
+  = {{&Conic::options_},
+     {{"max_iter",
+       {OT_INT,
+        "Maximum number of iterations [100]."}},
+      {"pr_tol",
+       {OT_DOUBLE,
+        "Primal feasibility tolerance [1e-8]."}},
+      {"du_tol",
+       {OT_DOUBLE,
+        "Dual feasibility tolerance [1e-8]."}},
+      {"co_tol",
+       {OT_DOUBLE,
+        "Complementarity tolerance [1e-8]."}},
+      {"mu_tol",
+       {OT_DOUBLE,
+        "Barrier parameter tolerance [1e-8]."}},
+      {"print_header",
+       {OT_BOOL,
+        "Print header [true]."}},
+      {"print_iter",
+       {OT_BOOL,
+        "Print iterations [true]."}},
+      {"print_info",
+       {OT_BOOL,
+        "Print info [true]."}},
+      {"N",
+       {OT_INT,
+        "OCP horizon"}},
+      {"nx",
+       {OT_INTVECTOR,
+        "Number of states, length N+1"}},
+      {"nu",
+       {OT_INTVECTOR,
+        "Number of controls, length N or N+1"}},
+      {"ng",
+       {OT_INTVECTOR,
+        "Number of non-dynamic constraints, length N+1"}},
+      {"structure_detection",
+       {OT_STRING,
+        "AUTO | manual"}}
+     }
+  };
+
+  void Riccati::init(const Dict& opts) {
+    // Initialize the base classes
+    Conic::init(opts);
+    // Setup memory structure
+    set_qp_prob();
+    // Default options
+    print_iter_ = true;
+    print_header_ = true;
+    print_info_ = true;
+    bool manual = false;
+    casadi_int struct_cnt = 0;
+    N_ = 0;
+    // Read user options
+    for (auto&& op : opts) {
+      if (op.first=="max_iter") {
+        p_.max_iter = op.second;
+      } else if (op.first=="pr_tol") {
+        p_.pr_tol = op.second;
+      } else if (op.first=="du_tol") {
+        p_.du_tol = op.second;
+      } else if (op.first=="co_tol") {
+        p_.co_tol = op.second;
+      } else if (op.first=="mu_tol") {
+        p_.mu_tol = op.second;
+      } else if (op.first=="print_iter") {
+        print_iter_ = op.second;
+      } else if (op.first=="print_header") {
+        print_header_ = op.second;
+      } else if (op.first=="print_info") {
+        print_info_ = op.second;
+      } else if (op.first=="N") {
+        N_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="nx") {
+        nxs_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="nu") {
+        nus_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="ng") {
+        ngs_ = op.second;
+        struct_cnt++;
+      } else if (op.first=="structure_detection") {
+        std::string v = op.second;
+        if (v=="auto") {
+          manual = false;
+        } else if (v=="manual") {
+          manual = true;
+        } else {
+          casadi_error("Unknown option for structure_detection: '" + v + "'.");
+        }
+      }
+    }
+    if (manual) {
+      casadi_assert(struct_cnt==4, "You must set all of N, nx, nu, ng.");
+      if (nus_.size()==N_) nus_.push_back(0);
+      casadi_assert(nxs_.size()==N_+1, "nx must have length N+1.");
+      casadi_assert(nus_.size()==N_+1, "nu must have length N or N+1.");
+      casadi_assert(ngs_.size()==N_+1, "ng must have length N+1.");
+    } else {
+      casadi_assert(struct_cnt==0,
+        "You must set structure_detection to 'manual' if you set N, nx, nu, ng.");
+      detect_ocp_structure(N_, nxs_, nus_, ngs_);
+    }
+    if (verbose_) {
+      casadi_message("Using structure: N " + str(N_) + ", nx " + str(nxs_) + ", "
+            "nu " + str(nus_) + ", ng " + str(ngs_) + ".");
+    }
+    // Map H and A to the stage blocks
+    set_structure();
+    // Memory for IP solver
+    alloc_w(casadi_ipqp_sz_w(&p_), true);
+    // Memory for the Riccati recursion
+    alloc_w(sz_buf_ + max_m_, true);
+    alloc_iw(sz_ipiv_, true);
+    // Print summary
+    if (print_header_) {
+      print("-------------------------------------------\n");
+      print("This is casadi::Riccati\n");
+      print("Number of variables:             %12d\n", nx_);
+      print("Number of constraints:           %12d\n", na_);
+      print("Number of nonzeros in H:         %12d\n", H_.nnz());
+      print("Number of nonzeros in A:         %12d\n", A_.nnz());
+      print("Number of stages:                %12d\n", N_ + 1);
+    }
+  }
+
+  void Riccati::set_structure() {
+    std::string hint = " Consider setting structure_detection to 'manual'.";
+    // Consistency checks
+    casadi_int nz_tot = 0, na_tot = 0;
+    for (casadi_int k=0; k<=N_; ++k) {
+      casadi_assert(nxs_[k]>=0 && nus_[k]>=0 && ngs_[k]>=0,
+        "Stage dimensions must be nonnegative.");
+      nz_tot += nxs_[k] + nus_[k];
+      na_tot += ngs_[k] + (k<N_ ? nxs_[k+1] : 0);
+    }
+    casadi_assert(nz_tot==nx_, "Stage structure has " + str(nz_tot) + " variables, "
+      "but the QP has " + str(nx_) + "." + hint);
+    casadi_assert(na_tot==na_, "Stage structure has " + str(na_tot) + " constraints, "
+      "but the QP has " + str(na_) + "." + hint);
+    // Stage sizes and buffer offsets
+    stages_.resize(N_+1);
+    casadi_int off_z = 0, off_a = 0, off_buf = 0, off_iw = 0;
+    max_m_ = 0;
+    for (casadi_int k=0; k<=N_; ++k) {
+      casadi_riccati_stage& s = stages_[k];
+      s.ng = ngs_[k];
+      s.nx1 = k<N_ ? nxs_[k+1] : 0;
+      s.ny = nxs_[k] + nus_[k];
+      s.m = s.ny + s.nx1 + s.ng;
+      s.off_z = off_z;
+      s.off_a = off_a;
+      off_z += s.ny;
+      off_a += s.nx1 + s.ng;
+      s.S = off_buf; off_buf += s.m * s.m;
+      s.e = off_buf; off_buf += s.nx1;
+      s.t = off_buf; off_buf += s.m;
+      s.ipiv = off_iw; off_iw += s.m;
+      max_m_ = std::max(max_m_, s.m);
+    }
+    sz_buf_ = off_buf;
+    sz_ipiv_ = off_iw;
+    // Stage and position in the stage block of each variable and constraint
+    std::vector<casadi_int> z_stage(nx_), z_local(nx_), a_stage(na_), a_local(na_);
+    for (casadi_int k=0; k<=N_; ++k) {
+      const casadi_riccati_stage& s = stages_[k];
+      for (casadi_int i=0; i<s.ny; ++i) {
+        z_stage[s.off_z + i] = k;
+        z_local[s.off_z + i] = i;
+      }
+      for (casadi_int j=0; j<s.nx1+s.ng; ++j) {
+        a_stage[s.off_a + j] = k;
+        a_local[s.off_a + j] = s.ny + j;
+      }
+    }
+    // Hessian must be block diagonal
+    const casadi_int *h_colind = H_.colind(), *h_row = H_.row();
+    h_dest_.resize(H_.nnz());
+    for (casadi_int c=0; c<nx_; ++c) {
+      for (casadi_int k=h_colind[c]; k<h_colind[c+1]; ++k) {
+        casadi_int r = h_row[k];
+        casadi_assert(z_stage[r]==z_stage[c],
+          "H is not block diagonal: entry (" + str(r) + ", " + str(c) + ") couples "
+          "stages " + str(z_stage[r]) + " and " + str(z_stage[c]) + "." + hint);
+        const casadi_riccati_stage& s = stages_[z_stage[c]];
+        h_dest_[k] = s.S + z_local[r] + z_local[c] * s.m;
+      }
+    }
+    // Constraint Jacobian must have the dynamics and path constraint blocks
+    const casadi_int *a_colind = A_.colind(), *a_row = A_.row();
+    a_dest_.resize(2 * A_.nnz());
+    for (casadi_int c=0; c<nx_; ++c) {
+      for (casadi_int k=a_colind[c]; k<a_colind[c+1]; ++k) {
+        casadi_int r = a_row[k];
+        const casadi_riccati_stage& s = stages_[a_stage[r]];
+        casadi_int j = a_local[r];
+        if (z_stage[c]==a_stage[r]) {
+          // Entry in the stage block and its transpose
+          a_dest_[2 * k] = s.S + j + z_local[c] * s.m;
+          a_dest_[2 * k + 1] = s.S + z_local[c] + j * s.m;
+        } else {
+          // Only the x[k+1] diagonal is allowed to couple to the next stage
+          casadi_assert(j - s.ny < s.nx1 && z_stage[c]==a_stage[r]+1
+            && z_local[c]==j - s.ny,
+            "A does not have the expected stage structure: entry (" + str(r) + ", "
+            + str(c) + ") is not part of a stage or the x[k+1] diagonal." + hint);
+          a_dest_[2 * k] = s.e + j - s.ny;
+          a_dest_[2 * k + 1] = -1;
+        }
+      }
+    }
+    // Structure passed to the runtime
+    r_.sp_h = H_;
+    r_.sp_a = A_;
+    r_.N = N_;
+    r_.stages = get_ptr(stages_);
+    r_.h_dest = get_ptr(h_dest_);
+    r_.a_dest = get_ptr(a_dest_);
+    r_.sz_buf = sz_buf_;
+  }
+
+  void Riccati::set_qp_prob() {
+    casadi_ipqp_setup(&p_, nx_, na_);
+  }
+
+  int Riccati::init_mem(void* mem) const {
+    if (Conic::init_mem(mem)) return 1;
+    auto m = static_cast<RiccatiMemory*>(mem);
+    m->return_status = "";
+    return 0;
+  }
+
+  int Riccati::
+  solve(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const {
+    auto m = static_cast<RiccatiMemory*>(mem);
+    // Message buffer
+    char buf[121];
+    // Setup IP solver
+    casadi_ipqp_data<double> d;
+    d.prob = &p_;
+    casadi_ipqp_init(&d, &iw, &w);
+    casadi_ipqp_bounds(&d, arg[CONIC_G],
+      arg[CONIC_LBX], arg[CONIC_UBX], arg[CONIC_LBA], arg[CONIC_UBA]);
+    casadi_ipqp_guess(&d, arg[CONIC_X0], arg[CONIC_LAM_X0], arg[CONIC_LAM_A0]);
+    // Reverse communication loop
+    while (casadi_ipqp(&d)) {
+      switch (d.task) {
+      case IPQP_MV:
+        // Matrix-vector multiplication
+        casadi_mv(arg[CONIC_H], H_, d.z, d.rz, 0);
+        casadi_mv(arg[CONIC_A], A_, d.lam + p_.nx, d.rz, 1);
+        casadi_mv(arg[CONIC_A], A_, d.z, d.rz + p_.nx, 0);
+        break;
+      case IPQP_PROGRESS:
+        // Print progress
+        if (print_iter_) {
+          if (d.iter % 10 == 0) {
+            // Print header
+            if (casadi_ipqp_print_header(&d, buf, sizeof(buf))) break;
+            uout() << buf << "\n";
+          }
+          // Print iteration
+          if (casadi_ipqp_print_iteration(&d, buf, sizeof(buf))) break;
+          uout() << buf << "\n";
+          // User interrupt?
+          InterruptHandler::check();
+        }
+        break;
+      case IPQP_FACTOR:
+        // Factorize the KKT system stage by stage
+        if (casadi_riccati_factor(&r_, arg[CONIC_H], arg[CONIC_A], d.S, d.D, w, iw))
+          d.status = IPQP_FACTOR_ERROR;
+        break;
+      case IPQP_SOLVE:
+        // Solve the KKT system by a backward and a forward sweep
+        casadi_riccati_solve(&r_, d.linsys, w, iw);
+        break;
+      }
+    }
+    // Read return status
+    m->return_status = casadi_ipqp_return_status(d.status);
+    m->d_qp.iter_count = d.iter;
+    if (d.status == IPQP_MAX_ITER)
+      m->d_qp.unified_return_status = SOLVER_RET_LIMITED;
+    // Get solution
+    casadi_ipqp_solution(&d, res[CONIC_X], res[CONIC_LAM_X], res[CONIC_LAM_A]);
+    if (res[CONIC_COST]) {
+      *res[CONIC_COST] = .5 * casadi_bilin(arg[CONIC_H], H_, d.z, d.z)
+        + casadi_dot(p_.nx, d.z, d.g);
+    }
+    // Return
+    if (verbose_) casadi_warning(m->return_status);
+    m->d_qp.success = d.status == IPQP_SUCCESS;
+    return 0;
+  }
+
+  void Riccati::codegen_body(CodeGenerator& g) const {
+    // CASADI_SNPRINTF must be defined before the iteration printing is generated
+    if (print_iter_) g.add_auxiliary(CodeGenerator::AUX_PRINTF);
+    g.add_auxiliary(CodeGenerator::AUX_IPQP);
+    g.add_auxiliary(CodeGenerator::AUX_RICCATI);
+    g.local("d", "struct casadi_ipqp_data");
+    g.local("p", "struct casadi_ipqp_prob");
+    g.local("r", "struct casadi_riccati_prob");
+    g.local("stages[" + str(N_+1) + "]", "static struct casadi_riccati_stage");
+    if (print_iter_) g.local("buf[121]", "char");
+
+    // Setup memory structure
+    g << "casadi_ipqp_setup(&p, " << nx_ << ", " << na_ << ");\n";
+    g << "p.max_iter = " << p_.max_iter << ";\n";
+    g << "p.pr_tol = " << g.constant(p_.pr_tol) << ";\n";
+    g << "p.du_tol = " << g.constant(p_.du_tol) << ";\n";
+    g << "p.co_tol = " << g.constant(p_.co_tol) << ";\n";
+    g << "p.mu_tol = " << g.constant(p_.mu_tol) << ";\n";
+    g << "r.sp_h = " << g.sparsity(H_) << ";\n";
+    g << "r.sp_a = " << g.sparsity(A_) << ";\n";
+    g << "r.N = " << N_ << ";\n";
+    g << "casadi_unpack_riccati_stages(stages, " << g.constant(riccati_stages_pack()) << ");\n";
+    g << "r.stages = stages;\n";
+    g << "r.h_dest = " << g.constant(h_dest_) << ";\n";
+    g << "r.a_dest = " << g.constant(a_dest_) << ";\n";
+    g << "r.sz_buf = " << sz_buf_ << ";\n";
+
+    // Setup data structure
+    g << "d.prob = &p;\n";
+    g << "casadi_ipqp_init(&d, &iw, &w);\n";
+
+    g.comment("Pass bounds on z");
+    g << "d.g = " << g.arg(CONIC_G) << ";\n";
+    g.copy_default(g.arg(CONIC_LBX), nx_, "d.lbz", "-casadi_inf", false);
+    g.copy_default(g.arg(CONIC_LBA), na_, "d.lbz+" + str(nx_), "-casadi_inf", false);
+    g.copy_default(g.arg(CONIC_UBX), nx_, "d.ubz", "casadi_inf", false);
+    g.copy_default(g.arg(CONIC_UBA), na_, "d.ubz+" + str(nx_), "casadi_inf", false);
+
+    g.comment("Pass initial guess");
+    g << "casadi_ipqp_guess(&d, " << g.arg(CONIC_X0) << ", " << g.arg(CONIC_LAM_X0) << ", "
+      << g.arg(CONIC_LAM_A0) << ");\n";
+
+    g.comment("Solve QP");
+    g << "while (casadi_ipqp(&d)) {\n";
+    g << "switch (d.task) {\n";
+    g << "case IPQP_MV:\n";
+    g << g.mv(g.arg(CONIC_H), H_, "d.z", "d.rz", false) << "\n";
+    g << g.mv(g.arg(CONIC_A), A_, "d.lam+" + str(nx_), "d.rz", true) << "\n";
+    g << g.mv(g.arg(CONIC_A), A_, "d.z", "d.rz+" + str(nx_), false) << "\n";
+    g << "break;\n";
+    g << "case IPQP_PROGRESS:\n";
+    if (print_iter_) {
+      g << "if (d.iter % 10 == 0) {\n";
+      g << "if (casadi_ipqp_print_header(&d, buf, sizeof(buf))) break;\n";
+      g << g.printf("%s\\n", "buf") << "\n";
+      g << "}\n";
+      g << "if (casadi_ipqp_print_iteration(&d, buf, sizeof(buf))) break;\n";
+      g << g.printf("%s\\n", "buf") << "\n";
+    }
+    g << "break;\n";
+    g << "case IPQP_FACTOR:\n";
+    g << "if (casadi_riccati_factor(&r, " << g.arg(CONIC_H) << ", " << g.arg(CONIC_A)
+      << ", d.S, d.D, w, iw)) d.status = IPQP_FACTOR_ERROR;\n";
+    g << "break;\n";
+    g << "case IPQP_SOLVE:\n";
+    g << "casadi_riccati_solve(&r, d.linsys, w, iw);\n";
+    g << "break;\n";
+    g << "}\n";
+    g << "}\n";
+
+    g.comment("Get solution");
+    g << "casadi_ipqp_solution(&d, " << g.res(CONIC_X) << ", " << g.res(CONIC_LAM_X) << ", "
+      << g.res(CONIC_LAM_A) << ");\n";
+    g << "if (" << g.res(CONIC_COST) << ") {\n";
+    g << "*" << g.res(CONIC_COST) << " = 0.5*"
+      << g.bilin(g.arg(CONIC_H), H_, "d.z", "d.z") << "+"
+      << g.dot(nx_, "d.z", "d.g") << ";\n";
+    g << "}\n";
+
+    g << "if (d.status == IPQP_SUCCESS) {\n";
+    g << "return 0;\n";
+    g << "} else if (d.status == IPQP_MAX_ITER) {\n";
+    g << "return " << SOLVER_RET_LIMITED << ";\n";
+    g << "} else {\n";
+    if (error_on_fail_) {
+      g << "return -1000;\n";
+    } else {
+      g << "return -1;\n";
+    }
+    g << "}\n";
+  }
+
+  std::vector<casadi_int> Riccati::riccati_stages_pack() const {
+    std::vector<casadi_int> ret;
+    ret.push_back(stages_.size());
+    for (const casadi_riccati_stage& s : stages_) {
+      ret.push_back(s.ny);
+      ret.push_back(s.nx1);
+      ret.push_back(s.ng);
+      ret.push_back(s.m);
+      ret.push_back(s.off_z);
+      ret.push_back(s.off_a);
+      ret.push_back(s.S);
+      ret.push_back(s.e);
+      ret.push_back(s.t);
+      ret.push_back(s.ipiv);
+    }
+    return ret;
+  }
+
+  Dict Riccati::get_stats(void* mem) const {
+    Dict stats = Conic::get_stats(mem);
+    auto m = static_cast<RiccatiMemory*>(mem);
+    stats["return_status"] = m->return_status;
+    return stats;
+  }
+
+  Riccati::Riccati(DeserializingStream& s) : Conic(s) {
+    s.version("Riccati", 1);
+    s.unpack("Riccati::print_iter", print_iter_);
+    s.unpack("Riccati::print_header", print_header_);
+    s.unpack("Riccati::print_info", print_info_);
+    s.unpack("Riccati::N", N_);
+    s.unpack("Riccati::nxs", nxs_);
+    s.unpack("Riccati::nus", nus_);
+    s.unpack("Riccati::ngs", ngs_);
+    set_qp_prob();
+    s.unpack("Riccati::max_iter", p_.max_iter);
+    s.unpack("Riccati::pr_tol", p_.pr_tol);
+    s.unpack("Riccati::du_tol", p_.du_tol);
+    s.unpack("Riccati::co_tol", p_.co_tol);
+    s.unpack("Riccati::mu_tol", p_.mu_tol);
+    set_structure();
+  }
+
+  void Riccati::serialize_body(SerializingStream &s) const {
+    Conic::serialize_body(s);
+
+    s.version("Riccati", 1);
+    s.pack("Riccati::print_iter", print_iter_);
+    s.pack("Riccati::print_header", print_header_);
+    s.pack("Riccati::print_info", print_info_);
+    s.pack("Riccati::N", N_);
+    s.pack("Riccati::nxs", nxs_);
+    s.pack("Riccati::nus", nus_);
+    s.pack("Riccati::ngs", ngs_);
+    s.pack("Riccati::max_iter", p_.max_iter);
+    s.pack("Riccati::pr_tol", p_.pr_tol);
+    s.pack("Riccati::du_tol", p_.du_tol);
+    s.pack("Riccati::co_tol", p_.co_tol);
+    s.pack("Riccati::mu_tol", p_.mu_tol);
+  }
+
+} // namespace casadi
@@ -0,0 +1,152 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_RICCATI_HPP
+#define CASADI_RICCATI_HPP
+
+#include "casadi/core/conic_impl.hpp"
+#include <casadi/solvers/casadi_conic_riccati_export.h>
+
+/** \defgroup plugin_Conic_riccati Title
+    \par
+
+ Solves QPs with optimal control structure using a Mehrotra predictor-corrector
+ interior point method. The KKT systems are solved with a Riccati-type backward
+ recursion over the stages, at a cost that is linear in the horizon length.
+
+ The constraint matrix must have the block structure also used by fatrop:
+ for each stage k < N, nx[k+1] dynamics rows (coupling stage k to x[k+1] through
+ a diagonal) followed by ng[k] path constraints, and ng[N] terminal constraints.
+ The Hessian must be block diagonal over the stages.
+
+    \identifier{2dt} */
+
+/** \pluginsection{Conic,riccati} */
+
+/// \cond INTERNAL
+namespace casadi {
+  struct CASADI_CONIC_RICCATI_EXPORT RiccatiMemory : public ConicMemory {
+    const char* return_status;
+  };
+
+  /** \brief \pluginbrief{Conic,riccati}
+
+      @copydoc Conic_doc
+      @copydoc plugin_Conic_riccati
+  */
+  class CASADI_CONIC_RICCATI_EXPORT Riccati : public Conic {
+  public:
+    /** \brief  Create a new Solver */
+    explicit Riccati(const std::string& name,
+                     const std::map<std::string, Sparsity> &st);
+
+    /** \brief  Create a new QP Solver */
+    static Conic* creator(const std::string& name,
+                          const std::map<std::string, Sparsity>& st) {
+      return new Riccati(name, st);
+    }
+
+    /** \brief  Destructor */
+    ~Riccati() override;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "riccati";}
+
+    // Get name of the class
+    std::string class_name() const override { return "Riccati";}
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override { return new RiccatiMemory();}
+
+    /** \brief Initalize memory block */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override { delete static_cast<RiccatiMemory*>(mem);}
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    /** \brief Initialize */
+    void init(const Dict& opts) override;
+
+    /** \brief Solve the QP */
+    int solve(const double** arg, double** res,
+             casadi_int* iw, double* w, void* mem) const override;
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /** \brief Generate code for the function body */
+    void codegen_body(CodeGenerator& g) const override;
+
+    /// A documentation string
+    static const std::string meta_doc;
+    // Memory structure
+    casadi_ipqp_prob<double> p_;
+    ///@{
+    // Options
+    bool print_iter_, print_header_, print_info_;
+    ///@}
+
+    // Stage structure
+    casadi_int N_;
+    std::vector<casadi_int> nxs_, nus_, ngs_;
+
+    // Per-stage sizes and buffer offsets
+    std::vector<casadi_riccati_stage> stages_;
+
+    // Destination of the nonzeros of H and A (twice) in the factorization buffer
+    std::vector<casadi_int> h_dest_, a_dest_;
+
+    // Size of the factorization buffer and the pivots, largest stage block
+    casadi_int sz_buf_, sz_ipiv_, max_m_;
+
+    // Riccati recursion structure
+    casadi_riccati_prob<double> r_;
+
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new Riccati(s); }
+
+  protected:
+     /** \brief Deserializing constructor */
+    explicit Riccati(DeserializingStream& s);
+
+  private:
+    void set_qp_prob();
+    // Map the stage structure to the sparsity patterns of H and A
+    void set_structure();
+    // Stage structure packed for code generation
+    std::vector<casadi_int> riccati_stages_pack() const;
+  };
+
+} // namespace casadi
+/// \endcond
+#endif // CASADI_RICCATI_HPP
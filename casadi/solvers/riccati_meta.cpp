@@ -0,0 +1,84 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+      #include "riccati.hpp"
+      #include <string>
+
+      const std::string casadi::Riccati::meta_doc=
+      "\n"
+"\n"
+"\n"
+"Solves QPs with optimal control structure using a Mehrotra \n"
+"predictor-corrector interior point method. The KKT systems are solved with\n"
+"a Riccati-type backward recursion over the stages, at a cost that is \n"
+"linear in the horizon length.\n"
+"\n"
+"The constraint matrix must have the block structure also used by fatrop: \n"
+"for each stage k < N, nx[k+1] dynamics rows (coupling stage k to x[k+1] \n"
+"through a diagonal) followed by ng[k] path constraints, and ng[N] terminal\n"
+"constraints. The Hessian must be block diagonal over the stages.\n"
+"\n"
+"Extra doc: https://github.com/casadi/casadi/wiki/L_2dt \n"
+"\n"
+"\n"
+">List of available options\n"
+"\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"|         Id          |     Type     |             Description             |\n"
+"+=====================+==============+=====================================+\n"
+"| N                   | OT_INT       | OCP horizon                         |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| co_tol              | OT_DOUBLE    | Complementarity tolerance [1e-8].   |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| du_tol              | OT_DOUBLE    | Dual feasibility tolerance [1e-8].  |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| max_iter            | OT_INT       | Maximum number of iterations [100]. |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| mu_tol              | OT_DOUBLE    | Barrier parameter tolerance [1e-8]. |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| ng                  | OT_INTVECTOR | Number of non-dynamic constraints,  |\n"
+"|                     |              | length N+1                          |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| nu                  | OT_INTVECTOR | Number of controls, length N or N+1 |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| nx                  | OT_INTVECTOR | Number of states, length N+1        |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| pr_tol              | OT_DOUBLE    | Primal feasibility tolerance        |\n"
+"|                     |              | [1e-8].                             |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| print_header        | OT_BOOL      | Print header [true].                |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| print_info          | OT_BOOL      | Print info [true].                  |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| print_iter          | OT_BOOL      | Print iterations [true].            |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"| structure_detection | OT_STRING    | AUTO | manual                       |\n"
+"+---------------------+--------------+-------------------------------------+\n"
+"\n"
+"\n"
+"\n"
+"\n"
+;
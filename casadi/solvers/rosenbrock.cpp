@@ -0,0 +1,202 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#include "rosenbrock.hpp"
+
+namespace casadi {
+
+  extern "C"
+  int CASADI_INTEGRATOR_ROSENBROCK_EXPORT
+      casadi_register_integrator_rosenbrock(Integrator::Plugin* plugin) {
+    plugin->creator = Rosenbrock::creator;
+    plugin->name = "rosenbrock";
+    plugin->doc = Rosenbrock::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &Rosenbrock::options_;
+    plugin->deserialize = &Rosenbrock::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_INTEGRATOR_ROSENBROCK_EXPORT casadi_load_integrator_rosenbrock() {
+    Integrator::registerPlugin(casadi_register_integrator_rosenbrock);
+  }
+
+  Rosenbrock::Rosenbrock(const std::string& name, const Function& dae, double t0,
+      const std::vector<double>& tout)
+      : FixedStepIntegrator(name, dae, t0, tout) {
+  }
+
+  Rosenbrock::~Rosenbrock() {
+  }
+
+  const Options Rosenbrock::options_
+  = {{&FixedStepIntegrator::options_},
+     {{"rosenbrock_scheme",
+       {OT_STRING,
+        "Rosenbrock scheme: ros2|euler"}},
+      {"linear_solver",
+       {OT_STRING,
+        "Linear solver for the iteration matrix [qr]"}},
+      {"linear_solver_options",
+       {OT_DICT,
+        "Options to be passed to the linear solver"}}
+     }
+  };
+
+  void Rosenbrock::init(const Dict& opts) {
+    // Default options
+    rosenbrock_scheme_ = "ros2";
+    linear_solver_ = "qr";
+
+    // Read options
+    for (auto&& op : opts) {
+      if (op.first=="rosenbrock_scheme") {
+        rosenbrock_scheme_ = op.second.to_string();
+      } else if (op.first=="linear_solver") {
+        linear_solver_ = op.second.to_string();
+      } else if (op.first=="linear_solver_options") {
+        linear_solver_options_ = op.second;
+      }
+    }
+
+    // Consistency check
+    casadi_assert(rosenbrock_scheme_=="ros2" || rosenbrock_scheme_=="euler",
+      "Unknown Rosenbrock scheme '" + rosenbrock_scheme_ + "', expected ros2|euler");
+
+    // Call the base class init
+    FixedStepIntegrator::init(opts);
+
+    // Algebraic variables not supported
+    casadi_assert(nz_==0 && nrz_==0,
+      "Rosenbrock integrators do not support algebraic variables");
+  }
+
+  void Rosenbrock::setup_step() {
+    // Continuous-time dynamics, forward problem
+    Function f = get_function("dae");
+
+    // Symbolic inputs
+    MX t0 = MX::sym("t0", f.sparsity_in(DYN_T));
+    MX h = MX::sym("h");
+    MX x0 = MX::sym("x0", f.sparsity_in(DYN_X));
+    MX p = MX::sym("p", f.sparsity_in(DYN_P));
+    MX u = MX::sym("u", f.sparsity_in(DYN_U));
+
+    // Arguments when calling f
+    std::vector<MX> f_arg(DYN_NUM_IN);
+    std::vector<MX> f_res;
+    f_arg[DYN_T] = t0;
+    f_arg[DYN_X] = x0;
+    f_arg[DYN_P] = p;
+    f_arg[DYN_U] = u;
+    f_res = f(f_arg);
+    MX f0 = f_res[DYN_ODE];
+    MX f0q = f_res[DYN_QUAD];
+
+    // Linearization at the beginning of the step, the time being treated as an additional state
+    MX J = MX::jacobian(f0, x0);
+    MX Jq = MX::jacobian(f0q, x0);
+    MX ft = MX::zeros(nx1_), fqt = MX::zeros(nq1_);
+    if (!t0.is_empty()) {
+      ft = MX::jacobian(f0, t0);
+      fqt = MX::jacobian(f0q, t0);
+    }
+
+    // Stage contributions to the state and quadratures
+    MX xf, qf;
+    if (rosenbrock_scheme_ == "euler") {
+      // Linearly implicit Euler
+      MX M = MX::eye(nx1_) - h * J;
+      MX k1 = MX::solve(M, f0 + h * ft, linear_solver_, linear_solver_options_);
+      MX k1q = f0q + h * (mtimes(Jq, k1) + fqt);
+      xf = x0 + h * k1;
+      qf = h * k1q;
+    } else {
+      // ROS2, Verwer et al. (1999)
+      double gamma = 1 + 1 / std::sqrt(2.);
+      MX M = MX::eye(nx1_) - (gamma * h) * J;
+
+      // k1
+      MX k1 = MX::solve(M, f0 + (gamma * h) * ft, linear_solver_, linear_solver_options_);
+      MX k1q = f0q + (gamma * h) * (mtimes(Jq, k1) + fqt);
+
+      // k2
+      f_arg[DYN_T] = t0 + h;
+      f_arg[DYN_X] = x0 + h * k1;
+      f_res = f(f_arg);
+      MX k2 = MX::solve(M, f_res[DYN_ODE] - 2 * k1 - (gamma * h) * ft,
+        linear_solver_, linear_solver_options_);
+      MX k2q = f_res[DYN_QUAD] - 2 * k1q + (gamma * h) * (mtimes(Jq, k2) - fqt);
+
+      // Take step
+      xf = x0 + h * (1.5 * k1 + 0.5 * k2);
+      qf = h * (1.5 * k1q + 0.5 * k2q);
+    }
+
+    // Define discrete time dynamics
+    f_arg.resize(STEP_NUM_IN);
+    f_arg[STEP_T] = t0;
+    f_arg[STEP_H] = h;
+    f_arg[STEP_X0] = x0;
+    f_arg[STEP_V0] = MX(0, 1);
+    f_arg[STEP_P] = p;
+    f_arg[STEP_U] = u;
+    f_res.resize(STEP_NUM_OUT);
+    f_res[STEP_XF] = xf;
+    f_res[STEP_QF] = qf;
+    f_res[STEP_VF] = MX(0, 1);
+    Function F("step", f_arg, f_res,
+      {"t", "h", "x0", "v0", "p", "u"}, {"xf", "vf", "qf"});
+    set_function(F, F.name(), true);
+    if (nfwd_ > 0) create_forward("step", nfwd_);
+
+    // Backward integration
+    if (nadj_ > 0) {
+      Function adj_F = F.reverse(nadj_);
+      set_function(adj_F, adj_F.name(), true);
+      if (nfwd_ > 0) {
+        create_forward(adj_F.name(), nfwd_);
+      }
+    }
+  }
+
+  Rosenbrock::Rosenbrock(DeserializingStream& s) : FixedStepIntegrator(s) {
+    s.version("Rosenbrock", 1);
+    s.unpack("Rosenbrock::rosenbrock_scheme", rosenbrock_scheme_);
+    s.unpack("Rosenbrock::linear_solver", linear_solver_);
+    s.unpack("Rosenbrock::linear_solver_options", linear_solver_options_);
+  }
+
+  void Rosenbrock::serialize_body(SerializingStream &s) const {
+    FixedStepIntegrator::serialize_body(s);
+    s.version("Rosenbrock", 1);
+    s.pack("Rosenbrock::rosenbrock_scheme", rosenbrock_scheme_);
+    s.pack("Rosenbrock::linear_solver", linear_solver_);
+    s.pack("Rosenbrock::linear_solver_options", linear_solver_options_);
+  }
+
+} // namespace casadi
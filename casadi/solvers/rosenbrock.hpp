@@ -0,0 +1,114 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_ROSENBROCK_HPP
+#define CASADI_ROSENBROCK_HPP
+
+#include "casadi/core/integrator_impl.hpp"
+#include <casadi/solvers/casadi_integrator_rosenbrock_export.h>
+
+/** \defgroup plugin_Integrator_rosenbrock Title
+    \par
+
+      Fixed-step linearly implicit (Rosenbrock) Runge-Kutta integrator for stiff ODEs
+
+      The Jacobian of the ODE right-hand-side is evaluated once per step and every
+      stage requires the solution of a linear system with the iteration matrix
+      I - gamma*h*J, but no Newton iterations. Implements the L-stable second order
+      ROS2 scheme and the linearly implicit Euler method.
+
+    \identifier{2dn} */
+/** \pluginsection{Integrator,rosenbrock} */
+
+/// \cond INTERNAL
+namespace casadi {
+
+  /** \brief \pluginbrief{Integrator,rosenbrock}
+
+      @copydoc plugin_Integrator_rosenbrock
+
+  */
+  class CASADI_INTEGRATOR_ROSENBROCK_EXPORT Rosenbrock : public FixedStepIntegrator {
+   public:
+
+    /// Constructor
+    Rosenbrock(const std::string& name, const Function& dae, double t0,
+      const std::vector<double>& tout);
+
+    /** \brief  Create a new integrator */
+    static Integrator* creator(const std::string& name, const Function& dae,
+        double t0, const std::vector<double>& tout) {
+      return new Rosenbrock(name, dae, t0, tout);
+    }
+
+    /// Destructor
+    ~Rosenbrock() override;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "rosenbrock";}
+
+    // Get name of the class
+    std::string class_name() const override { return "Rosenbrock";}
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    /// Initialize stage
+    void init(const Dict& opts) override;
+
+    /// Setup step functions
+    void setup_step() override;
+
+    // Rosenbrock scheme
+    std::string rosenbrock_scheme_;
+
+    // Linear solver for the iteration matrix
+    std::string linear_solver_;
+
+    // Options for the linear solver
+    Dict linear_solver_options_;
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    /** \brief Serialize an object without type information */
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize into MX */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new Rosenbrock(s); }
+
+   protected:
+
+    /** \brief Deserializing constructor */
+    explicit Rosenbrock(DeserializingStream& s);
+  };
+
+} // namespace casadi
+
+/// \endcond
+#endif // CASADI_ROSENBROCK_HPP
@@ -124,6 +124,9 @@ namespace casadi {
     f_res[STEP_XF] = xf;
     f_res[STEP_QF] = qf;
     f_res[STEP_VF] = MX(0, 1);
+    // Expose the stages for interpolation within the step
+    if (dense_output_) f_res[STEP_VF] = vertcat(std::vector<MX>{k1, k2, k3, k4,
+      k1q, k2q, k3q, k4q});
     Function F("step", f_arg, f_res,
       {"t", "h", "x0", "v0", "p", "u"}, {"xf", "vf", "qf"});
     set_function(F, F.name(), true);
@@ -137,6 +140,23 @@ namespace casadi {
         create_forward(adj_F.name(), nfwd_);
       }
     }
+
+    // Continuous extension of RK4, third order accurate
+    if (dense_output_) {
+      MX v = MX::sym("v", F.sparsity_out(STEP_VF));
+      MX theta = MX::sym("theta");
+      std::vector<MX> k = vertsplit(v, {0, nx1_, 2*nx1_, 3*nx1_, 4*nx1_,
+        4*nx1_ + nq1_, 4*nx1_ + 2*nq1_, 4*nx1_ + 3*nq1_, 4*nx1_ + 4*nq1_});
+      MX theta2 = theta * theta, theta3 = theta2 * theta;
+      MX b1 = theta - 3 * theta2 / 2 + 2 * theta3 / 3;
+      MX b23 = theta2 - 2 * theta3 / 3;
+      MX b4 = 2 * theta3 / 3 - theta2 / 2;
+      MX x = x0 + h * (b1 * k[0] + b23 * (k[1] + k[2]) + b4 * k[3]);
+      MX q = h * (b1 * k[4] + b23 * (k[5] + k[6]) + b4 * k[7]);
+      Function D("dense", {t0, h, x0, v, p, u, theta}, {x, MX(0, 1), q},
+        {"t", "h", "x0", "v", "p", "u", "theta"}, {"x", "z", "q"});
+      set_function(D, D.name(), true);
+    }
   }
 
   RungeKutta::RungeKutta(DeserializingStream& s) : FixedStepIntegrator(s) {
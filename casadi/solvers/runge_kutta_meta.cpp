@@ -38,4 +38,36 @@
 "Extra doc: https://github.com/casadi/casadi/wiki/L_23a \n"
 "\n"
 "\n"
+">List of available options\n"
+"\n"
+"+---------------------------+-----------+----------------------------------+\n"
+"|            Id             |   Type    |           Description            |\n"
+"+===========================+===========+==================================+\n"
+"| dense_output              | OT_BOOL   | Take finite elements             |\n"
+"|                           |           | independently of the output      |\n"
+"|                           |           | times and obtain the outputs by  |\n"
+"|                           |           | interpolation within the finite  |\n"
+"|                           |           | elements. Finite elements still  |\n"
+"|                           |           | end at step changes in the       |\n"
+"|                           |           | controls. Not used for the       |\n"
+"|                           |           | backward problem or with events. |\n"
+"|                           |           | default: false                   |\n"
+"+---------------------------+-----------+----------------------------------+\n"
+"| number_of_finite_elements | OT_INT    | Target number of finite          |\n"
+"|                           |           | elements. The actual number may  |\n"
+"|                           |           | be higher to accommodate all     |\n"
+"|                           |           | output times                     |\n"
+"+---------------------------+-----------+----------------------------------+\n"
+"| simplify                  | OT_BOOL   | Implement as MX Function         |\n"
+"|                           |           | (codegeneratable/serializable)   |\n"
+"|                           |           | default: false                   |\n"
+"+---------------------------+-----------+----------------------------------+\n"
+"| simplify_options          | OT_DICT   | Any options to pass to           |\n"
+"|                           |           | simplified form Function         |\n"
+"|                           |           | constructor                      |\n"
+"+---------------------------+-----------+----------------------------------+\n"
+"\n"
+"\n"
+"\n"
+"\n"
 ;
@@ -101,6 +101,30 @@ const Options Sqpmethod::options_
     {"lbfgs_memory",
       {OT_INT,
       "Size of L-BFGS memory."}},
+    {"block_hessian",
+      {OT_BOOL,
+      "Limited-memory mode: Use a block-diagonal Hessian approximation with the diagonal "
+      "blocks of the sparsity pattern of the exact Hessian and separate BFGS updates for "
+      "each block. Storage and update cost are linear in the number of variables "
+      "for bounded block sizes [false]."}},
+    {"newton_cg",
+      {OT_BOOL,
+      "Compute the step with a truncated Newton-CG method using the Hessian-vector "
+      "products of 'nlp_hess_vec' instead of forming the Hessian and solving a QP. "
+      "Matrix-free, for problems without general constraints; variables at a bound "
+      "with the gradient pointing outwards are fixed and the step is projected onto "
+      "the bounds [false]."}},
+    {"cg_max_iter",
+      {OT_INT,
+      "Newton-CG: Maximum number of CG iterations per step [100]."}},
+    {"cg_tol",
+      {OT_DOUBLE,
+      "Newton-CG: Maximum relative residual of the truncated CG solve. The forcing term "
+      "min(cg_tol, sqrt(|g|)) gives superlinear local convergence [0.1]."}},
+    {"max_num_threads",
+      {OT_INT,
+      "Evaluate the constraint Jacobian and the exact Hessian of the Lagrangian "
+      "concurrently using up to this many threads [1]"}},
     {"print_header",
       {OT_BOOL,
       "Print the header with problem statistics"}},
@@ -150,7 +174,13 @@ const Options Sqpmethod::options_
       "(default: false)."}},
     {"init_feasible",
       {OT_BOOL,
-      "Initialize the QP subproblems with a feasible initial value (default: false)."}}
+      "Initialize the QP subproblems with a feasible initial value (default: false)."}},
+    {"rti_phase",
+      {OT_STRING,
+      "off|preparation|feedback. Real-time iteration phase (default: off). "
+      "A preparation call linearizes at x0 and stores the QP, "
+      "a feedback call solves the stored QP with the current bounds and takes a full step. "
+      "Can be switched between calls with change_option."}}
     }
 };
 
@@ -169,6 +199,10 @@ void Sqpmethod::init(const Dict& opts) {
   tol_pr_ = 1e-6;
   tol_du_ = 1e-6;
   std::string hessian_approximation = "exact";
+  bool block_hessian = false;
+  newton_cg_ = false;
+  cg_max_iter_ = 100;
+  cg_tol_ = 0.1;
   min_step_size_ = 1e-10;
   std::string qpsol_plugin = "qpoases";
   Dict qpsol_options;
@@ -181,6 +215,7 @@ void Sqpmethod::init(const Dict& opts) {
   gamma_1_min_ = 1e-5;
   so_corr_ = false;
   init_feasible_ = false;
+  rti_phase_ = RTI_OFF;
 
   std::string convexify_strategy = "none";
   double convexify_margin = 1e-7;
@@ -202,6 +237,16 @@ void Sqpmethod::init(const Dict& opts) {
       merit_memsize_ = op.second;
     } else if (op.first=="lbfgs_memory") {
       lbfgs_memory_ = op.second;
+    } else if (op.first=="block_hessian") {
+      block_hessian = op.second;
+    } else if (op.first=="newton_cg") {
+      newton_cg_ = op.second;
+    } else if (op.first=="cg_max_iter") {
+      cg_max_iter_ = op.second;
+    } else if (op.first=="cg_tol") {
+      cg_tol_ = op.second;
+    } else if (op.first=="max_num_threads") {
+      max_num_threads_ = op.second;
     } else if (op.first=="tol_pr") {
       tol_pr_ = op.second;
     } else if (op.first=="tol_du") {
@@ -248,6 +293,8 @@ void Sqpmethod::init(const Dict& opts) {
       so_corr_ = op.second;
     } else if (op.first=="init_feasible") {
       init_feasible_ = op.second;
+    } else if (op.first=="rti_phase") {
+      rti_phase_ = to_rti_phase(op.second.to_string());
     }
   }
 
@@ -261,13 +308,37 @@ void Sqpmethod::init(const Dict& opts) {
     }
   }
 
+  casadi_assert(max_num_threads_>=1, "Option 'max_num_threads' must be positive");
+#ifndef CASADI_WITH_THREAD
+  if (max_num_threads_>1) {
+    casadi_warning("CasADi was not compiled with WITH_THREAD=ON. "
+                   "Falling back to sequential evaluation.");
+    max_num_threads_ = 1;
+  }
+#endif // CASADI_WITH_THREAD
+
   // Use exact Hessian?
   exact_hessian_ = hessian_approximation =="exact";
 
+  if (newton_cg_) {
+    casadi_assert(ng_==0, "'newton_cg' requires a problem without general constraints, "
+      "simple bounds on x are supported.");
+    casadi_assert(exact_hessian_ && !block_hessian,
+      "'newton_cg' uses exact Hessian-vector products and cannot be combined with "
+      "a limited-memory Hessian approximation.");
+    casadi_assert(!elastic_mode_ && !so_corr_ && rti_phase_==RTI_OFF,
+      "'newton_cg' cannot be combined with elastic mode, second order corrections "
+      "or real-time iterations.");
+    // Second-order information only enters through Hessian-vector products
+    exact_hessian_ = false;
+  }
+
   convexify_ = false;
 
   // Get/generate required functions
-  if (max_iter_ls_ || so_corr_) create_function("nlp_fg", {"x", "p"}, {"f", "g"});
+  if (max_iter_ls_ || so_corr_ || rti_phase_!=RTI_OFF) {
+    create_function("nlp_fg", {"x", "p"}, {"f", "g"});
+  }
   // First order derivative information
 
   if (!has_function("nlp_jac_fg")) {
@@ -276,7 +347,10 @@ void Sqpmethod::init(const Dict& opts) {
   }
   Asp_ = get_function("nlp_jac_fg").sparsity_out(3);
 
-  if (exact_hessian_) {
+  if (newton_cg_) {
+    create_hess_vec();
+    Hsp_ = Sparsity(nx_, nx_);
+  } else if (exact_hessian_) {
     if (!has_function("nlp_hess_l")) {
       create_function("nlp_hess_l", {"x", "p", "lam:f", "lam:g"},
                     {"hess:gamma:x:x"}, {{"gamma", {"f", "g"}}});
@@ -292,14 +366,36 @@ void Sqpmethod::init(const Dict& opts) {
       opts["verbose"] = verbose_;
       Hsp_ = Convexify::setup(convexify_data_, Hsp_, opts);
     }
+  } else if (block_hessian) {
+    // Diagonal blocks of the exact Hessian, each approximated by a dense block
+    Sparsity hess_sp;
+    if (has_function("nlp_hess_l")) {
+      hess_sp = get_function("nlp_hess_l").sparsity_out(0);
+    } else if (has_function("nlp_grad")) {
+      // Sparsity propagation through the gradient of the Lagrangian
+      hess_sp = get_function("nlp_grad").jac_sparsity(2, 0);
+    } else {
+      Function grad_l = oracle_.factory("nlp_grad_l", {"x", "p", "lam:f", "lam:g"},
+        {"grad:gamma:x"}, {{"gamma", {"f", "g"}}});
+      hess_sp = grad_l.jac_sparsity(0, 0);
+    }
+    hess_blocks_ = diagonal_blocks(hess_sp);
+    std::vector<Sparsity> blocks;
+    for (casadi_int b=0; b+1<hess_blocks_.size(); ++b) {
+      casadi_int n = hess_blocks_[b+1] - hess_blocks_[b];
+      blocks.push_back(Sparsity::dense(n, n));
+    }
+    Hsp_ = diagcat(blocks);
   } else {
     Hsp_ = Sparsity::dense(nx_, nx_);
   }
 
-  casadi_assert(!qpsol_plugin.empty(), "'qpsol' option has not been set");
-  qpsol_ = conic("qpsol", qpsol_plugin, {{"h", Hsp_}, {"a", Asp_}},
-                  qpsol_options);
-  alloc(qpsol_);
+  if (!newton_cg_) {
+    casadi_assert(!qpsol_plugin.empty(), "'qpsol' option has not been set");
+    qpsol_ = conic("qpsol", qpsol_plugin, {{"h", Hsp_}, {"a", Asp_}},
+                    qpsol_options);
+    alloc(qpsol_);
+  }
 
   if (elastic_mode_) {
     // Generate sparsity patterns for elastic mode
@@ -324,7 +420,7 @@ void Sqpmethod::init(const Dict& opts) {
 
 
   // BFGS?
-  if (!exact_hessian_) {
+  if (!exact_hessian_ && !newton_cg_) {
     alloc_w(2*nx_); // casadi_bfgs
   }
 
@@ -332,10 +428,15 @@ void Sqpmethod::init(const Dict& opts) {
   if (print_header_) {
     print("-------------------------------------------\n");
     print("This is casadi::Sqpmethod.\n");
-    if (exact_hessian_) {
+    if (newton_cg_) {
+      print("Using truncated Newton-CG with Hessian-vector products\n");
+    } else if (exact_hessian_) {
       print("Using exact Hessian\n");
     } else {
       print("Using limited memory BFGS Hessian approximation\n");
+      if (!hess_blocks_.empty()) {
+        print("Number of diagonal Hessian blocks:         %9d\n", hess_blocks_.size()-1);
+      }
     }
     print("Number of variables:                       %9d\n", nx_);
     print("Number of constraints:                     %9d\n", ng_);
@@ -386,10 +487,52 @@ int Sqpmethod::init_mem(void* mem) const {
   m->add_stat("BFGS");
   m->add_stat("QP");
   m->add_stat("linesearch");
-  m->mem_qp = qpsol_->checkout();
+  m->mem_qp = newton_cg_ ? -1 : qpsol_->checkout();
+
+  // Newton-CG work vectors, kept across Hessian-vector product evaluations
+  if (newton_cg_) {
+    m->add_stat("CG");
+    m->cg_r.resize(nx_);
+    m->cg_p.resize(nx_);
+    m->cg_hp.resize(nx_);
+    m->cg_free.resize(nx_);
+  }
+
+  // Real-time iteration data, kept between calls
+  m->rti_prepared = false;
+  m->rti_count = 0;
+  m->rti_z.resize(nx_+ng_);
+  m->rti_lam.resize(nx_+ng_);
+  m->rti_p.resize(np_);
+  m->rti_gf.resize(nx_);
+  m->rti_Jk.resize(Asp_.nnz());
+  m->rti_Bk.resize(Hsp_.nnz());
   return 0;
 }
 
+Sqpmethod::RtiPhase Sqpmethod::to_rti_phase(const std::string& s) {
+  if (s=="off") return RTI_OFF;
+  if (s=="preparation") return RTI_PREPARATION;
+  if (s=="feedback") return RTI_FEEDBACK;
+  casadi_error("Unknown rti_phase '" + s + "'. Choose off|preparation|feedback.");
+}
+
+void Sqpmethod::change_option(const std::string& option_name,
+    const GenericType& option_value) {
+  if (option_name == "rti_phase") {
+    RtiPhase phase = to_rti_phase(option_value.to_string());
+    casadi_assert(phase==RTI_OFF || !newton_cg_,
+      "Real-time iterations are not supported with 'newton_cg'.");
+    casadi_assert(phase==RTI_OFF || has_function("nlp_fg") || np_==0,
+      "Real-time iterations with parameters require 'rti_phase' to be set at construction "
+      "or a line-search, such that the zero-order function nlp_fg is available.");
+    rti_phase_ = phase;
+  } else {
+    // Option not found - continue to base classes
+    Nlpsol::change_option(option_name, option_value);
+  }
+}
+
 void Sqpmethod::free_mem(void* mem) const {
   auto m = static_cast<SqpmethodMemory*>(mem);
   if (m->mem_qp >= 0) qpsol_.release(m->mem_qp);
@@ -403,6 +546,12 @@ int Sqpmethod::solve(void* mem) const {
 
   // Number of SQP iterations
   m->iter_count = 0;
+  m->qp_iter.clear();
+  m->cg_iter.clear();
+
+  // Real-time iteration: only one of the two phases is executed per call
+  if (rti_phase_==RTI_PREPARATION) return rti_preparation(m);
+  if (rti_phase_==RTI_FEEDBACK) return rti_feedback(m);
 
   // Number of line-search iterations
   casadi_int ls_iter = 0;
@@ -444,7 +593,17 @@ int Sqpmethod::solve(void* mem) const {
     m->res[1] = d->gf;
     m->res[2] = d_nlp->z + nx_;
     m->res[3] = d->Jk;
-    switch (calc_function(m, "nlp_jac_fg")) {
+    // With multiple threads, evaluate the exact Hessian concurrently
+    bool hess_evaluated = exact_hessian_ && max_num_threads_>1;
+    int flag;
+    if (hess_evaluated) {
+      flag = calc_functions(m, {"nlp_jac_fg", "nlp_hess_l"},
+        {{d_nlp->z, d_nlp->p}, {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_}},
+        {{&d_nlp->objective, d->gf, d_nlp->z + nx_, d->Jk}, {d->Bk}});
+    } else {
+      flag = calc_function(m, "nlp_jac_fg");
+    }
+    switch (flag) {
       case -1:
         m->return_status = "Non_Regular_Sensitivities";
         m->unified_return_status = SOLVER_RET_NAN;
@@ -509,14 +668,18 @@ int Sqpmethod::solve(void* mem) const {
       break;
     }
 
-    if (exact_hessian_) {
+    if (newton_cg_) {
+      // Hessian-vector products are evaluated in the CG iterations
+    } else if (exact_hessian_) {
       // Update/reset exact Hessian
-      m->arg[0] = d_nlp->z;
-      m->arg[1] = d_nlp->p;
-      m->arg[2] = &one;
-      m->arg[3] = d_nlp->lam + nx_;
-      m->res[0] = d->Bk;
-      if (calc_function(m, "nlp_hess_l")) return 1;
+      if (!hess_evaluated) {
+        m->arg[0] = d_nlp->z;
+        m->arg[1] = d_nlp->p;
+        m->arg[2] = &one;
+        m->arg[3] = d_nlp->lam + nx_;
+        m->res[0] = d->Bk;
+        if (calc_function(m, "nlp_hess_l")) return 1;
+      }
       if (convexify_) {
         ScopedTiming tic(m->fstats.at("convexify"));
         if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
@@ -531,7 +694,7 @@ int Sqpmethod::solve(void* mem) const {
       // Update BFGS
       if (m->iter_count % lbfgs_memory_ == 0) casadi_bfgs_reset(Hsp_, d->Bk);
       // Update the Hessian approximation
-      casadi_bfgs(Hsp_, d->Bk, d->dx, d->gLag, d->gLag_old, m->w);
+      update_bfgs(d->Bk, d->dx, d->gLag, d->gLag_old, m->w);
     }
 
     // Formulate the QP
@@ -555,8 +718,20 @@ int Sqpmethod::solve(void* mem) const {
     // Increase counter
     m->iter_count++;
 
-    // Solve the QP
-    int ret = solve_QP(m, d->Bk, d->gf, d->lbdz, d->ubdz, d->Jk, d->dx, d->dlam, 0);
+    // Solve the QP, or the Newton system matrix-free
+    int ret;
+    if (newton_cg_) {
+      ret = newton_cg_step(m);
+      if (ret) {
+        m->return_status = "Newton_CG_Step_Failed";
+        m->unified_return_status = SOLVER_RET_NAN;
+        if (print_status_)
+          print("MESSAGE(sqpmethod): Hessian-vector product evaluation failed.\n");
+        return 1;
+      }
+    } else {
+      ret = solve_QP(m, d->Bk, d->gf, d->lbdz, d->ubdz, d->Jk, d->dx, d->dlam, 0);
+    }
 
     // Elastic mode calculations
     if (elastic_mode_) {
@@ -585,7 +760,7 @@ int Sqpmethod::solve(void* mem) const {
     }
 
     // Detecting indefiniteness
-    double gain = casadi_bilin(d->Bk, Hsp_, d->dx, d->dx);
+    double gain = newton_cg_ ? 0 : casadi_bilin(d->Bk, Hsp_, d->dx, d->dx);
     if (gain < 0) {
       if (print_status_) print("WARNING(sqpmethod): Indefinite Hessian detected\n");
     }
@@ -791,7 +966,7 @@ int Sqpmethod::solve(void* mem) const {
     // Take step
     casadi_axpy(nx_, 1., d->dx, d_nlp->z);
 
-    if (!exact_hessian_) {
+    if (!exact_hessian_ && !newton_cg_) {
       // Evaluate the gradient of the Lagrangian with the old x but new lam (for BFGS)
       casadi_copy(d->gf, nx_, d->gLag_old);
       casadi_mv(d->Jk, Asp_, d_nlp->lam+nx_, d->gLag_old, true);
@@ -808,6 +983,147 @@ int Sqpmethod::solve(void* mem) const {
   return 0;
 }
 
+int Sqpmethod::rti_preparation(SqpmethodMemory* m) const {
+  auto d_nlp = &m->d_nlp;
+  auto d = &m->d;
+  const double one = 1.;
+
+  // Limited-memory Hessian: secant pair between consecutive linearization points
+  bool bfgs_update = !exact_hessian_ && m->rti_prepared;
+  if (bfgs_update) {
+    casadi_copy(d_nlp->z, nx_, d->dx);
+    casadi_axpy(nx_, -1., get_ptr(m->rti_z), d->dx);
+    casadi_copy(get_ptr(m->rti_gf), nx_, d->gLag_old);
+    casadi_mv(get_ptr(m->rti_Jk), Asp_, d_nlp->lam+nx_, d->gLag_old, true);
+    casadi_axpy(nx_, 1., d_nlp->lam, d->gLag_old);
+  }
+
+  // Evaluate f, g and first order derivative information at the initial guess
+  m->arg[0] = d_nlp->z;
+  m->arg[1] = d_nlp->p;
+  m->res[0] = &d_nlp->objective;
+  m->res[1] = d->gf;
+  m->res[2] = d_nlp->z + nx_;
+  m->res[3] = d->Jk;
+  bool hess_evaluated = exact_hessian_ && max_num_threads_>1;
+  int flag;
+  if (hess_evaluated) {
+    flag = calc_functions(m, {"nlp_jac_fg", "nlp_hess_l"},
+      {{d_nlp->z, d_nlp->p}, {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_}},
+      {{&d_nlp->objective, d->gf, d_nlp->z + nx_, d->Jk}, {d->Bk}});
+  } else {
+    flag = calc_function(m, "nlp_jac_fg");
+  }
+  if (flag) {
+    m->return_status = "Non_Regular_Sensitivities";
+    m->unified_return_status = SOLVER_RET_NAN;
+    if (print_status_)
+      print("MESSAGE(sqpmethod): No regularity of sensitivities at current point.\n");
+    return 1;
+  }
+
+  if (exact_hessian_) {
+    if (!hess_evaluated) {
+      m->arg[0] = d_nlp->z;
+      m->arg[1] = d_nlp->p;
+      m->arg[2] = &one;
+      m->arg[3] = d_nlp->lam + nx_;
+      m->res[0] = d->Bk;
+      if (calc_function(m, "nlp_hess_l")) return 1;
+    }
+    if (convexify_) {
+      ScopedTiming tic(m->fstats.at("convexify"));
+      if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
+    }
+  } else if (!bfgs_update) {
+    ScopedTiming tic(m->fstats.at("BFGS"));
+    casadi_fill(d->Bk, Hsp_.nnz(), 1.);
+    casadi_bfgs_reset(Hsp_, d->Bk);
+  } else {
+    ScopedTiming tic(m->fstats.at("BFGS"));
+    casadi_copy(get_ptr(m->rti_Bk), Hsp_.nnz(), d->Bk);
+    if (m->rti_count % lbfgs_memory_ == 0) casadi_bfgs_reset(Hsp_, d->Bk);
+    casadi_copy(d->gf, nx_, d->gLag);
+    casadi_mv(d->Jk, Asp_, d_nlp->lam+nx_, d->gLag, true);
+    casadi_axpy(nx_, 1., d_nlp->lam, d->gLag);
+    update_bfgs(d->Bk, d->dx, d->gLag, d->gLag_old, m->w);
+  }
+
+  // Store the QP data until the feedback call
+  casadi_copy(d_nlp->z, nx_+ng_, get_ptr(m->rti_z));
+  casadi_copy(d_nlp->lam, nx_+ng_, get_ptr(m->rti_lam));
+  casadi_copy(d_nlp->p, np_, get_ptr(m->rti_p));
+  casadi_copy(d->gf, nx_, get_ptr(m->rti_gf));
+  casadi_copy(d->Jk, Asp_.nnz(), get_ptr(m->rti_Jk));
+  casadi_copy(d->Bk, Hsp_.nnz(), get_ptr(m->rti_Bk));
+  m->rti_f = d_nlp->objective;
+  m->rti_prepared = true;
+  m->rti_count++;
+
+  m->return_status = "RTI_Preparation_Done";
+  m->success = true;
+  return 0;
+}
+
+int Sqpmethod::rti_feedback(SqpmethodMemory* m) const {
+  casadi_assert(m->rti_prepared,
+    "Real-time iteration feedback requires a preceding preparation call.");
+  auto d_nlp = &m->d_nlp;
+  auto d = &m->d;
+
+  // Restore the linearization point, the initial guess is ignored
+  casadi_copy(get_ptr(m->rti_z), nx_+ng_, d_nlp->z);
+  d_nlp->objective = m->rti_f;
+
+  // Zero-order update of f and g if the parameters changed since the preparation
+  bool p_changed = false;
+  for (casadi_int i=0; i<np_ && !p_changed; ++i) {
+    p_changed = (d_nlp->p ? d_nlp->p[i] : 0.) != m->rti_p[i];
+  }
+  if (p_changed) {
+    m->arg[0] = d_nlp->z;
+    m->arg[1] = d_nlp->p;
+    m->res[0] = &d_nlp->objective;
+    m->res[1] = d_nlp->z + nx_;
+    if (calc_function(m, "nlp_fg")) return 1;
+  }
+
+  // Formulate the QP with the current bounds
+  casadi_copy(d_nlp->lbz, nx_+ng_, d->lbdz);
+  casadi_axpy(nx_+ng_, -1., d_nlp->z, d->lbdz);
+  casadi_copy(d_nlp->ubz, nx_+ng_, d->ubdz);
+  casadi_axpy(nx_+ng_, -1., d_nlp->z, d->ubdz);
+
+  // Initial guess from the prepared multipliers
+  casadi_copy(get_ptr(m->rti_lam), nx_+ng_, d->dlam);
+  casadi_clear(d->dx, nx_);
+
+  // Solve the QP
+  m->iter_count = 1;
+  solve_QP(m, get_ptr(m->rti_Bk), get_ptr(m->rti_gf), d->lbdz, d->ubdz, get_ptr(m->rti_Jk),
+    d->dx, d->dlam, 0);
+  auto m_qpsol = static_cast<ConicMemory*>(qpsol_->memory(m->mem_qp));
+  if (!m_qpsol->d_qp.success) {
+    if (print_status_) print("WARNING(sqpmethod): QP failed in real-time iteration feedback\n");
+    m->return_status = "RTI_QP_Failed";
+    m->unified_return_status = m_qpsol->d_qp.unified_return_status;
+    return 0;
+  }
+
+  // Objective and constraints predicted by the QP model
+  d_nlp->objective += casadi_dot(nx_, get_ptr(m->rti_gf), d->dx)
+    + 0.5*casadi_bilin(get_ptr(m->rti_Bk), Hsp_, d->dx, d->dx);
+  casadi_mv(get_ptr(m->rti_Jk), Asp_, d->dx, d_nlp->z+nx_, false);
+
+  // Full step
+  casadi_axpy(nx_, 1., d->dx, d_nlp->z);
+  casadi_copy(d->dlam, nx_+ng_, d_nlp->lam);
+
+  m->return_status = "RTI_Feedback_Done";
+  m->success = true;
+  return 0;
+}
+
 void Sqpmethod::print_iteration() const {
   print("%4s %14s %9s %9s %9s %7s %2s %7s\n", "iter", "objective", "inf_pr",
         "inf_du", "||d||", "lg(rg)", "ls", "info");
@@ -869,6 +1185,7 @@ int Sqpmethod::solve_QP(SqpmethodMemory* m, const double* H, const double* g,
   // Solve the QP
   qpsol_(m->arg, m->res, m->iw, m->w, m->mem_qp);
   auto m_qpsol = static_cast<ConicMemory*>(qpsol_->memory(m->mem_qp));
+  m->qp_iter.push_back(m_qpsol->d_qp.iter_count);
 
   // Check if the QP was infeasible for elastic mode
   if (!m_qpsol->d_qp.success) {
@@ -910,6 +1227,7 @@ int Sqpmethod::solve_ela_QP(SqpmethodMemory* m, const double* H, const double* g
   // Solve the QP
   qpsol_ela_(m->arg, m->res, m->iw, m->w, 0);
   auto m_qpsol_ela = static_cast<ConicMemory*>(qpsol_ela_->memory(0));
+  m->qp_iter.push_back(m_qpsol_ela->d_qp.iter_count);
 
   // Check if the QP was infeasible
   if (!m_qpsol_ela->d_qp.success) {
@@ -1015,12 +1333,98 @@ int Sqpmethod::solve_elastic_mode(SqpmethodMemory* m,
   return ret;
 }
 
+void Sqpmethod::update_bfgs(double* Bk, const double* dx, const double* gLag,
+    const double* gLag_old, double* w) const {
+  if (hess_blocks_.empty()) {
+    casadi_bfgs(Hsp_, Bk, dx, gLag, gLag_old, w);
+  } else {
+    casadi_block_bfgs(hess_blocks_.size()-1, get_ptr(hess_blocks_), Bk, dx, gLag, gLag_old, w);
+  }
+}
+
+int Sqpmethod::newton_cg_step(SqpmethodMemory* m) const {
+  ScopedTiming tic(m->fstats.at("CG"));
+  auto d_nlp = &m->d_nlp;
+  auto d = &m->d;
+  const double one = 1.;
+  double* r = get_ptr(m->cg_r);
+  double* p = get_ptr(m->cg_p);
+  double* hp = get_ptr(m->cg_hp);
+  double* free = get_ptr(m->cg_free);
+  const double *z = d_nlp->z, *lbz = d_nlp->lbz, *ubz = d_nlp->ubz;
+
+  // Fix variables at a bound with the gradient pointing outwards
+  for (casadi_int i=0; i<nx_; ++i) {
+    bool fixed = lbz[i]==ubz[i] || (z[i]<=lbz[i] && d->gf[i]>0) || (z[i]>=ubz[i] && d->gf[i]<0);
+    free[i] = fixed ? 0 : 1;
+  }
+
+  // Truncated CG on the free variables, starting from dx = 0
+  casadi_clear(d->dx, nx_);
+  for (casadi_int i=0; i<nx_; ++i) r[i] = -free[i]*d->gf[i];
+  casadi_copy(r, nx_, p);
+  double rr = casadi_dot(nx_, r, r);
+  double r0 = sqrt(rr);
+  double tol = std::fmin(cg_tol_, sqrt(r0)) * r0;
+  casadi_int k;
+  for (k=0; k<cg_max_iter_ && sqrt(rr)>tol; ++k) {
+    // Hessian-vector product
+    m->arg[0] = z;
+    m->arg[1] = d_nlp->p;
+    m->arg[2] = &one;
+    m->arg[3] = d_nlp->lam + nx_;
+    m->arg[4] = p;
+    m->res[0] = hp;
+    if (calc_function(m, "nlp_hess_vec")) return 1;
+    for (casadi_int i=0; i<nx_; ++i) hp[i] *= free[i];
+    double php = casadi_dot(nx_, p, hp);
+    // Nonpositive curvature: keep the current iterate, steepest descent if none
+    if (php <= 1e-12*casadi_dot(nx_, p, p)) {
+      if (k==0) casadi_copy(p, nx_, d->dx);
+      break;
+    }
+    double alpha = rr/php;
+    casadi_axpy(nx_, alpha, p, d->dx);
+    casadi_axpy(nx_, -alpha, hp, r);
+    double rr_new = casadi_dot(nx_, r, r);
+    casadi_scal(nx_, rr_new/rr, p);
+    casadi_axpy(nx_, 1., r, p);
+    rr = rr_new;
+  }
+  m->cg_iter.push_back(k);
+
+  // Project the step onto the bounds, multipliers of the fixed variables
+  for (casadi_int i=0; i<nx_; ++i) {
+    d->dx[i] = std::fmin(std::fmax(z[i] + d->dx[i], lbz[i]), ubz[i]) - z[i];
+    d->dlam[i] = free[i] ? 0 : -d->gf[i];
+  }
+  return 0;
+}
+
+std::vector<casadi_int> Sqpmethod::diagonal_blocks(const Sparsity& sp_in) {
+  // Couplings are read column-wise, so make sure both triangles are present
+  Sparsity sp = sp_in + sp_in.T();
+  const casadi_int* colind = sp.colind();
+  const casadi_int* row = sp.row();
+  std::vector<casadi_int> offset = {0};
+  // Largest row or column index coupled to the current block
+  casadi_int last = -1;
+  for (casadi_int c=0; c<sp.size2(); ++c) {
+    last = std::max(last, c);
+    for (casadi_int k=colind[c]; k<colind[c+1]; ++k) last = std::max(last, row[k]);
+    // Block ends when no entry couples to later columns
+    if (last==c) offset.push_back(c+1);
+  }
+  return offset;
+}
+
 double Sqpmethod::calc_gamma_1(SqpmethodMemory* m) const {
   auto d = &m->d;
   return std::max(gamma_0_*casadi_norm_inf(nx_, d->gf), gamma_1_min_);
 }
 
 void Sqpmethod::codegen_declarations(CodeGenerator& g) const {
+  casadi_assert(!newton_cg_, "Code generation is not supported with 'newton_cg'.");
   Nlpsol::codegen_declarations(g);
 
   if (max_iter_ls_ || so_corr_) g.add_dependency(get_function("nlp_fg"));
@@ -1034,6 +1438,8 @@ void Sqpmethod::codegen_declarations(CodeGenerator& g) const {
 }
 
 void Sqpmethod::codegen_body(CodeGenerator& g) const {
+  casadi_assert(rti_phase_==RTI_OFF,
+    "Code generation of sqpmethod is not supported for real-time iterations.");
   g.add_auxiliary(CodeGenerator::AUX_SQPMETHOD);
   codegen_body_enter(g);
   // From nlpsol
@@ -1136,7 +1542,12 @@ void Sqpmethod::codegen_body(CodeGenerator& g) const {
     g << "if (iter_count % " << lbfgs_memory_ << "==0) ";
     g << "casadi_bfgs_reset(p.sp_h, d->Bk);\n";
     g.comment("Update the Hessian approximation");
-    g << "casadi_bfgs(p.sp_h, d->Bk, d->dx, d->gLag, d->gLag_old, d->w);\n";
+    if (hess_blocks_.empty()) {
+      g << "casadi_bfgs(p.sp_h, d->Bk, d->dx, d->gLag, d->gLag_old, d->w);\n";
+    } else {
+      g << "casadi_block_bfgs(" << hess_blocks_.size()-1 << ", " << g.constant(hess_blocks_)
+        << ", d->Bk, d->dx, d->gLag, d->gLag_old, d->w);\n";
+    }
     g << "}\n";
   }
 
@@ -1532,11 +1943,14 @@ Dict Sqpmethod::get_stats(void* mem) const {
   auto m = static_cast<SqpmethodMemory*>(mem);
   stats["return_status"] = m->return_status;
   stats["iter_count"] = m->iter_count;
+  stats["qp_iter"] = m->qp_iter;
+  if (newton_cg_) stats["cg_iter"] = m->cg_iter;
+  stats["rti_count"] = m->rti_count;
   return stats;
 }
 
 Sqpmethod::Sqpmethod(DeserializingStream& s) : Nlpsol(s) {
-  int version = s.version("Sqpmethod", 1, 3);
+  int version = s.version("Sqpmethod", 1, 6);
   s.unpack("Sqpmethod::qpsol", qpsol_);
   if (version>=3) {
     s.unpack("Sqpmethod::qpsol_ela", qpsol_ela_);
@@ -1605,12 +2019,31 @@ Sqpmethod::Sqpmethod(DeserializingStream& s) : Nlpsol(s) {
     s.unpack("Sqpmethod::convexify", convexify_);
     if (convexify_) Convexify::deserialize(s, "Sqpmethod::", convexify_data_);
   }
+  if (version>=4) {
+    casadi_int rti_phase;
+    s.unpack("Sqpmethod::rti_phase", rti_phase);
+    rti_phase_ = static_cast<RtiPhase>(rti_phase);
+  } else {
+    rti_phase_ = RTI_OFF;
+  }
+  if (version>=5) {
+    s.unpack("Sqpmethod::hess_blocks", hess_blocks_);
+  }
+  if (version>=6) {
+    s.unpack("Sqpmethod::newton_cg", newton_cg_);
+    s.unpack("Sqpmethod::cg_max_iter", cg_max_iter_);
+    s.unpack("Sqpmethod::cg_tol", cg_tol_);
+  } else {
+    newton_cg_ = false;
+    cg_max_iter_ = 0;
+    cg_tol_ = 0;
+  }
   set_sqpmethod_prob();
 }
 
 void Sqpmethod::serialize_body(SerializingStream &s) const {
   Nlpsol::serialize_body(s);
-  s.version("Sqpmethod", 3);
+  s.version("Sqpmethod", 6);
   s.pack("Sqpmethod::qpsol", qpsol_);
   s.pack("Sqpmethod::qpsol_ela", qpsol_ela_);
   s.pack("Sqpmethod::exact_hessian", exact_hessian_);
@@ -1641,6 +2074,11 @@ void Sqpmethod::serialize_body(SerializingStream &s) const {
   s.pack("Sqpmethod::Asp", Asp_);
   s.pack("Sqpmethod::convexify", convexify_);
   if (convexify_) Convexify::serialize(s, "Sqpmethod::", convexify_data_);
+  s.pack("Sqpmethod::rti_phase", static_cast<casadi_int>(rti_phase_));
+  s.pack("Sqpmethod::hess_blocks", hess_blocks_);
+  s.pack("Sqpmethod::newton_cg", newton_cg_);
+  s.pack("Sqpmethod::cg_max_iter", cg_max_iter_);
+  s.pack("Sqpmethod::cg_tol", cg_tol_);
 }
 
 } // namespace casadi
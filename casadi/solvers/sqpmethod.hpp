@@ -59,6 +59,21 @@ namespace casadi {
 
     /// Iteration count
     int iter_count;
+
+    /// Number of iterations of each QP solve (-1 if not reported by the QP solver)
+    std::vector<casadi_int> qp_iter;
+
+    /// Newton-CG: number of CG iterations of each step, work vectors
+    std::vector<casadi_int> cg_iter;
+    std::vector<double> cg_r, cg_p, cg_hp, cg_free;
+
+    /// Real-time iteration: QP data prepared at the linearization point
+    ///@{
+    bool rti_prepared;
+    casadi_int rti_count;
+    double rti_f;
+    std::vector<double> rti_z, rti_lam, rti_p, rti_gf, rti_Jk, rti_Bk;
+    ///@}
   };
 
   /** \brief  \pluginbrief{Nlpsol,sqpmethod}
@@ -90,6 +105,9 @@ namespace casadi {
     /// Get all statistics
     Dict get_stats(void* mem) const override;
 
+    /** \brief Change option after object creation, e.g. the real-time iteration phase */
+    void change_option(const std::string& option_name, const GenericType& option_value) override;
+
     // Initialize the solver
     void init(const Dict& opts) override;
 
@@ -130,6 +148,16 @@ namespace casadi {
     /// Memory size of L-BFGS method
     casadi_int lbfgs_memory_;
 
+    /// Offsets of the diagonal blocks of the limited-memory Hessian (empty if not blocked)
+    std::vector<casadi_int> hess_blocks_;
+
+    /// Truncated Newton-CG steps with Hessian-vector products instead of QPs
+    bool newton_cg_;
+
+    /// Maximum number of CG iterations, maximum relative CG residual
+    casadi_int cg_max_iter_;
+    double cg_tol_;
+
     /// Tolerance of primal and dual infeasibility
     double tol_pr_, tol_du_;
 
@@ -171,6 +199,19 @@ namespace casadi {
     // Second order corrections
     bool so_corr_;
 
+    /// Real-time iteration phase
+    enum RtiPhase {RTI_OFF, RTI_PREPARATION, RTI_FEEDBACK};
+    RtiPhase rti_phase_;
+
+    /// Parse the real-time iteration phase
+    static RtiPhase to_rti_phase(const std::string& s);
+
+    /// Real-time iteration: linearize at the initial guess and store the QP data
+    int rti_preparation(SqpmethodMemory* m) const;
+
+    /// Real-time iteration: solve the prepared QP and take a full step
+    int rti_feedback(SqpmethodMemory* m) const;
+
     /** \brief Generate code for the function body */
     void codegen_body(CodeGenerator& g) const override;
 
@@ -228,6 +269,16 @@ namespace casadi {
     // Calculate gamma_1
     double calc_gamma_1(SqpmethodMemory* m) const;
 
+    // Update the limited-memory Hessian approximation, blockwise if requested
+    void update_bfgs(double* Bk, const double* dx, const double* gLag,
+      const double* gLag_old, double* w) const;
+
+    // Truncated Newton-CG step with Hessian-vector products, bounds by projection
+    int newton_cg_step(SqpmethodMemory* m) const;
+
+    // Contiguous diagonal blocks of a sparsity pattern, symmetrized first
+    static std::vector<casadi_int> diagonal_blocks(const Sparsity& sp);
+
     /// A documentation string
     static const std::string meta_doc;
 
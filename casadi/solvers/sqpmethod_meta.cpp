@@ -43,9 +43,30 @@
 "| beta                     | OT_DOUBLE   | Line-search parameter,          |\n"
 "|                          |             | restoration factor of stepsize  |\n"
 "+--------------------------+-------------+---------------------------------+\n"
+"| block_hessian            | OT_BOOL     | Limited-memory mode: Use a      |\n"
+"|                          |             | block-diagonal Hessian          |\n"
+"|                          |             | approximation with the diagonal |\n"
+"|                          |             | blocks of the sparsity pattern  |\n"
+"|                          |             | of the exact Hessian and        |\n"
+"|                          |             | separate BFGS updates for each  |\n"
+"|                          |             | block. Storage and update cost  |\n"
+"|                          |             | are linear in the number of     |\n"
+"|                          |             | variables for bounded block     |\n"
+"|                          |             | sizes [false].                  |\n"
+"+--------------------------+-------------+---------------------------------+\n"
 "| c1                       | OT_DOUBLE   | Armijo condition, coefficient   |\n"
 "|                          |             | of decrease in merit            |\n"
 "+--------------------------+-------------+---------------------------------+\n"
+"| cg_max_iter              | OT_INT      | Newton-CG: Maximum number of CG |\n"
+"|                          |             | iterations per step [100].      |\n"
+"+--------------------------+-------------+---------------------------------+\n"
+"| cg_tol                   | OT_DOUBLE   | Newton-CG: Maximum relative     |\n"
+"|                          |             | residual of the truncated CG    |\n"
+"|                          |             | solve. The forcing term         |\n"
+"|                          |             | min(cg_tol, sqrt(|g|)) gives    |\n"
+"|                          |             | superlinear local convergence   |\n"
+"|                          |             | [0.1].                          |\n"
+"+--------------------------+-------------+---------------------------------+\n"
 "| convexify_margin         | OT_DOUBLE   | When using a convexification    |\n"
 "|                          |             | strategy, make sure that the    |\n"
 "|                          |             | smallest eigenvalue is at least |\n"
@@ -99,6 +120,12 @@
 "| max_iter_ls              | OT_INT      | Maximum number of linesearch    |\n"
 "|                          |             | iterations                      |\n"
 "+--------------------------+-------------+---------------------------------+\n"
+"| max_num_threads          | OT_INT      | Evaluate the constraint         |\n"
+"|                          |             | Jacobian and the exact Hessian  |\n"
+"|                          |             | of the Lagrangian concurrently  |\n"
+"|                          |             | using up to this many threads   |\n"
+"|                          |             | [1]                             |\n"
+"+--------------------------+-------------+---------------------------------+\n"
 "| merit_memory             | OT_INT      | Size of memory to store history |\n"
 "|                          |             | of merit function values        |\n"
 "+--------------------------+-------------+---------------------------------+\n"
@@ -109,6 +136,19 @@
 "|                          |             | size should not become smaller  |\n"
 "|                          |             | than this.                      |\n"
 "+--------------------------+-------------+---------------------------------+\n"
+"| newton_cg                | OT_BOOL     | Compute the step with a         |\n"
+"|                          |             | truncated Newton-CG method      |\n"
+"|                          |             | using the Hessian-vector        |\n"
+"|                          |             | products of 'nlp_hess_vec'      |\n"
+"|                          |             | instead of forming the Hessian  |\n"
+"|                          |             | and solving a QP. Matrix-free,  |\n"
+"|                          |             | for problems without general    |\n"
+"|                          |             | constraints; variables at a     |\n"
+"|                          |             | bound with the gradient         |\n"
+"|                          |             | pointing outwards are fixed and |\n"
+"|                          |             | the step is projected onto the  |\n"
+"|                          |             | bounds [false].                 |\n"
+"+--------------------------+-------------+---------------------------------+\n"
 "| print_header             | OT_BOOL     | Print the header with problem   |\n"
 "|                          |             | statistics                      |\n"
 "+--------------------------+-------------+---------------------------------+\n"
@@ -123,6 +163,16 @@
 "| qpsol_options            | OT_DICT     | Options to be passed to the QP  |\n"
 "|                          |             | solver                          |\n"
 "+--------------------------+-------------+---------------------------------+\n"
+"| rti_phase                | OT_STRING   | off|preparation|feedback.       |\n"
+"|                          |             | Real-time iteration phase       |\n"
+"|                          |             | (default: off). A preparation   |\n"
+"|                          |             | call linearizes at x0 and       |\n"
+"|                          |             | stores the QP, a feedback call  |\n"
+"|                          |             | solves the stored QP with the   |\n"
+"|                          |             | current bounds and takes a full |\n"
+"|                          |             | step. Can be switched between   |\n"
+"|                          |             | calls with change_option.       |\n"
+"+--------------------------+-------------+---------------------------------+\n"
 "| second_order_corrections | OT_BOOL     | Enable second order             |\n"
 "|                          |             | corrections. These are used     |\n"
 "|                          |             | when a step is considered bad   |\n"
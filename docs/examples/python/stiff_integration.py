@@ -0,0 +1,49 @@
+#
+#     MIT No Attribution
+#
+#     Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl, KU Leuven.
+#
+#     Permission is hereby granted, free of charge, to any person obtaining a copy of this
+#     software and associated documentation files (the "Software"), to deal in the Software
+#     without restriction, including without limitation the rights to use, copy, modify,
+#     merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+#     permit persons to whom the Software is furnished to do so.
+#
+#     THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+#     INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+#     PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+#     HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+#     OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+#     SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+from casadi import *
+import time
+
+# Comparison of fixed-step integrators on a stiff semi-linear ODE:
+# a stiff linear part plus a nonlinear, non-stiff part
+t = MX.sym("t")
+x = MX.sym("x", 2)
+p = MX.sym("p")
+dae = {'t':t, 'x':x, 'p':p, 'ode':vertcat(-1000*(x[0]-cos(t)) + x[1]**2, -p*x[1])}
+x0 = DM([0, 1])
+
+# Reference solution
+ref = integrator("ref", "collocation", dae, 0, 1, {"number_of_finite_elements": 2000})
+xf_ref = ref(x0=x0, p=0.5)["xf"]
+
+# Candidates: collocation needs a Newton iteration per step,
+# the Rosenbrock schemes solve one linear system per stage
+candidates = [("collocation", {}),
+              ("rosenbrock", {"rosenbrock_scheme": "ros2"}),
+              ("rosenbrock", {"rosenbrock_scheme": "euler"})]
+
+for plugin, opts in candidates:
+  for nk in [20, 100, 500]:
+    F = integrator("F", plugin, dae, 0, 1, dict(opts, number_of_finite_elements=nk))
+    tic = time.time()
+    for i in range(20):
+      xf = F(x0=x0, p=0.5)["xf"]
+    t_eval = (time.time() - tic) / 20
+    err = float(norm_inf(xf - xf_ref))
+    print("%-12s %-6s nk = %4d: error %.2e, %.2e s per call" %
+      (plugin, opts.get("rosenbrock_scheme", ""), nk, err, t_eval))
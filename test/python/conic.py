@@ -954,8 +954,26 @@ class ConicTests(casadiTestCase):
         F,_ = self.check_codegen(solver,{},std="c99",opts={"verbose_runtime":True})
         #with self.assertOutput(["last_tau","Converged"],[]): # Printing, but not captured by python stdout
         #    F()
-    
-    
+
+  def test_qrqp_reuse_factorization(self):
+    x = SX.sym("x",3)
+    qp = {"x":x,"f":dot(x,x)+x[0]*x[1]-x[2],"g":vertcat(x[0]+x[1],x[1]-x[2])}
+    opts = {"print_iter":False,"print_header":False}
+    ref = qpsol("ref","qrqp",qp,dict(opts,reuse_factorization=False))
+    solver = qpsol("solver","qrqp",qp,opts)
+    args = {"lbg":[1,-inf],"ubg":[inf,0]}
+    sol_ref = ref(**args)
+    sol = solver(**args)
+    self.checkarray(sol["x"],sol_ref["x"],digits=12)
+    self.assertTrue(solver.stats()["iter_count"]>=0)
+
+    # Warm-started repeat solve: active set and KKT matrix are unchanged
+    sol = solver(x0=sol["x"],lam_x0=sol["lam_x"],lam_g0=sol["lam_g"],**args)
+    self.checkarray(sol["x"],sol_ref["x"],digits=12)
+    self.assertTrue(solver.stats()["n_fact_reused"]>=1)
+    self.assertEqual(ref.stats()["n_fact_reused"],0)
+
+
 
   @requires_conic("hpipm")
   @requires_conic("qpoases")
@@ -1216,6 +1234,163 @@ class ConicTests(casadiTestCase):
     print("codegen starts here")   
     self.check_codegen(solver,dict(a=A,h=H,lba=lbg,uba=ubg,g=g,lbx=lbx,ubx=ubx,x0=sol["x"],lam_a0=sol["lam_a"],lam_x0=sol["lam_x"]),std="c99",extralibs=["hpipm","blasfeo"],extra_options=fatrop_flags)
         
+  @requires_conic("riccati")
+  @requires_conic("qrqp")
+  def test_riccati(self):
+    inf = 100
+    N = 4
+
+    x = MX.sym('x', 2)
+    u = MX.sym('u')
+    xdot = vertcat(0.6*x[0] - 1.11*x[1] + 0.3*u-0.03, 0.7*x[0]+0.01)
+    L = x[0]**2 + 3*x[1]**2 + 7*u**2 -0.4*x[0]*x[1]-0.3*x[0]*u+u -x[0]-2*x[1]
+    F = Function('F', [x, u], [x+xdot, L])
+
+    Xs = SX.sym('X', 2, 1, N+1)
+    Us = SX.sym('U', 1, 1, N)
+    w = []
+    lbw = []
+    ubw = []
+    J = 0
+    g = []
+    lbg = []
+    ubg = []
+    for k in range(N):
+      w += [Xs[k], Us[k]]
+      if k==0:
+        lbw += [-inf, 1, -inf]
+        ubw += [inf, 1, inf]
+      elif k==2:
+        # Eliminated state, decouples the dynamics
+        lbw += [0, -inf, -1]
+        ubw += [0, inf, 1]
+      else:
+        lbw += [-inf, -inf, -inf]
+        ubw += [inf, inf, inf]
+      xplus, l = F(Xs[k], Us[k])
+      J += l
+      g += [3*(xplus-Xs[k+1])]
+      lbg += [0, 0]
+      ubg += [0, 0]
+      g += [0.1*Xs[k][1]-0.05*Us[k]]
+      lbg += [-0.5*k-0.1]
+      ubg += [2]
+    w += [Xs[-1]]
+    lbw += [-inf, -inf]
+    ubw += [inf, inf]
+    g += [0.1*Xs[-1][1]]
+    lbg += [0.1]
+    ubg += [2]
+    J += mtimes(Xs[-1].T, Xs[-1])
+    prob = {'f': J, 'x': vertcat(*w), 'g': vertcat(*g)}
+    args = dict(lbx=lbw, ubx=ubw, lbg=lbg, ubg=ubg)
+
+    solver_ref = qpsol('solver', 'qrqp', prob, {"print_iter": False, "print_header": False})
+    sol_ref = solver_ref(**args)
+
+    # Automatic and manual structure detection
+    for opts in [{}, {"structure_detection": "manual", "N": N, "nx": [2]*(N+1),
+                      "nu": [1]*N, "ng": [1]*(N+1)}]:
+      opts = dict(opts, print_iter=False, print_header=False)
+      solver = qpsol('solver', 'riccati', prob, opts)
+      sol = solver(**args)
+      self.assertTrue(solver.stats()["success"])
+      self.checkarray(sol_ref["x"], sol["x"], digits=7)
+      self.checkarray(sol_ref["lam_g"], sol["lam_g"], digits=6)
+      self.checkarray(sol_ref["lam_x"], sol["lam_x"], digits=6)
+      self.checkarray(sol_ref["f"], sol["f"], digits=7)
+      self.check_serialize(solver, args)
+      self.check_codegen(solver, args, std="c99")
+
+    # Inside an SQP method
+    solver = nlpsol('solver', 'sqpmethod', prob, {"qpsol": "riccati", "print_iteration": False,
+      "print_header": False, "qpsol_options": {"print_iter": False, "print_header": False}})
+    sol = solver(**args)
+    self.checkarray(sol_ref["x"], sol["x"], digits=7)
+    self.checkarray(sol_ref["f"], sol["f"], digits=7)
+
+    # Coupling between stages that is not part of the dynamics
+    prob2 = dict(prob, f=J + Xs[0][0]*Xs[2][1])
+    with self.assertInException("H is not block diagonal"):
+      qpsol('solver', 'riccati', prob2)
+
+  def test_condensing(self):
+    inf = 100
+    N = 4
+
+    x = MX.sym('x', 2)
+    u = MX.sym('u')
+    xdot = vertcat(0.6*x[0] - 1.11*x[1] + 0.3*u-0.03, 0.7*x[0]+0.01)
+    L = x[0]**2 + 3*x[1]**2 + 7*u**2 -0.4*x[0]*x[1]-0.3*x[0]*u+u -x[0]-2*x[1]
+    F = Function('F', [x, u], [x+xdot, L])
+
+    Xs = SX.sym('X', 2, 1, N+1)
+    Us = SX.sym('U', 1, 1, N)
+    w = []
+    lbw = []
+    ubw = []
+    J = 0
+    g = []
+    lbg = []
+    ubg = []
+    for k in range(N):
+      w += [Xs[k], Us[k]]
+      if k==0:
+        lbw += [-inf, 1, -inf]
+        ubw += [inf, 1, inf]
+      elif k==2:
+        # Bounded state, becomes a constraint when eliminated
+        lbw += [0, -inf, -1]
+        ubw += [0, inf, 1]
+      else:
+        lbw += [-inf, -inf, -inf]
+        ubw += [inf, inf, inf]
+      xplus, l = F(Xs[k], Us[k])
+      J += l
+      g += [3*(xplus-Xs[k+1])]
+      lbg += [0, 0]
+      ubg += [0, 0]
+      g += [0.1*Xs[k][1]-0.05*Us[k]]
+      lbg += [-0.5*k-0.1]
+      ubg += [2]
+    w += [Xs[-1]]
+    lbw += [-inf, -inf]
+    ubw += [inf, inf]
+    g += [0.1*Xs[-1][1]]
+    lbg += [0.1]
+    ubg += [2]
+    J += mtimes(Xs[-1].T, Xs[-1])
+    prob = {'f': J, 'x': vertcat(*w), 'g': vertcat(*g)}
+    args = dict(lbx=lbw, ubx=ubw, lbg=lbg, ubg=ubg)
+
+    qp_opts = {"print_iter": False, "print_header": False, "print_info": False}
+    solver_ref = qpsol('solver', 'qrqp', prob, qp_opts)
+    sol_ref = solver_ref(**args)
+
+    # Full and partial condensing
+    for block_size in [0, 1, 2]:
+      solver = qpsol('solver', 'condensing', prob,
+        {"conic": "qrqp", "conic_options": qp_opts, "block_size": block_size})
+      sol = solver(**args)
+      self.assertTrue(solver.stats()["success"])
+      self.checkarray(sol_ref["x"], sol["x"], digits=7)
+      self.checkarray(sol_ref["lam_g"], sol["lam_g"], digits=6)
+      self.checkarray(sol_ref["lam_x"], sol["lam_x"], digits=6)
+      self.checkarray(sol_ref["f"], sol["f"], digits=7)
+      self.check_serialize(solver, args)
+
+    # Bounds of eliminated states must be imposed
+    solver = qpsol('solver', 'condensing', prob,
+      {"conic": "qrqp", "conic_options": qp_opts, "state_bounds": False})
+    with self.assertInException("must be unbounded"):
+      solver(**args)
+
+    # Coupling between blocks
+    prob2 = dict(prob, f=J + Xs[0][0]*Xs[2][1])
+    qpsol('solver', 'condensing', prob2, {"conic": "qrqp"})
+    with self.assertInException("H couples the condensing blocks"):
+      qpsol('solver', 'condensing', prob2, {"conic": "qrqp", "block_size": 1})
+
   @requires_nlpsol("ipopt")
   def test_SOCP(self):
 
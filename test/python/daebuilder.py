@@ -54,6 +54,128 @@ class Daebuildertests(casadiTestCase):
         if not name.endswith("3"):
             self.check_serialize(f,inputs=test_point)
   
+  def test_fmu_cache(self):
+    if "ghc-filesystem" not in CasadiMeta.feature_list(): return
+    import tempfile
+    for name in ["VanDerPol2","VanDerPol3"]:
+        fmu_file = "../data/" + name + ".fmu"
+        if not os.path.exists(fmu_file):
+            print("Skipping test_fmu_cache, resource not available")
+            return
+        def variables(dae):
+            return [(n, dae.causality(n), dae.variability(n), dae.category(n), dae.type(n),
+                     dae.description(n), dae.start(n)) for n in dae.all()]
+        ref = DaeBuilder("car",fmu_file)
+        with tempfile.TemporaryDirectory() as cache_dir:
+            # First load writes the cache, second load reads it
+            for k in range(2):
+                dae = DaeBuilder("car",fmu_file,{"cache_dir": cache_dir})
+                self.assertEqual(len(os.listdir(cache_dir)), 1)
+                self.assertEqual(variables(dae), variables(ref))
+                for cat in ["x", "z", "u", "p", "c", "d", "w", "q"]:
+                    self.assertEqual(dae.all(cat), ref.all(cat))
+                self.assertEqual(dae.y(), ref.y())
+                self.assertEqual(dae.derivatives(), ref.derivatives())
+
+  def test_fmu_adjoint(self):
+    if "ghc-filesystem" not in CasadiMeta.feature_list(): return
+    fmu_file = "../data/VanDerPol3.fmu"
+    if not os.path.exists(fmu_file):
+        print("Skipping test_fmu_adjoint, resource not available")
+        return
+    dae = DaeBuilder("car",fmu_file)
+    x = DM([1.1,1.3])
+    a = DM([0.7,-1.5])
+    res = {}
+    for adj in [False,True]:
+        f = dae.create('f',['x','adj_ode'],['ode','jac_ode_x','adj_x','jac_adj_x_x'],
+                       {"uses_adjoint_derivatives":adj})
+        r = f(x=x,adj_ode=a)
+        # Central finite differences of the outputs and of the adjoint sensitivities
+        h = 1e-6
+        J_fd = DM.zeros(2,2)
+        H_fd = DM.zeros(2,2)
+        for i in range(2):
+            e = DM.zeros(2)
+            e[i] = h
+            rp = f(x=x+e,adj_ode=a)
+            rm = f(x=x-e,adj_ode=a)
+            J_fd[:,i] = (rp["ode"]-rm["ode"])/(2*h)
+            H_fd[:,i] = (rp["adj_x"]-rm["adj_x"])/(2*h)
+        self.checkarray(r["jac_ode_x"],J_fd,digits=7)
+        self.checkarray(r["jac_adj_x_x"],H_fd,digits=5)
+        res[adj] = r
+    self.checkarray(res[True]["jac_ode_x"],res[False]["jac_ode_x"],digits=10)
+    self.checkarray(res[True]["adj_x"],res[False]["adj_x"],digits=10)
+    self.checkarray(res[True]["jac_adj_x_x"],res[False]["jac_adj_x_x"],digits=5)
+
+  def test_fmu_pool(self):
+    if "ghc-filesystem" not in CasadiMeta.feature_list(): return
+    for name in ["VanDerPol2","VanDerPol3"]:
+        fmu_file = "../data/" + name + ".fmu"
+        if not os.path.exists(fmu_file):
+            print("Skipping test_fmu_pool, resource not available")
+            return
+        f = DaeBuilder("car",fmu_file).create('f',['x'],['ode'])
+        # Two memory blocks checked out at the same time, instances pooled in between
+        F = f.map(2,"thread",2)
+        X = DM([[1.1,-0.3],[1.3,0.7]])
+        for k in range(3):
+            ref = DaeBuilder("car",fmu_file).create('f',['x'],['ode'])
+            self.checkarray(F(X),horzcat(ref(X[:,0]),ref(X[:,1])),digits=12)
+            X = 1.5*X
+
+  def test_fmu_export(self):
+    import platform
+    import shutil
+    fmi3_headers = os.path.join("..","..","external_packages","FMI-Standard-3.0","headers")
+    if platform.system()!="Linux" or platform.machine()!="x86_64" or shutil.which("gcc") is None or not os.path.isdir(fmi3_headers):
+        print("Skipping test_fmu_export, no compiler or FMI headers available")
+        return
+    # Third state enters all equations linearly
+    dae = DaeBuilder("lin3")
+    x1 = dae.add("x1", "output", {"start": 1})
+    x2 = dae.add("x2", "output", {"start": 0})
+    x3 = dae.add("x3", "output", {"start": 0})
+    u = dae.add("u", "input")
+    a = dae.add("a", "parameter", "tunable")
+    dae.eq(dae.der(x1), (1 - x2**2)*x1 - x2 + a*u)
+    dae.eq(dae.der(x2), x1)
+    dae.eq(dae.der(x3), x1 - 2*x3 + u)
+    dae.set_start("a", 2)
+    files = dae.export_fmu({"no_warning": True})
+    # Compile and lay out as an unzipped FMU
+    unzipped_path = os.path.join(os.getcwd(), "lin3")
+    if os.path.isdir(unzipped_path): shutil.rmtree(unzipped_path)
+    bin_path = os.path.join(unzipped_path, "binaries", "x86_64-linux")
+    os.makedirs(bin_path)
+    p = subprocess.run(["gcc","--shared","-fPIC","-I"+fmi3_headers,"lin3.c","lin3_wrap.c","-o",os.path.join(bin_path,"lin3.so")])
+    self.assertEqual(p.returncode, 0)
+    shutil.copy("modelDescription.xml", unzipped_path)
+    for f in files: os.remove(f)
+    # Symbolic reference
+    ode = dae.create('ode',['x','u','p'],['ode'])
+    X = MX.sym("x",3)
+    U = MX.sym("u")
+    P = MX.sym("p")
+    L = MX.sym("l",3)
+    o = ode(X,U,P)
+    ref = Function('ref',[X,U,P,L],[o,jacobian(o,X),jacobian(o,U),jacobian(o,P),hessian(dot(L,o),X)[0]])
+    arg = [DM([0.3,0.7,0.1]),0.4,2.,DM([1.,0.5,2.])]
+    r_ref = ref(*arg)
+    # Compare with the exported FMU, with and without adjoint derivatives
+    fmu = DaeBuilder("lin3", unzipped_path)
+    for adj in [False,True]:
+        f = fmu.create('f',['x','u','p','adj_ode'],['ode','jac_ode_x','jac_ode_u','jac_ode_p','jac_adj_x_x'],
+                       {"uses_adjoint_derivatives":adj})
+        r = f(*arg)
+        for i in range(4):
+            self.checkarray(r[i],r_ref[i],digits=10)
+        self.checkarray(r[4],r_ref[4],digits=5)
+        # Linear dependencies are exported as constant and dropped from the Hessian
+        self.check_sparsity(f.sparsity_out('jac_adj_x_x'),vertcat(horzcat(Sparsity.dense(2,2),Sparsity(2,1)),Sparsity(1,3)))
+    shutil.rmtree(unzipped_path)
+
   @memory_heavy()
   def test_cstr(self):
     fmu_file = "../data/cstr.fmu"
@@ -100,6 +222,20 @@ class Daebuildertests(casadiTestCase):
     if os.path.exists(rumoca) or os.path.exists(rumoca_exe):
         p = subprocess.run([rumoca,"-t","../assets/casadi_daebuilder.jinja","-m", "../assets/hello_world.mo"]) 
 
+  def test_sort_dependent(self):
+    # Definitions in evaluation order are kept, reverse order is sorted
+    for names in [["w1", "w2", "w3"], ["w3", "w2", "w1"]]:
+        dae = DaeBuilder("m")
+        x = dae.add("x", "input")
+        w = dict((n, dae.add(n, "local", "continuous", {})) for n in names)
+        defs = {"w1": 2*x, "w2": w["w1"] + 1, "w3": w["w2"]*w["w1"]}
+        for n in names: dae.eq(w[n], defs[n])
+        self.assertEqual(dae.w(), names)
+        dae.sort("w")
+        self.assertEqual(dae.w(), ["w1", "w2", "w3"])
+        f = dae.dependent_fun("f", ["u"], ["w"])
+        self.checkarray(f(3), DM([6, 7, 42]))
+
   def test_fmu_zip(self):
     fmu_file = "../data/VanDerPol2.fmu"
     if not os.path.exists(fmu_file):
@@ -557,6 +693,106 @@ class Daebuildertests(casadiTestCase):
         sol = solver(x0 = w0, lbx = lbw, ubx = ubw, lbg = 0, ubg = 0)
 
 
+  def test_reorder_insert(self):
+    for reorder in [False, True]:
+        dae = DaeBuilder("m")
+        dae.add("p1", "parameter", "tunable")
+        dae.add("c2", "parameter", "fixed")
+        dae.add("p3", "parameter", "tunable")
+        dae.add("p4", "parameter", "tunable")
+        if reorder: dae.reorder("p", ["p4", "p1", "p3"])
+        # Inserted before the first variable with a larger index
+        dae.set_category("c2", "p")
+        self.assertEqual(dae.p(), ["c2", "p4", "p1", "p3"] if reorder else ["p1", "c2", "p3", "p4"])
+        dae.set_category("p1", "c")
+        dae.set_category("p1", "p")
+        self.assertEqual(dae.p(), ["p1", "c2", "p4", "p3"] if reorder else ["p1", "c2", "p3", "p4"])
+
+  def test_causalize(self):
+    for solver in ["newton", ""]:
+        dae = DaeBuilder("m")
+        x = dae.add("x")
+        u = dae.add("u", "input")
+        p = dae.add("p", "parameter", "tunable", {"start": 2})
+        z = [dae.add("z%d" % i) for i in range(1, 8)]
+        dae.eq(dae.der(x), -x + z[3] + z[5] + z[6])
+        dae.eq(0, z[2]**3 + z[2] - z[1])
+        dae.eq(0, z[1] + z[0] - sin(x))
+        dae.eq(0, z[0] - 2*x - u)
+        dae.eq(0, z[3] + z[2])
+        dae.eq(0, z[4] - z[5]**2 - z[2])
+        dae.eq(0, z[5] + exp(-z[4]) - 1)
+        dae.eq(0, p*z[6] - x)
+        f_ref = dae.create("f_ref", ["x", "z", "u", "p"], ["ode", "alg"])
+        dae.causalize({"rootfinder": solver})
+        # z1, z2, z4, z6 solved explicitly, z3 and z5 torn, z7 torn since p could be zero
+        self.assertEqual(dae.z(), [] if solver else ["z3", "z5", "z7"])
+        f = dae.create("f", ["x", "z", "u", "p"], ["ode", "alg"])
+        # Reference: Solve the full algebraic system
+        zz = MX.sym("z", 7)
+        G = Function("G", [zz, x, u, p], [f_ref(x, zz, u, p)[1]])
+        z0 = rootfinder("G", "newton", G)(0, 0.3, 0.1, 2)
+        ode_ref = f_ref(0.3, z0, 0.1, 2)[0]
+        if solver:
+            self.checkarray(f(0.3, DM.zeros(0, 1), 0.1, 2)[0], ode_ref, digits=10)
+        else:
+            r = f(0.3, vertcat(z0[2], z0[4], z0[6]), 0.1, 2)
+            self.checkarray(r[0], ode_ref, digits=10)
+            self.checkarray(r[1], DM.zeros(3), digits=10)
+
+  def test_reduce_index(self):
+    # Pendulum, index 3
+    dae = DaeBuilder("pendulum")
+    x = dae.add("x", {"start": 0.6})
+    y = dae.add("y", {"start": -0.8})
+    u = dae.add("u")
+    v = dae.add("v")
+    lam = dae.add("lam")
+    L = dae.add("L", "parameter", "tunable", {"start": 1})
+    dae.eq(dae.der(x), u)
+    dae.eq(dae.der(y), v)
+    dae.eq(dae.der(u), -lam*x)
+    dae.eq(dae.der(v), -lam*y - 9.81)
+    dae.eq(0, x**2 + y**2 - L**2)
+    dae.reduce_index()
+    # Constraint differentiated twice, velocity level equations once, y selected as dummy
+    self.assertEqual(dae.x(), ["x", "der_x"])
+    self.assertEqual(dae.nz(), 9)
+    f = dae.create("f", ["x", "z", "p"], ["ode", "alg"])
+    X = MX.sym("x", dae.nx())
+    Z = MX.sym("z", dae.nz())
+    P = MX.sym("p")
+    ode, alg = f(X, Z, P)
+    # Index 1: Consistent algebraic variables can be solved for
+    x0 = dae.start(dae.x())
+    z0 = rootfinder("G", "newton", Function("G", [Z, X, P], [alg]))(dae.start(dae.z()), x0, 1)
+    self.checkarray(z0[0], -0.8, digits=12)
+    if not has_integrator("idas"): return
+    F = integrator("F", "idas", {"x": X, "z": Z, "p": P, "ode": ode, "alg": alg}, 0, [1, 5])
+    r = F(x0=x0, z0=z0, p=1)
+    # No drift from the invariants
+    xf = r["xf"][0, :]
+    yf = r["zf"][0, :]
+    self.checkarray(xf**2 + yf**2, DM.ones(1, 2), digits=6)
+
+  def test_reduce_index_matrix_parameter(self):
+    # Pendulum with length and gravity in a matrix-valued parameter
+    dae = DaeBuilder("pendulum")
+    x = dae.add("x", {"start": 0.6})
+    y = dae.add("y", {"start": -0.8})
+    u = dae.add("u")
+    v = dae.add("v")
+    lam = dae.add("lam")
+    P = dae.add("P", "parameter", "tunable", {"dimension": [2, 2], "start": [1, 9.81, 0, 0]})
+    dae.eq(dae.der(x), u)
+    dae.eq(dae.der(y), v)
+    dae.eq(dae.der(u), -lam*x)
+    dae.eq(dae.der(v), -lam*y - P[1, 0])
+    dae.eq(0, x**2 + y**2 - P[0, 0]**2)
+    dae.reduce_index()
+    self.assertEqual(dae.x(), ["x", "der_x"])
+    self.assertEqual(dae.nz(), 9)
+
   def test_stats_available_bug(self):
         fmu_file = '../data/vdp.fmu'
         if not os.path.exists(fmu_file):
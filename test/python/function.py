@@ -630,6 +630,69 @@ class Functiontests(casadiTestCase):
     self.checkfunction_light(fun.map(4,"thread",2),fun.map(4),inputs=[hcat(X_[:4]),hcat(Y_[:4]),hcat(Z_[:4]),hcat(V_[:4])])
     self.checkfunction_light(fun.map(4,"thread",5),fun.map(4),inputs=[hcat(X_[:4]),hcat(Y_[:4]),hcat(Z_[:4]),hcat(V_[:4])])
 
+  def test_mx_max_num_threads(self):
+    x = SX.sym("x")
+    y = SX.sym("y",2)
+    fun = Function("f",[x,y],[sin(y*x),x*sumsqr(y)])
+
+    x = MX.sym("x")
+    y = MX.sym("y",2)
+    # Independent calls, a dependent chain and a reused work vector element
+    [a,b] = fun(x,y)
+    [c,d] = fun(2*x,y+1)
+    [e,f] = fun(b+d,a*c)
+    outs = [e,f+b,vertcat(a,c)]
+
+    ref = Function("ref",[x,y],outs)
+    X_ = DM(0.7)
+    Y_ = DM([0.3,1.9])
+    for n in [1,2,5]:
+      F = Function("F",[x,y],outs,{"max_num_threads":n})
+      self.checkfunction_light(F,ref,inputs=[X_,Y_])
+      self.check_serialize(F,inputs=[X_,Y_])
+
+    # Errors in concurrent calls are raised as in sequential evaluation
+    z = SX.sym("z")
+    q = SX.sym("q")
+    rf = rootfinder("rf","newton",{"x":z,"p":q,"g":z**2+q},{"error_on_fail":True})
+    a = rf(1,x)
+    b = rf(1,y[0])
+    for n in [1,2]:
+      F = Function("F",[x,y],[a+b],{"max_num_threads":n})
+      self.checkarray(F(-4,vertcat(-9,0)),5,digits=8)
+      with self.assertInException("rootfinder process failed"):
+        F(-4,vertcat(9,0))
+
+  def test_mx_compact_work(self):
+    x = MX.sym("x",3)
+    y = MX.sym("y",2)
+    # Elements of different sizes, in-place candidates and unused results
+    a = sin(x)
+    b = cos(y)
+    c = vertcat(a,b)*2
+    d = mtimes(DM.ones(2,5),c)
+    e = sumsqr(d)+dot(x,a)
+    outs = [e,d+b,c[1:4]]
+
+    ref = Function("ref",[x,y],outs)
+    F = Function("F",[x,y],outs,{"compact_work":True})
+    self.assertTrue(F.sz_w()<=ref.sz_w())
+    X_ = DM([0.7,1.1,-0.3])
+    Y_ = DM([0.3,1.9])
+    self.checkfunction(F,ref,inputs=[X_,Y_])
+    self.check_codegen(F,inputs=[X_,Y_])
+    self.check_serialize(F,inputs=[X_,Y_])
+
+    # Work vector size reported in the statistics
+    F(X_,Y_)
+    stats = F.stats()
+    self.assertTrue(stats["work_size"]<=stats["work_size_default"])
+    ref(X_,Y_)
+    self.assertEqual(ref.stats()["work_size"],ref.stats()["work_size_default"])
+
+    with self.assertInException("cannot be combined"):
+      Function("F",[x,y],outs,{"compact_work":True,"max_num_threads":2})
+
   @memory_heavy()
   def test_mapsum(self):
     x = SX.sym("x")
@@ -397,6 +397,27 @@ class ImplicitFunctiontests(casadiTestCase):
     jac_g_x = rf.get_function("jac_g_x")
     self.assertTrue(jac_g_x.name_in()==["x","p"])
     self.assertTrue(jac_g_x.name_out()==["jac_g_x","g"])
+
+  def test_jacobian_update(self):
+    x = MX.sym("x", 3)
+    p = MX.sym("p", 3)
+    g = vertcat(x[0]**3 + x[1] - p[0], x[1] + sin(x[2]) - p[1], exp(x[2]) + 0.1*x[0] - p[2])
+    p0 = DM([2, 1, 3])
+    ref = rootfinder("ref", "newton", {"x":x, "p":p, "g":g})
+    x_ref = ref(x0=1, p=p0)["x"]
+    for update in ["exact", "simplified", "broyden"]:
+      for line_search in [True, False]:
+        rf = rootfinder("rf", "newton", {"x":x, "p":p, "g":g},
+          {"jacobian_update": update, "line_search": line_search})
+        self.checkarray(rf(x0=1, p=p0)["x"], x_ref, digits=10)
+        stats = rf.stats()
+        self.assertTrue(stats["success"])
+        if update == "exact":
+          self.assertEqual(stats["n_jac_saved"], 0)
+        else:
+          self.assertTrue(stats["n_jac_saved"] > 0)
+          self.assertTrue(stats["n_jac_eval"] < stats["iter_count"])
+        self.check_serialize(rf, inputs=[1, p0])
     
 if __name__ == '__main__':
     unittest.main()
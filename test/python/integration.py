@@ -1504,6 +1504,52 @@ class Integrationtests(casadiTestCase):
     integrator(x0=1)
     self.assertTrue(integrator.get_function('jacF').is_a("SXFunction"))
     self.checkarray(integrator.get_function('jacF')(x=1)["jac_ode_x"],1) 
+
+  def test_dense_output(self):
+    x = MX.sym("x")
+    p = MX.sym("p")
+    dae = {'x':x, 'p':p, 'ode':-p*x, 'quad':x}
+    grid = list(numpy.linspace(0.01, 1, 200))
+    x_ref = numpy.exp(-numpy.array(grid))
+    q_ref = 1-x_ref
+    for plugin, opts in [("rk", {}), ("collocation", {"rootfinder":"fast_newton"})]:
+      opts = dict(opts, number_of_finite_elements=10, dense_output=True)
+      F = integrator("F", plugin, dae, 0, grid, opts)
+      res = F(x0=1, p=1)
+      self.checkarray(res["xf"], DM(x_ref).T, digits=4)
+      self.checkarray(res["qf"], DM(q_ref).T, digits=4)
+      # Forward sensitivities are interpolated in the same way
+      J = F.jacobian()(x0=1, p=1)
+      self.checkarray(J["jac_xf_x0"], DM(x_ref), digits=4)
+      self.checkarray(J["jac_xf_p"], DM(-numpy.array(grid)*x_ref), digits=4)
+      # Finite elements do not depend on the output grid
+      F2 = integrator("F", plugin, dae, 0, [0.5, 1], opts)
+      self.checkarray(F2(x0=1, p=1)["xf"][-1], res["xf"][-1], digits=12)
+
+  def test_rosenbrock(self):
+    # Stiff linear part plus a nonlinear, non-stiff part
+    t = MX.sym("t")
+    x = MX.sym("x", 2)
+    p = MX.sym("p")
+    dae = {'t':t, 'x':x, 'p':p, 'ode':vertcat(-1000*(x[0]-cos(t)) + x[1]**2, -p*x[1]), 'quad':x[0]}
+    x0 = DM([0, 1])
+    ref = integrator("ref", "collocation", dae, 0, 1, {"number_of_finite_elements": 400})
+    ref_out = ref(x0=x0, p=0.5)
+    ref_J = ref.jacobian()(x0=x0, p=0.5)
+    for scheme, nk, digits in [("ros2", 100, 3), ("euler", 2000, 2)]:
+      F = integrator("F", "rosenbrock", dae, 0, 1,
+        {"number_of_finite_elements": nk, "rosenbrock_scheme": scheme})
+      out = F(x0=x0, p=0.5)
+      self.checkarray(out["xf"], ref_out["xf"], digits=digits)
+      self.checkarray(out["qf"], ref_out["qf"], digits=digits)
+      J = F.jacobian()(x0=x0, p=0.5)
+      self.checkarray(J["jac_xf_x0"], ref_J["jac_xf_x0"], digits=digits)
+      self.checkarray(J["jac_xf_p"], ref_J["jac_xf_p"], digits=digits)
+    # Code generation of the simplified form
+    F = integrator("F", "rosenbrock", dae, 0, 1,
+      {"number_of_finite_elements": 100, "simplify": True})
+    self.check_codegen(F, inputs=[x0, 0, 0.5, 0, 0, 0, 0])
+    self.check_serialize(F, inputs=[x0, 0, 0.5, 0, 0, 0, 0])
        
 if __name__ == '__main__':
     unittest.main()
@@ -636,6 +636,200 @@ class NLPtests(casadiTestCase):
     s2 = solver.stats()
     self.assertEqual(s1["n_call_nlp_f"],s2["n_call_nlp_f"])
 
+  @requires_nlpsol("ipopt")
+  def test_ipopt_fuse_oracle(self):
+    x = MX.sym("x",2)
+    p = MX.sym("p")
+    nlp = {"x":x,"p":p,"f":(1-x[0])**2+p*(x[1]-x[0]**2)**2,"g":x[0]**2+x[1]**2}
+    args = {"x0":[0.5,0.5],"p":100,"lbg":0,"ubg":1}
+
+    ref = nlpsol("ref","ipopt",nlp)
+    sol_ref = ref(**args)
+    for fuse in ["zeroth","first"]:
+      solver = nlpsol("solver","ipopt",nlp,{"fuse_oracle":fuse})
+      sol = solver(**args)
+      self.checkarray(sol["x"],sol_ref["x"],digits=10)
+      self.checkarray(sol["lam_g"],sol_ref["lam_g"],digits=10)
+      stats = solver.stats()
+      self.assertEqual(stats["iter_count"],ref.stats()["iter_count"])
+      self.assertTrue(stats["n_call_nlp_fg"]<ref.stats()["n_call_nlp_f"]+ref.stats()["n_call_nlp_g"])
+      # Timings still recorded per requested function
+      for fcn in ["nlp_f","nlp_g","nlp_grad_f","nlp_jac_g"]:
+        self.assertEqual(stats["n_call_"+fcn],ref.stats()["n_call_"+fcn])
+      if fuse=="first":
+        # Derivatives only evaluated at accepted iterates
+        self.assertTrue(stats["n_call_nlp_fg1"]<=ref.stats()["n_call_nlp_jac_g"])
+
+      self.check_serialize(solver,args)
+
+  @requires_nlpsol("sqpmethod")
+  @requires_conic("qrqp")
+  def test_sqpmethod_max_num_threads(self):
+    x = MX.sym("x",2)
+    p = MX.sym("p")
+    nlp = {"x":x,"p":p,"f":(1-x[0])**2+p*(x[1]-x[0]**2)**2,"g":x[0]**2+x[1]**2}
+    args = {"x0":[0.5,0.5],"p":100,"lbg":0,"ubg":1}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False},"print_iteration":False}
+
+    ref = nlpsol("ref","sqpmethod",nlp,opts)
+    sol_ref = ref(**args)
+    opts["max_num_threads"] = 2
+    solver = nlpsol("solver","sqpmethod",nlp,opts)
+    sol = solver(**args)
+    self.checkarray(sol["x"],sol_ref["x"],digits=12)
+    self.checkarray(sol["lam_g"],sol_ref["lam_g"],digits=12)
+    self.assertEqual(solver.stats()["iter_count"],ref.stats()["iter_count"])
+
+    # Only offered where it is used
+    with self.assertInException("Unknown option: max_num_threads"):
+      rootfinder("rf","newton",{"x":x,"p":p,"g":x-p},{"max_num_threads":2})
+
+  def test_sqpmethod_qp_iter(self):
+    x = MX.sym("x",2)
+    nlp = {"x":x,"f":(1-x[0])**2+100*(x[1]-x[0]**2)**2,"g":x[0]**2+x[1]**2}
+    solver = nlpsol("solver","sqpmethod",nlp,{"qpsol":"qrqp","qpsol_options":{"print_iter":False},"print_iteration":False})
+    solver(x0=[0.5,0.5],lbg=0,ubg=1)
+    stats = solver.stats()
+    self.assertEqual(len(stats["qp_iter"]),stats["iter_count"])
+    self.assertTrue(all(i>=0 for i in stats["qp_iter"]))
+
+  def test_sqpmethod_block_hessian(self):
+    # Separable objective, stages coupled through constraints only
+    xs = [SX.sym("x%d" % k,2) for k in range(20)]
+    f = sum((xk[0]-1)**2+xk[1]**4+0.1*exp(xk[0]*xk[1]) for xk in xs)
+    g = vertcat(*[xs[k][0]-sin(xs[k-1][0])-0.1*xs[k-1][1] for k in range(1,20)])
+    nlp = {"x":vertcat(*xs),"f":f,"g":g}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False,"print_info":False},
+            "hessian_approximation":"limited-memory","print_iteration":False,"print_header":False,
+            "max_iter":200,"tol_pr":1e-9,"tol_du":1e-9}
+    ref = nlpsol("ref","sqpmethod",nlp,opts)
+    sol_ref = ref(x0=0.3,lbg=0,ubg=0)
+    opts["block_hessian"] = True
+    solver = nlpsol("solver","sqpmethod",nlp,opts)
+    sol = solver(x0=0.3,lbg=0,ubg=0)
+    self.assertTrue(solver.stats()["success"])
+    self.checkarray(sol["x"],sol_ref["x"],digits=7)
+    self.check_serialize(solver,{"x0":0.3,"lbg":0,"ubg":0})
+    self.check_codegen(solver,inputs={"x0":0.3,"lbg":0,"ubg":0},std="c99",digits=8)
+
+  def test_sqpmethod_newton_cg(self):
+    x = SX.sym("x",30)
+    p = SX.sym("p")
+    f = sum(100*(x[i+1]-x[i]**2)**2+(p-x[i])**2 for i in range(29))
+    nlp = {"x":x,"p":p,"f":f}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False,"print_info":False},
+            "print_iteration":False,"print_header":False,"print_status":False,"max_iter":200}
+    args = dict(x0=0,p=1,lbx=-2,ubx=0.9)
+    ref = nlpsol("ref","sqpmethod",nlp,opts)
+    sol_ref = ref(**args)
+    opts["newton_cg"] = True
+    solver = nlpsol("solver","sqpmethod",nlp,opts)
+    sol = solver(**args)
+    self.assertTrue(solver.stats()["success"])
+    self.assertEqual(len(solver.stats()["cg_iter"]),solver.stats()["iter_count"])
+    self.checkarray(sol["x"],sol_ref["x"],digits=8)
+    self.checkarray(sol["lam_x"],sol_ref["lam_x"],digits=5)
+    self.check_serialize(solver,args)
+
+    # Hessian-vector product against the full Hessian
+    hv = solver.get_function("nlp_hess_vec")
+    H = Function("H",[x,p],[hessian(f,x)[0]])
+    x0 = DM.rand(30)
+    v = DM.rand(30)
+    self.checkarray(hv(x0,1,1,DM(),v),mtimes(H(x0,1),v),digits=10)
+
+    with self.assertInException("general constraints"):
+      nlpsol("solver","sqpmethod",{"x":x,"p":p,"f":f,"g":x[0]},opts)
+
+  def test_sqpmethod_rti(self):
+    x = MX.sym("x",2)
+    p = MX.sym("p")
+    nlp = {"x":x,"p":p,"f":(1-x[0])**2+(x[1]-x[0]**2)**2,"g":x[0]+x[1]-p}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_iteration":False,"print_header":False,"print_status":False}
+    ref = nlpsol("ref","sqpmethod",nlp,opts)
+    sol_ref = ref(x0=0,p=1,lbg=0,ubg=0)
+
+    opts["rti_phase"] = "preparation"
+    solver = nlpsol("solver","sqpmethod",nlp,opts)
+    with self.assertInException("preparation"):
+      solver.change_option("rti_phase","feedback")
+      solver(p=1,lbg=0,ubg=0)
+    sol = {"x":DM.zeros(2),"lam_g":0}
+    for i in range(20):
+      # Prepare with a predicted parameter, feedback with the actual one
+      solver.change_option("rti_phase","preparation")
+      solver(x0=sol["x"],lam_g0=sol["lam_g"],p=0.5,lbg=0,ubg=0)
+      solver.change_option("rti_phase","feedback")
+      sol = solver(p=1,lbg=0,ubg=0)
+      self.assertEqual(solver.stats()["return_status"],"RTI_Feedback_Done")
+    self.checkarray(sol["x"],sol_ref["x"],digits=6)
+    self.assertEqual(solver.stats()["rti_count"],20)
+
+  def test_nlpsol_sens(self):
+    x = SX.sym("x",3)
+    p = SX.sym("p",2)
+    f = (x[0]-p[0])**2+2*(x[1]-1)**2+(x[2]+p[1])**2+x[0]*x[1]
+    g = vertcat(x[0]+x[1]+x[2]*p[0],x[1]**2+x[2])
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_iteration":False,"print_header":False,"print_status":False}
+    solver = nlpsol("solver","sqpmethod",{"x":x,"p":p,"f":f,"g":g},opts)
+    args = dict(p=[0.7,0.3],lbx=[-10,-10,-0.2],ubx=10,lbg=[1,-10],ubg=[1,10])
+    with self.assertInException("No solution available"):
+      nlpsol_sens_forward(solver,{"p":DM.eye(2)})
+    solver(**args)
+
+    J = solver.factory("J",["p","lbx","ubx","lbg","ubg"],["jac:x:p","jac:f:p","jac:f:ubg"])
+    ref = J(**args)
+
+    # Batch of directions, one column each
+    fwd = nlpsol_sens_forward(solver,{"p":DM.eye(2)})
+    self.checkarray(fwd["x"],ref["jac_x_p"],digits=8)
+    self.checkarray(fwd["f"],ref["jac_f_p"],digits=8)
+    adj = nlpsol_sens_reverse(solver,{"f":1})
+    self.checkarray(adj["p"],ref["jac_f_p"].T,digits=8)
+    self.checkarray(adj["ubg"],ref["jac_f_ubg"].T,digits=8)
+    with self.assertInException("directions"):
+      nlpsol_sens_forward(solver,{"p":DM.eye(2),"lbx":DM.zeros(3,1)})
+
+    # Cached KKT structure and derivative functions after a new solve
+    args["p"] = [0.5,-0.2]
+    solver(**args)
+    ref = J(**args)
+    for i in range(2):
+      fwd = nlpsol_sens_forward(solver,{"p":DM.eye(2)})
+      self.checkarray(fwd["x"],ref["jac_x_p"],digits=8)
+      adj = nlpsol_sens_reverse(solver,{"f":1})
+      self.checkarray(adj["p"],ref["jac_f_p"].T,digits=8)
+
+  def test_nlpsol_multistart(self):
+    x = SX.sym("x",2)
+    nlp = {"x":x,"f":(x[0]**2+x[1]**2)/20-cos(2*x[0])-cos(2*x[1]),"g":x[0]+x[1]}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False,"print_info":False,
+            "error_on_fail":False},"print_iteration":False,"print_header":False,"print_status":False}
+    solver = nlpsol("solver","sqpmethod",nlp,opts)
+    args = dict(lbx=-8,ubx=8,lbg=1,ubg=10)
+    x0 = DM([[-7,-3,0.5,2,6,7.5],[6,-5,0.7,-2,1,-7]])
+
+    # Serial reference
+    f_ref = []
+    for k in range(x0.shape[1]):
+      sol = solver(x0=x0[:,k],**args)
+      f_ref.append(float(sol["f"]) if solver.stats()["success"] else inf)
+
+    for abort in [False,True]:
+      ms = nlpsol_multistart("ms",solver,x0.shape[1],{"max_num_threads":3,"abort_dominated":abort})
+      sol = ms(x0=x0,**args)
+      stats = ms.stats()
+      self.assertTrue(stats["success"])
+      self.checkarray(sol["f"],min(f_ref),digits=8)
+      self.assertEqual(len(stats["iter_count"]),x0.shape[1])
+      if not abort:
+        self.assertEqual(stats["n_aborted"],0)
+        for k in range(x0.shape[1]):
+          if stats["success_all"][k]: self.checkarray(stats["f"][k],f_ref[k],digits=8)
+    self.check_serialize(ms,dict(x0=x0,**args))
+
   def test_warmstart(self):
 
     x=SX.sym("x")
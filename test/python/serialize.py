@@ -131,7 +131,118 @@ class SerializeTests(casadiTestCase):
             f_ref = pickle.loads(serialized)
             
         self.checkarray(evalf(jacobian(f_ref.b,f_ref.a)),1)
-           
+
+  def test_bulk(self):
+    x = SX.sym("x",50)
+    f = sum1(100*(x[1:]-x[:-1]**2)**2+(1-x[:-1])**2)
+    F = Function("F",[x],[f,gradient(f,x),hessian(f,x)[0]])
+    x0 = DM.rand(50)
+    for debug in [False,True]:
+      F.save("bulk.casadi",{"bulk":True,"debug":debug})
+      G = Function.load("bulk.casadi")
+      for r,r_ref in zip(G(x0),F(x0)):
+        self.checkarray(r,r_ref,digits=15)
+
+    fs = FileSerializer("bulk.casadi",{"bulk":True})
+    fs.pack(DM.rand(3,4))
+    fs.pack([1,2,3])
+    fs.pack([0.5,1.5])
+    del fs
+    fd = FileDeserializer("bulk.casadi")
+    self.assertEqual(fd.unpack().shape,(3,4))
+    self.assertEqual(fd.unpack(),[1,2,3])
+    self.assertEqual(fd.unpack(),[0.5,1.5])
+
+  def test_lazy(self):
+    x = SX.sym("x",2)
+    f1 = Function("f1",[x],[sin(x)*x[0]])
+    f2 = Function("f2",[x],[cos(x)+x])
+    c = MX.sym("c")
+    X = MX.sym("x",2)
+    sw = Function.conditional("sw",[f1],f2)
+    F = Function("F",[c,X],[sw(c,X)+f1(X)])
+    F.save("lazy.casadi",{"lazy":True})
+    G = Function.load("lazy.casadi")
+    self.assertEqual(G.name(),"F")
+    for h in G.find_functions(1):
+      self.assertEqual(h.class_name(),"LazyFunction")
+    for c0 in [0,1]:
+      self.checkarray(G(c0,vertcat(1,2)),F(c0,vertcat(1,2)),digits=15)
+    J = G.jacobian()
+    J_ref = F.jacobian()
+    for r,r_ref in zip(J(0,vertcat(1,2),0),J_ref(0,vertcat(1,2),0)):
+      self.checkarray(r,r_ref,digits=12)
+
+    # Saving again writes the deserialized functions
+    G.save("lazy2.casadi")
+    H = Function.load("lazy2.casadi")
+    self.checkarray(H(1,vertcat(1,2)),F(1,vertcat(1,2)),digits=15)
+
+    # All entries deserialized up front, concurrently
+    for max_num_threads in [1,4]:
+      G = Function.load("lazy.casadi",{"preload":True,"max_num_threads":max_num_threads})
+      for c0 in [0,1]:
+        self.checkarray(G(c0,vertcat(1,2)),F(c0,vertcat(1,2)),digits=15)
+    with self.assertInException("only apply to archives"):
+      Function.load("lazy2.casadi",{"preload":True})
+
+  def test_lazy_nlpsol(self):
+    x = SX.sym("x",2)
+    p = SX.sym("p")
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False,"print_info":False},
+            "print_iteration":False,"print_header":False,"print_status":False}
+    solver = nlpsol("solver","sqpmethod",{"x":x,"p":p,"f":(x[0]-p)**2+x[1]**2,"g":x[0]+x[1]},opts)
+    P = MX.sym("p")
+    F = Function("F",[P],[solver(p=P,lbg=1,ubg=1)["x"]])
+    F.save("lazy_nlp.casadi",{"lazy":True})
+    G = Function.load("lazy_nlp.casadi")
+    [h] = G.find_functions(1)
+    self.assertEqual(h.class_name(),"LazyFunction")
+    # The proxy is not an Nlpsol instance
+    self.assertFalse(h.is_a("Nlpsol",True))
+    sol = h(p=0.3,lbg=1,ubg=1)
+    with self.assertInException("Expected an NLP solver instance"):
+      nlpsol_sens_forward(h,{"p":1})
+    # Multistart uses the deserialized solver
+    ms = nlpsol_multistart("ms",h,2)
+    self.checkarray(ms(p=0.3,lbg=1,ubg=1,x0=DM([[0,1],[0,-1]]))["x"],sol["x"],digits=8)
+
+  def test_fd(self):
+    x = SX.sym("x",50)
+    f = sum1(100*(x[1:]-x[:-1]**2)**2+(1-x[:-1])**2)
+    F = Function("F",[x],[f,gradient(f,x)])
+    x0 = DM.rand(50)
+    for opts in [{},{"bulk":True,"buffer_size":64}]:
+      fd = os.open("fd.casadi",os.O_WRONLY|os.O_CREAT|os.O_TRUNC)
+      fs = FdSerializer(fd,opts)
+      fs.pack(F)
+      fs.pack([1,2,3])
+      del fs
+      os.close(fd)
+      fd = os.open("fd.casadi",os.O_RDONLY)
+      fs = FdDeserializer(fd,{"buffer_size":64} if opts else {})
+      G = fs.unpack()
+      self.assertEqual(fs.unpack(),[1,2,3])
+      del fs
+      os.close(fd)
+      for r,r_ref in zip(G(x0),F(x0)):
+        self.checkarray(r,r_ref,digits=15)
+
+    # Pipe producer and consumer, write errors once the reader is gone
+    if os.name!="nt":
+      r,w = os.pipe()
+      fs = FdSerializer(w)
+      fs.pack([1,2,3])
+      fs.flush()
+      self.assertEqual(FdDeserializer(r).unpack(),[1,2,3])
+      os.close(r)
+      with self.assertInException("Failed to write"):
+        fs.pack(F)
+        fs.flush()
+      with self.assertInException("Failed to write"):
+        fs.pack([1,2,3])
+      os.close(w)
+
   
   
 if __name__ == '__main__':